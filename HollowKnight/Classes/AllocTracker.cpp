@@ -0,0 +1,236 @@
+#include "AllocTracker.h"
+#include "Log.h"
+#include "cocos2d.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+// ============================================================
+// ͳ (ȫǶ/ƽͣ¼вٷ)
+// ============================================================
+namespace {
+    const int MAX_ZONE_DEPTH = 32;
+    const int MAX_ZONES = 64;
+    const char* NO_ZONE = "(no zone)";
+
+    std::atomic<size_t> s_totalCount(0);
+    std::atomic<size_t> s_totalBytes(0);
+    std::atomic<size_t> s_violations(0);
+    const char* s_strictEnv = std::getenv("HK_ALLOC_STRICT");
+    std::atomic<bool> s_strict(s_strictEnv != nullptr);
+    std::atomic<bool> s_reportOnly(s_strictEnv != nullptr && std::strcmp(s_strictEnv, "report") == 0);
+
+    thread_local const char* t_zoneStack[MAX_ZONE_DEPTH];
+    thread_local int t_zoneDepth = 0;
+    thread_local int t_noAllocDepth = 0;
+    thread_local int t_allowDepth = 0;
+    thread_local size_t t_violations = 0;
+    thread_local size_t t_violationBytes = 0;
+    thread_local bool t_isMainThread = false; // һε beginFrame ߳
+
+    // ÿ֡ͳֻ߳϶дü
+    struct FrameData
+    {
+        AllocTracker::Counters total;
+        AllocTracker::ZoneStat zones[MAX_ZONES];
+        int zoneCount;
+    };
+    FrameData s_currentFrame = {};
+    FrameData s_lastFrame = {};
+}
+
+#ifdef HK_TRACK_ALLOCS
+// ============================================================
+// ȫ operator new / delete
+// ============================================================
+void* operator new(std::size_t size)
+{
+    AllocTracker::onAllocation(size);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+void* operator new[](std::size_t size)
+{
+    AllocTracker::onAllocation(size);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+    AllocTracker::onAllocation(size);
+    return std::malloc(size ? size : 1);
+}
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept
+{
+    AllocTracker::onAllocation(size);
+    return std::malloc(size ? size : 1);
+}
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { std::free(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { std::free(p); }
+#endif
+
+bool AllocTracker::isEnabled()
+{
+#ifdef HK_TRACK_ALLOCS
+    return true;
+#else
+    return false;
+#endif
+}
+
+// ============================================================
+// ¼
+// ============================================================
+void AllocTracker::onAllocation(size_t size)
+{
+    s_totalCount.fetch_add(1, std::memory_order_relaxed);
+    s_totalBytes.fetch_add(size, std::memory_order_relaxed);
+
+    if (t_noAllocDepth > 0 && t_allowDepth == 0) onViolation(size);
+    if (!t_isMainThread) return;
+
+    FrameData& frame = s_currentFrame;
+    frame.total.count++;
+    frame.total.bytes += size;
+
+    const char* zone = NO_ZONE;
+    if (t_zoneDepth > 0) zone = t_zoneStack[std::min(t_zoneDepth, MAX_ZONE_DEPTH) - 1];
+
+    for (int i = 0; i < frame.zoneCount; i++) {
+        if (frame.zones[i].name == zone) {
+            frame.zones[i].count++;
+            frame.zones[i].bytes += size;
+            return;
+        }
+    }
+    if (frame.zoneCount < MAX_ZONES) {
+        frame.zones[frame.zoneCount++] = { zone, 1, size };
+    }
+}
+
+void AllocTracker::onViolation(size_t size)
+{
+    // ¶ϵ㣬ջΥķ
+    t_violations++;
+    t_violationBytes += size;
+    s_violations.fetch_add(1, std::memory_order_relaxed);
+}
+
+void AllocTracker::pushZone(const char* name)
+{
+    if (t_zoneDepth < MAX_ZONE_DEPTH) t_zoneStack[t_zoneDepth] = name;
+    t_zoneDepth++;
+}
+
+void AllocTracker::popZone()
+{
+    if (t_zoneDepth > 0) t_zoneDepth--;
+}
+
+// ============================================================
+// ÿ֡ͳ
+// ============================================================
+void AllocTracker::beginFrame()
+{
+    t_isMainThread = true;
+    s_lastFrame = s_currentFrame;
+    s_currentFrame.total = { 0, 0 };
+    s_currentFrame.zoneCount = 0;
+}
+
+AllocTracker::Counters AllocTracker::getTotals()
+{
+    return { s_totalCount.load(std::memory_order_relaxed), s_totalBytes.load(std::memory_order_relaxed) };
+}
+
+AllocTracker::Counters AllocTracker::getLastFrame()
+{
+    return s_lastFrame.total;
+}
+
+int AllocTracker::getLastFrameZones(ZoneStat* out, int maxCount)
+{
+    ZoneStat sorted[MAX_ZONES];
+    int count = s_lastFrame.zoneCount;
+    std::copy(s_lastFrame.zones, s_lastFrame.zones + count, sorted);
+    std::sort(sorted, sorted + count, [](const ZoneStat& a, const ZoneStat& b) { return a.count > b.count; });
+
+    int written = std::min(count, maxCount);
+    std::copy(sorted, sorted + written, out);
+    return written;
+}
+
+// ============================================================
+// ϸģʽ / ޷
+// ============================================================
+void AllocTracker::setStrict(bool strict)
+{
+    s_strict.store(strict);
+}
+
+bool AllocTracker::isStrict()
+{
+    return s_strict.load(std::memory_order_relaxed);
+}
+
+void AllocTracker::setReportOnly(bool reportOnly)
+{
+    s_reportOnly.store(reportOnly);
+}
+
+bool AllocTracker::isReportOnly()
+{
+    return s_reportOnly.load(std::memory_order_relaxed);
+}
+
+size_t AllocTracker::getViolationCount()
+{
+    return s_violations.load(std::memory_order_relaxed);
+}
+
+AllocTracker::NoAllocScope::NoAllocScope(const char* name)
+    : _name(name)
+    , _active(isEnabled() && isStrict())
+    , _violationsBefore(0)
+    , _bytesBefore(0)
+{
+    if (!_active) return;
+    _violationsBefore = t_violations;
+    _bytesBefore = t_violationBytes;
+    t_noAllocDepth++;
+}
+
+AllocTracker::NoAllocScope::~NoAllocScope()
+{
+    if (!_active) return;
+    t_noAllocDepth--; // ˳־
+
+    size_t violations = t_violations - _violationsBefore;
+    if (violations == 0) return;
+
+    unsigned bytes = (unsigned)(t_violationBytes - _bytesBefore);
+    if (isReportOnly()) {
+        HK_LOG_WARN(GENERAL, "AllocTracker: %u allocation(s), %u bytes inside no-alloc scope '%s'", (unsigned)violations, bytes, _name);
+        return;
+    }
+    HK_LOG_ERROR(GENERAL, "AllocTracker: %u allocation(s), %u bytes inside no-alloc scope '%s'", (unsigned)violations, bytes, _name);
+    CCASSERT(false, "heap allocation inside a no-alloc scope (break on AllocTracker::onViolation)");
+}
+
+AllocTracker::AllowScope::AllowScope(const char* name)
+{
+    pushZone(name);
+    t_allowDepth++;
+}
+
+AllocTracker::AllowScope::~AllowScope()
+{
+    t_allowDepth--;
+    popZone();
+}
@@ -0,0 +1,105 @@
+#ifndef __ALLOC_TRACKER_H__
+#define __ALLOC_TRACKER_H__
+
+#include <cstddef>
+
+// ==========================================
+// ѷͳ ( HK_TRACK_ALLOCS ʱ滻ȫ operator new/delete)
+// - ͳܴ/ֽԼÿ֡Ĵ/ֽ
+// - ǰڵļʱ (HK_PROFILE_ZONE / HK_PROFILE_NEXT Զѹջ)
+// - ޷ϸģʽ£HK_NO_ALLOC_SCOPE ڵκη䶼ΪΥ棬
+//   뿪ʱ (ʱ AllocTracker::onViolation ¶ϵ㼴ͣڷ䴦)
+// - ޷ȷʵҪĵط (жЧ)  HK_ALLOW_ALLOC_SCOPE 
+//   ͬʱΪĹܿÿһ˶
+// - ֻģʽ (HK_ALLOC_STRICT=report)Υֻͳơд־ԣ廹Щ
+// û HK_TRACK_ALLOCS ʱнӿڷ 0չΪ
+// ע⣺operator new Ĵ룬ʵֱܷڴ
+// ==========================================
+class AllocTracker
+{
+public:
+    struct Counters
+    {
+        size_t count;
+        size_t bytes;
+    };
+
+    struct ZoneStat
+    {
+        const char* name;   // ʱ (ַ)֮߳/ķΪ "(no zone)"
+        size_t count;
+        size_t bytes;
+    };
+
+    // ʱǷͳ
+    static bool isEnabled();
+
+    //  (߳)
+    static Counters getTotals();
+
+    // ߳ÿ֡ͷãѱ֡ۼƹ"һ֡"
+    static void beginFrame();
+    static Counters getLastFrame();
+    // һ֡ʱķ䣬ӶൽУд
+    static int getLastFrameZones(ZoneStat* out, int maxCount);
+
+    // ʱջ ( Profiler ĺ)
+    static void pushZone(const char* name);
+    static void popZone();
+
+    // ϸģʽ޷Ч (Ҳû HK_ALLOC_STRICT )
+    static void setStrict(bool strict);
+    static bool isStrict();
+    // ֻ棺Υд־ (HK_ALLOC_STRICT=report ʱĬϿ)
+    static void setReportOnly(bool reportOnly);
+    static bool isReportOnly();
+    // Υ
+    static size_t getViolationCount();
+
+    // ȫ operator new 
+    static void onAllocation(size_t size);
+
+    // ޷
+    class NoAllocScope
+    {
+    public:
+        explicit NoAllocScope(const char* name);
+        ~NoAllocScope();
+
+    private:
+        const char* _name;
+        bool _active;
+        size_t _violationsBefore;
+        size_t _bytesBefore;
+    };
+
+    // ڵķ䲻Υ棬 name 
+    class AllowScope
+    {
+    public:
+        explicit AllowScope(const char* name);
+        ~AllowScope();
+    };
+
+private:
+    // ר¶ϵ
+    static void onViolation(size_t size);
+};
+
+#ifdef HK_TRACK_ALLOCS
+#define HK_ALLOC_CONCAT_INNER(a, b) a##b
+#define HK_ALLOC_CONCAT(a, b) HK_ALLOC_CONCAT_INNER(a, b)
+#define HK_NO_ALLOC_SCOPE(name) AllocTracker::NoAllocScope HK_ALLOC_CONCAT(__hkNoAlloc, __LINE__)(name)
+#define HK_ALLOW_ALLOC_SCOPE(name) AllocTracker::AllowScope HK_ALLOC_CONCAT(__hkAllowAlloc, __LINE__)(name)
+#define HK_ALLOC_ZONE_PUSH(name) AllocTracker::pushZone(name)
+#define HK_ALLOC_ZONE_POP() AllocTracker::popZone()
+#define HK_ALLOC_FRAME() AllocTracker::beginFrame()
+#else
+#define HK_NO_ALLOC_SCOPE(name) do {} while (0)
+#define HK_ALLOW_ALLOC_SCOPE(name) do {} while (0)
+#define HK_ALLOC_ZONE_PUSH(name) do {} while (0)
+#define HK_ALLOC_ZONE_POP() do {} while (0)
+#define HK_ALLOC_FRAME() do {} while (0)
+#endif
+
+#endif // __ALLOC_TRACKER_H__
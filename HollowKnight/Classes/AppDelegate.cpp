@@ -23,7 +23,14 @@
  ****************************************************************************/
 #include "AppDelegate.h"
 #include "HelloWorldScene.h"
-#include "KeyBindingScene.h"  // λó
+#include "PreloadScene.h"
+#include "config.h"
+#include "ScenarioRunner.h"
+#include "Log.h"
+#include "JobSystem.h"
+#include "PackFileUtils.h"
+#include "MusicPlayer.h"
+#include <cstdlib>
 
  //  Windows ƽ̨ͷļͿ
 #if (CC_TARGET_PLATFORM == CC_PLATFORM_WIN32)
@@ -54,7 +61,6 @@ static cocos2d::Size windowSize = cocos2d::Size(2000, 1500);  // 
 
 static cocos2d::Size smallResolutionSize = cocos2d::Size(480, 320);
 static cocos2d::Size mediumResolutionSize = cocos2d::Size(1024, 768);
-static cocos2d::Size largeResolutionSize = cocos2d::Size(2048, 1536);
 
 AppDelegate::AppDelegate()
 {
@@ -62,6 +68,9 @@ AppDelegate::AppDelegate()
 
 AppDelegate::~AppDelegate()
 {
+    JobSystem::getInstance()->stop();
+    MusicPlayer::getInstance()->shutdown();
+    Log::shutdown();
 #if USE_AUDIO_ENGINE
     AudioEngine::end();
 #elif USE_SIMPLE_AUDIO_ENGINE
@@ -87,6 +96,15 @@ static int register_all_packages()
 }
 
 bool AppDelegate::applicationDidFinishLaunching() {
+    // ־̨֮߳ HK_LOG Ż
+    Log::init(FileUtils::getInstance()->getWritablePath() + Config::Log::FILE_NAME);
+
+    // ԴҪڵһζԴ֮ǰװ (滻 FileUtils ʵ)
+    PackFileUtils::install(Config::Pack::FILE_NAME);
+
+    // ϵͳĹ߳ (ʱҪ߳׼ͨҪڳ֮ǰ)
+    JobSystem::getInstance()->start();
+
     // initialize director
     auto director = Director::getInstance();
     auto glview = director->getOpenGLView();
@@ -123,31 +141,67 @@ bool AppDelegate::applicationDidFinishLaunching() {
     director->setDisplayStats(true);
 
     // set FPS. the default value is 1.0/60 if you don't call this
-    director->setAnimationInterval(1.0f / 60);
+    // ˵/ͣʱ FrameRateManager  idle ֡
+    director->setAnimationInterval(1.0f / Config::Power::ACTIVE_FPS);
 
     // Set the design resolution
     glview->setDesignResolutionSize(designResolutionSize.width, designResolutionSize.height, ResolutionPolicy::NO_BORDER);
+    // ڸ߶ѡԴλ󴰿ԭͼ/СС HD/SD  (Դͼʱ䰴½)
+    // λĿ¼·ǰƵ/ûиļ䵽Ŀ¼
+    // content scale factor ڵλţԴͳߴ () ܵλӰ
     auto frameSize = glview->getFrameSize();
-    // if the frame's height is larger than the height of medium size.
-    if (frameSize.height > mediumResolutionSize.height)
+    auto fileUtils = FileUtils::getInstance();
+    std::string tierDir;
+    float tierScale = 1.0f;
+    if (frameSize.height <= smallResolutionSize.height)
     {
-        director->setContentScaleFactor(MIN(largeResolutionSize.height / designResolutionSize.height, largeResolutionSize.width / designResolutionSize.width));
+        tierDir = Config::Resolution::SD_DIR;
+        tierScale = Config::Resolution::SD_SCALE;
     }
-    // if the frame's height is larger than the height of small size.
-    else if (frameSize.height > smallResolutionSize.height)
+    else if (frameSize.height <= mediumResolutionSize.height)
     {
-        director->setContentScaleFactor(MIN(mediumResolutionSize.height / designResolutionSize.height, mediumResolutionSize.width / designResolutionSize.width));
+        tierDir = Config::Resolution::HD_DIR;
+        tierScale = Config::Resolution::HD_SCALE;
     }
-    // if the frame's height is smaller than the height of medium size.
-    else
+    if (!tierDir.empty() && !fileUtils->isFileExist(tierDir + "/" + Config::Resolution::MARKER))
     {
-        director->setContentScaleFactor(MIN(smallResolutionSize.height / designResolutionSize.height, smallResolutionSize.width / designResolutionSize.width));
+        HK_LOG_WARN(GENERAL, "Resolution: %s not generated, using full-size assets", tierDir);
+        tierDir.clear();
+        tierScale = 1.0f;
     }
+    if (!tierDir.empty())
+    {
+        auto searchPaths = fileUtils->getSearchPaths();
+        searchPaths.insert(searchPaths.begin(), tierDir);
+        fileUtils->setSearchPaths(searchPaths);
+    }
+    director->setContentScaleFactor(tierScale);
+    HK_LOG_INFO(GENERAL, "Resolution: frame %.0fx%.0f, asset scale %.2f", frameSize.width, frameSize.height, tierScale);
 
     register_all_packages();
 
-    // ޸ġӼλóʼ
-    auto scene = KeyBindingScene::createScene();
+    //  HK_SCENARIO ʱֻܳع ()
+    // ддĿ¼Ԥʱ false ýԷ 0 ˳
+    if (std::getenv(Config::Scenario::ENV_VAR))
+    {
+        ScenarioRunner runner;
+        bool ok = runner.runAll(FileUtils::getInstance()->getWritablePath() + Config::Scenario::REPORT_FILE);
+        director->end();
+        return ok;
+    }
+
+    //  HK_REPLAY=<¼·> ʱֻطһ (ҷĿ/)
+    // ֡ʱд棬max_frame ָһ֡
+    if (const char* replayPath = std::getenv(Config::Replay::ENV_VAR))
+    {
+        ScenarioRunner runner;
+        bool ok = runner.runReplayFile(replayPath, FileUtils::getInstance()->getWritablePath() + Config::Replay::REPORT_FILE);
+        director->end();
+        return ok;
+    }
+
+    // Ƚس̨Դ֡ϴɺٽλó
+    auto scene = PreloadScene::createScene();
 
     // run
     director->runWithScene(scene);
@@ -158,6 +212,7 @@ bool AppDelegate::applicationDidFinishLaunching() {
 // This function will be called when the app is inactive. Note, when receiving a phone call it is invoked.
 void AppDelegate::applicationDidEnterBackground() {
     Director::getInstance()->stopAnimation();
+    MusicPlayer::getInstance()->pause();
 
 #if USE_AUDIO_ENGINE
     AudioEngine::pauseAll();
@@ -170,6 +225,7 @@ void AppDelegate::applicationDidEnterBackground() {
 // this function will be called when the app is active again
 void AppDelegate::applicationWillEnterForeground() {
     Director::getInstance()->startAnimation();
+    MusicPlayer::getInstance()->resume();
 
 #if USE_AUDIO_ENGINE
     AudioEngine::resumeAll();
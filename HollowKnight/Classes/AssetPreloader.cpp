@@ -0,0 +1,229 @@
+#include "AssetPreloader.h"
+#include "TextureResidency.h"
+#include "PackFileUtils.h"
+#include "MusicPlayer.h"
+#include "AudioManager.h"
+#include "Profiler.h"
+#include "Log.h"
+#include <chrono>
+#include <sstream>
+#include <thread>
+
+USING_NS_CC;
+
+namespace {
+    double nowMs()
+    {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+}
+
+AssetPreloader* AssetPreloader::getInstance()
+{
+    static AssetPreloader s_instance;
+    return &s_instance;
+}
+
+AssetPreloader::~AssetPreloader()
+{
+    // ˳ʱ JobSystem Ѿͣˣֻͷȷ
+    for (auto& entry : _entries) {
+        if (entry->decoded.load(std::memory_order_acquire)) CC_SAFE_RELEASE(entry->image);
+    }
+}
+
+// ============================================================
+// 嵥
+// ============================================================
+bool AssetPreloader::begin(const std::string& manifestPath)
+{
+    if (_started) return true;
+
+    HK_PROFILE_ZONE("AssetPreloader::begin");
+    auto fileUtils = FileUtils::getInstance();
+    std::string manifest = fileUtils->getStringFromFile(manifestPath);
+    if (manifest.empty()) {
+        HK_LOG_WARN(GENERAL, "Preload: manifest '%s' not found, assets will load on first use", manifestPath);
+        return false;
+    }
+
+    std::istringstream stream(manifest);
+    std::string line;
+    while (std::getline(stream, line))
+    {
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        if (line.empty() || line[0] == '#') continue;
+
+        size_t space = line.find(' ');
+        if (space == std::string::npos) continue;
+        std::string kind = line.substr(0, space);
+
+        std::unique_ptr<Entry> entry(new Entry());
+        entry->path = line.substr(space + 1);
+        if (kind == "image") entry->kind = Kind::IMAGE;
+        else if (kind == "atlas") entry->kind = Kind::ATLAS;
+        else if (kind == "map") entry->kind = Kind::MAP;
+        else if (kind == "music") entry->kind = Kind::MUSIC;
+        else if (kind == "sound") entry->kind = Kind::SOUND;
+        else {
+            HK_LOG_WARN(GENERAL, "Preload: unknown entry '%s'", line);
+            continue;
+        }
+
+        if (entry->kind == Kind::ATLAS) {
+            size_t bar = entry->path.find('|');
+            if (bar == std::string::npos) continue;
+            entry->extra = entry->path.substr(bar + 1);
+            entry->path.resize(bar);
+        }
+
+        // ·߳̽ (FileUtils ·治̰߳ȫ)
+        // ͬʱѴõ·ǰŽ
+        entry->fullPath = fileUtils->fullPathForFilename(entry->kind == Kind::ATLAS ? entry->extra : entry->path);
+        if (entry->fullPath.empty()) {
+            HK_LOG_WARN(GENERAL, "Preload: missing '%s'", entry->path);
+            continue;
+        }
+        _entries.push_back(std::move(entry));
+    }
+
+    _total = (int)_entries.size();
+    _loaded = 0;
+    _submitted = 0;
+    _started = true;
+    _startTime = nowMs();
+    HK_LOG_INFO(GENERAL, "Preload: %d assets, %d decode threads", _total, JobSystem::getInstance()->getThreadCount() - 1);
+
+    submitAhead();
+    return true;
+}
+
+// ============================================================
+//  (߳)
+// ============================================================
+void AssetPreloader::decodeJob(void* ctx, int begin, int end)
+{
+    auto self = (AssetPreloader*)ctx;
+    for (int i = begin; i < end; i++) decode(*self->_entries[i]);
+}
+
+void AssetPreloader::decode(Entry& entry)
+{
+    auto pack = PackFileUtils::getPack();
+    const uint8_t* data;
+    size_t size;
+
+    if (entry.kind == Kind::MAP) {
+        // ĵͼֱӴӳַ FileUtils м仺
+        if (pack && pack->getView(entry.fullPath, data, size)) entry.text.assign((const char*)data, size);
+        else entry.text = FileUtils::getInstance()->getStringFromFile(entry.fullPath);
+    }
+    else if (entry.kind == Kind::IMAGE || entry.kind == Kind::ATLAS) {
+        auto image = new (std::nothrow) Image();
+        if (image) {
+            // ԴͼֱӴӳ룬ʡļһο
+            bool ok = (pack && pack->getView(entry.fullPath, data, size))
+                ? image->initWithImageData(data, (ssize_t)size)
+                : image->initWithImageFileThreadSafe(entry.fullPath);
+            if (!ok) CC_SAFE_RELEASE_NULL(image);
+        }
+        entry.image = image;
+    }
+    entry.decoded.store(true, std::memory_order_release);
+}
+
+//  [_loaded, _submitted)  MAX_DECODED_AHEAD 
+void AssetPreloader::submitAhead()
+{
+    auto jobs = JobSystem::getInstance();
+    if (!jobs->isRunning()) return;
+
+    int limit = std::min(_total, _loaded + Config::Preload::MAX_DECODED_AHEAD);
+    while (_submitted < limit)
+    {
+        int end = std::min(limit, _submitted + Config::Preload::IMAGES_PER_JOB);
+        jobs->submit({ &AssetPreloader::decodeJob, this, _submitted, end, &_decodeJobs });
+        _submitted = end;
+    }
+}
+
+// ============================================================
+// ϴ (߳)
+// ============================================================
+void AssetPreloader::upload(Entry& entry)
+{
+    switch (entry.kind)
+    {
+    case Kind::IMAGE:
+    case Kind::ATLAS:
+        if (!entry.image) {
+            HK_LOG_WARN(GENERAL, "Preload: failed to decode '%s'", entry.path);
+            break;
+        }
+        {
+            // ·Ϊ addImage(·) ʱõļһ
+            auto texture = Director::getInstance()->getTextureCache()->addImage(entry.image, entry.fullPath);
+            _uploadedBytes += entry.image->getDataLen();
+            TextureResidency::getInstance()->track(entry.fullPath, texture);
+            if (texture && entry.kind == Kind::ATLAS) {
+                SpriteFrameCache::getInstance()->addSpriteFramesWithFile(entry.path, texture);
+            }
+        }
+        CC_SAFE_RELEASE_NULL(entry.image);
+        break;
+    case Kind::MAP:
+        if (!entry.text.empty()) _maps[entry.path] = std::move(entry.text);
+        break;
+    case Kind::MUSIC:
+        MusicPlayer::getInstance()->prefetch(entry.path);
+        break;
+    case Kind::SOUND:
+        AudioManager::getInstance()->preloadEffect(entry.path.c_str());
+        break;
+    }
+}
+
+bool AssetPreloader::pump(float budgetMs)
+{
+    if (!_started) return true;
+    if (isDone()) return true;
+
+    HK_PROFILE_ZONE("AssetPreloader::pump");
+    double start = nowMs();
+    bool threaded = JobSystem::getInstance()->isRunning();
+
+    while (_loaded < _total)
+    {
+        Entry& entry = *_entries[_loaded];
+        if (needsDecode(entry) && !entry.decoded.load(std::memory_order_acquire)) {
+            if (threaded) break;   // ̻߳û꣬һ֡
+            decode(entry);
+        }
+        upload(entry);
+        _loaded++;
+        submitAhead();
+
+        if (nowMs() - start >= budgetMs) break;
+    }
+
+    if (isDone()) {
+        _entries.clear();
+        _entries.shrink_to_fit();
+        HK_LOG_INFO(GENERAL, "Preload: done, %d assets in %.0f ms, %.1f MB textures",
+            _total, nowMs() - _startTime, _uploadedBytes / (1024.0 * 1024.0));
+        return true;
+    }
+    return false;
+}
+
+void AssetPreloader::finish()
+{
+    if (!_started) begin();
+    while (!pump(1000.0f)) std::this_thread::yield();
+}
+
+const std::string* AssetPreloader::getMapXml(const std::string& path) const
+{
+    auto it = _maps.find(path);
+    return it != _maps.end() ? &it->second : nullptr;
+}
@@ -0,0 +1,85 @@
+#ifndef __ASSET_PRELOADER_H__
+#define __ASSET_PRELOADER_H__
+
+#include "cocos2d.h"
+#include "JobSystem.h"
+#include "config.h"
+#include <atomic>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// ==========================================
+// Ԥ
+// 嵥 (Config::Preload::MANIFEST) ͼƬͼͼƵǰ棬
+// Ϸʱ Sprite::create / addImage / loadMap ȫл棬ͬ
+// - ͼƬ JobSystem Ĺ߳Ͻ (ļ + PNG ѹ)
+// - ϴ TextureCacheǼͼƵֻ߳
+//   pump ÿ֡ʱԤڰ嵥˳һ֣治
+// - ѽδϴͼƬޣڴֵ嵥䳤
+// ûй߳ () ʱҲ pump ͬԤ
+// ==========================================
+class AssetPreloader
+{
+public:
+    static AssetPreloader* getInstance();
+
+    // 嵥ʼ룻ظЧ嵥 false (֮ԭķʽñ߶)
+    bool begin(const std::string& manifestPath = Config::Preload::MANIFEST);
+
+    // ߳ÿ֡ã budgetMs ھദȫɷ true
+    bool pump(float budgetMs);
+    // ʱһμ (عԡط)
+    void finish();
+
+    bool isStarted() const { return _started; }
+    bool isDone() const { return _started && _loaded >= _total; }
+    int getLoadedCount() const { return _loaded; }
+    int getTotalCount() const { return _total; }
+    float getProgress() const { return _total > 0 ? (float)_loaded / _total : 1.0f; }
+
+    // Ԥ TMX ݣûʱ nullptr
+    const std::string* getMapXml(const std::string& path) const;
+
+private:
+    AssetPreloader() = default;
+    ~AssetPreloader();
+
+    enum class Kind : uint8_t { IMAGE, ATLAS, MAP, MUSIC, SOUND };
+
+    struct Entry
+    {
+        Kind kind;
+        std::string path;                    // 嵥· (ʹдһ)
+        std::string extra;                   // ͼ·
+        std::string fullPath;                // Ҫ/ȡļ· (߳̽)
+
+        std::atomic<bool> decoded{ false };  // ߳д image / text λ
+        cocos2d::Image* image = nullptr;
+        std::string text;
+    };
+
+    bool needsDecode(const Entry& entry) const { return entry.kind == Kind::IMAGE || entry.kind == Kind::ATLAS || entry.kind == Kind::MAP; }
+
+    // ߳
+    static void decodeJob(void* ctx, int begin, int end);
+    static void decode(Entry& entry);
+
+    // ߳
+    void submitAhead();
+    void upload(Entry& entry);
+
+    bool _started = false;
+    int _total = 0;
+    int _loaded = 0;                         // Ѵ (嵥˳)
+    int _submitted = 0;                      // Ͷݽ
+    std::vector<std::unique_ptr<Entry>> _entries;
+    JobCounter _decodeJobs;
+
+    std::unordered_map<std::string, std::string> _maps;
+    size_t _uploadedBytes = 0;
+    double _startTime = 0.0;
+};
+
+#endif // __ASSET_PRELOADER_H__
@@ -0,0 +1,298 @@
+#include "AudioManager.h"
+#include "audio/include/AudioEngine.h"
+#include "MusicPlayer.h"
+#include "SfxTranscoder.h"
+#include "Log.h"
+#include "AllocTracker.h"
+#include <cstring>
+#include <unordered_set>
+#include <vector>
+
+USING_NS_CC;
+using namespace cocos2d::experimental;
+
+// ǼǹЧ (ûǼǵİ DEFAULT_SOUND )
+struct AudioManager::SoundDef
+{
+    const char* path;
+    SoundCategory category;
+    int priority;       // ԽԽҪ
+    float volume;
+};
+
+namespace {
+    typedef AudioManager::SoundDef SoundDef;
+
+    const SoundDef SOUNDS[] = {
+        // path                            category               prio  vol
+        { Config::Audio::HERO_DEATH,       SoundCategory::COMBAT, 100, 1.0f },
+        { Config::Audio::HERO_DAMAGE,      SoundCategory::COMBAT,  90, 1.0f },
+        { Config::Audio::FOCUS_HEAL,       SoundCategory::COMBAT,  70, 1.0f },
+        { Config::Audio::HERO_CAST,        SoundCategory::COMBAT,  70, 1.0f },
+        { Config::Audio::FOCUS_CHARGE,     SoundCategory::COMBAT,  60, 1.0f },
+        { Config::Audio::SWORD_1,          SoundCategory::COMBAT,  50, 1.0f },
+        { Config::Audio::SWORD_2,          SoundCategory::COMBAT,  50, 1.0f },
+        { Config::Audio::SWORD_3,          SoundCategory::COMBAT,  50, 1.0f },
+        { Config::Audio::HERO_JUMP,        SoundCategory::PLAYER,  40, 1.0f },
+        { Config::Audio::HERO_LAND_HARD,   SoundCategory::PLAYER,  35, 1.0f },
+        { Config::Audio::HERO_LAND_SOFT,   SoundCategory::PLAYER,  30, 1.0f },
+        { Config::Audio::HERO_UNSHEATH,    SoundCategory::PLAYER,  30, 1.0f },
+        { Config::Audio::HERO_RUN,         SoundCategory::PLAYER,  20, 1.0f },
+    };
+
+    const SoundDef DEFAULT_SOUND = { "", SoundCategory::OTHER, 10, 1.0f };
+
+    // ÿͬʱ ( SoundCategory ˳)
+    const int CATEGORY_CAP[(int)SoundCategory::COUNT] = {
+        4,  // PLAYER
+        6,  // COMBAT
+        6,  // ENEMY
+        2,  // UI
+        4,  // OTHER
+    };
+
+    // ÿضᲥЧ (ǵĻHERO_LAND_HARD / HERO_UNSHEATH Ǽ˵ûеطԤ)
+    const char* const COMMON_SOUNDS[] = {
+        Config::Audio::HERO_JUMP,
+        Config::Audio::HERO_LAND_SOFT,
+        Config::Audio::HERO_RUN,
+        Config::Audio::HERO_DAMAGE,
+        Config::Audio::HERO_DEATH,
+        Config::Audio::SWORD_1,
+        Config::Audio::SWORD_2,
+        Config::Audio::SWORD_3,
+        Config::Audio::FOCUS_CHARGE,
+        Config::Audio::FOCUS_HEAL,
+    };
+
+    // صıֺרЧ
+    // ֮ڵ 2 شӺ 1 طŲ/Boss/ĿǰûЧԴ
+    struct LevelAudio
+    {
+        int level;
+        const char* music;
+        std::vector<const char*> sounds;
+    };
+
+    const LevelAudio LEVELS[] = {
+        { 1, Config::Audio::BGM_DIRTMOUTH, {} },
+        { 2, Config::Audio::BGM_DIRTMOUTH, { Config::Audio::HERO_CAST } },
+        { 3, Config::Audio::BGM_BOSS,      { Config::Audio::HERO_CAST } },
+    };
+
+    const int SOUND_COUNT = sizeof(SOUNDS) / sizeof(SOUNDS[0]);
+
+    // ǼǹЧʵʽ· (ЧԤغ󻻳ת WAV)ûԤصΪ nullptr
+    const char* s_playPaths[SOUND_COUNT] = {};
+
+    std::unordered_set<std::string> s_preloaded;
+
+    const SoundDef* findSound(const char* path)
+    {
+        for (const auto& def : SOUNDS) {
+            if (def.path == path || strcmp(def.path, path) == 0) return &def;
+        }
+        return nullptr;
+    }
+
+    const char* playPathOf(const SoundDef* def, const char* path)
+    {
+        if (def < SOUNDS || def >= SOUNDS + SOUND_COUNT) return path;
+        const char* playPath = s_playPaths[def - SOUNDS];
+        return playPath ? playPath : path;
+    }
+}
+
+AudioManager* AudioManager::getInstance()
+{
+    static AudioManager s_instance;
+    return &s_instance;
+}
+
+// ============================================================
+// 
+// ============================================================
+unsigned int AudioManager::play(const char* path)
+{
+    const SoundDef* def = findSound(path);
+    if (!def) def = &DEFAULT_SOUND;
+    return start(playPathOf(def, path), def, false);
+}
+
+unsigned int AudioManager::playLoop(const char* path)
+{
+    const SoundDef* def = findSound(path);
+    if (!def) {
+        HK_LOG_WARN(AUDIO, "AudioManager: loop %s is not registered", path);
+        return 0;
+    }
+    return start(playPathOf(def, path), def, true);
+}
+
+// ûǼǵЧ def  DEFAULT_SOUND (ֻ÷/ȼ)·
+unsigned int AudioManager::start(const char* path, const SoundDef* def, bool loop)
+{
+    int category = (int)def->category;
+    int inCategory = 0;
+    int freeSlot = -1;
+    for (int i = 0; i < Config::AudioMix::MAX_VOICES; i++) {
+        if (_voices[i].audioId == AudioEngine::INVALID_AUDIO_ID) {
+            if (freeSlot < 0) freeSlot = i;
+        }
+        else if ((int)_voices[i].def->category == category) {
+            inCategory++;
+        }
+    }
+
+    // ֻͬͬȫ
+    int slot = freeSlot;
+    if (inCategory >= CATEGORY_CAP[category]) slot = findVictim(def->priority, category);
+    else if (slot < 0) slot = findVictim(def->priority, -1);
+
+    if (slot < 0) {
+        _droppedCount++;
+        HK_LOG_TRACE(AUDIO, "AudioManager: dropped %s (no voice)", path);
+        return 0;
+    }
+    // 水·ַɻص std::function
+    HK_ALLOW_ALLOC_SCOPE("AudioManager::start");
+    Voice& voice = _voices[slot];
+    if (voice.audioId != AudioEngine::INVALID_AUDIO_ID) release(voice, true);
+
+    int audioId = AudioEngine::play2d(path, loop, def->volume * _volume);
+    if (audioId == AudioEngine::INVALID_AUDIO_ID) return 0;
+    if (_paused) AudioEngine::pause(audioId);
+
+    // ʱ̻߳صλ audioId  (λѾ)
+    if (!loop) {
+        AudioEngine::setFinishCallback(audioId, [this](int finishedId, const std::string&) {
+            for (auto& v : _voices) {
+                if (v.audioId == finishedId) { release(v, false); break; }
+            }
+        });
+    }
+
+    voice.audioId = audioId;
+    voice.def = def;
+    voice.gain = def->volume;
+    voice.serial = ++_serial;
+    return (unsigned int)audioId + 1;
+}
+
+// category < 0 ʾ
+int AudioManager::findVictim(int priority, int category) const
+{
+    int best = -1;
+    for (int i = 0; i < Config::AudioMix::MAX_VOICES; i++) {
+        const Voice& v = _voices[i];
+        if (v.audioId == AudioEngine::INVALID_AUDIO_ID || v.def->priority > priority) continue;
+        if (category >= 0 && (int)v.def->category != category) continue;
+        if (best < 0) { best = i; continue; }
+
+        const Voice& b = _voices[best];
+        if (v.def->priority != b.def->priority) {
+            if (v.def->priority < b.def->priority) best = i;
+        }
+        else if (v.gain != b.gain) {
+            if (v.gain < b.gain) best = i;
+        }
+        else if (v.serial < b.serial) {
+            best = i;
+        }
+    }
+    return best;
+}
+
+void AudioManager::release(Voice& voice, bool stopEngine)
+{
+    if (stopEngine) AudioEngine::stop(voice.audioId);
+    voice.audioId = AudioEngine::INVALID_AUDIO_ID;
+    voice.def = nullptr;
+}
+
+void AudioManager::stop(unsigned int soundId)
+{
+    if (soundId == 0) return;
+    for (auto& voice : _voices) {
+        if (voice.audioId == (int)soundId - 1) {
+            release(voice, true);
+            return;
+        }
+    }
+}
+
+void AudioManager::stopAll()
+{
+    for (auto& voice : _voices) {
+        if (voice.audioId != AudioEngine::INVALID_AUDIO_ID) release(voice, true);
+    }
+}
+
+// Ҳ AudioEngine ϣ AudioEngine::pauseAllֻͣԼķλ
+void AudioManager::pauseAll()
+{
+    if (_paused) return;
+    _paused = true;
+    for (auto& voice : _voices) {
+        if (voice.audioId != AudioEngine::INVALID_AUDIO_ID) AudioEngine::pause(voice.audioId);
+    }
+}
+
+void AudioManager::resumeAll()
+{
+    if (!_paused) return;
+    _paused = false;
+    for (auto& voice : _voices) {
+        if (voice.audioId != AudioEngine::INVALID_AUDIO_ID) AudioEngine::resume(voice.audioId);
+    }
+}
+
+void AudioManager::setVolume(float volume)
+{
+    _volume = clampf(volume, 0.0f, 1.0f);
+    for (auto& voice : _voices) {
+        if (voice.audioId != AudioEngine::INVALID_AUDIO_ID) AudioEngine::setVolume(voice.audioId, voice.gain * _volume);
+    }
+}
+
+int AudioManager::getActiveVoiceCount() const
+{
+    int count = 0;
+    for (const auto& voice : _voices) {
+        if (voice.audioId != AudioEngine::INVALID_AUDIO_ID) count++;
+    }
+    return count;
+}
+
+// ============================================================
+// ÿԤ
+// ============================================================
+void AudioManager::preloadEffect(const char* path)
+{
+    // Чת WAV (һʱ)ԤصʵʲŵǸļ
+    const std::string& playPath = SfxTranscoder::getInstance()->prepare(path);
+    if (const SoundDef* def = findSound(path)) s_playPaths[def - SOUNDS] = playPath.c_str();
+    if (s_preloaded.insert(playPath).second) AudioEngine::preload(playPath);
+}
+
+void AudioManager::preloadLevel(int level)
+{
+    if (level == _loadedLevel) return;
+
+    for (const char* path : COMMON_SOUNDS) preloadEffect(path);
+    for (const auto& entry : LEVELS) {
+        if (entry.level != level) continue;
+        for (const char* path : entry.sounds) preloadEffect(path);
+        MusicPlayer::getInstance()->prefetch(entry.music);
+    }
+    _loadedLevel = level;
+    HK_LOG_INFO(AUDIO, "AudioManager: level %d audio preloaded (%d effects)", level, (int)s_preloaded.size());
+}
+
+const char* AudioManager::getLevelMusic(int level)
+{
+    for (const auto& entry : LEVELS) {
+        if (entry.level == level) return entry.music;
+    }
+    return Config::Audio::BGM_DIRTMOUTH;
+}
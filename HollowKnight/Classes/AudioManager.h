@@ -0,0 +1,83 @@
+#ifndef __AUDIO_MANAGER_H__
+#define __AUDIO_MANAGER_H__
+
+#include "cocos2d.h"
+#include "config.h"
+
+// ЧÿԼͬʱ
+enum class SoundCategory
+{
+    PLAYER,     // ƶ (Ծءܲ)
+    COMBAT,     // ˡ
+    ENEMY,      // /Boss
+    UI,
+    OTHER,      // ûǼǵЧ
+    COUNT
+};
+
+// ==========================================
+// Ч (experimental::AudioEngine ֮ϵһ㣬 MusicPlayer һ)
+// - ̶Сķأ˾ռȼЧ (ȼСϵ)
+//   ͶЧ
+// - ÿޣ̫ͬʱֻͬռ (һЧ)
+// - ÿһԤ嵥loadMap ʱ () һҪõЧȫԤأ
+//   ΪһβŲŽ
+// Чȼ/Ǽ AudioManager.cpp  SOUNDS 
+// һЧʱɻص黹λ
+// ==========================================
+class AudioManager
+{
+public:
+    static AudioManager* getInstance();
+
+    // һЧЧ ID ( audioId + 1)λʱ 0
+    unsigned int play(const char* path);
+    // ѭЧ (ܲ)ҪԼ stop
+    unsigned int playLoop(const char* path);
+    void stop(unsigned int soundId);
+    void stopAll();
+    // ͣ˵ãͣ/ָЧ (ֲӰ)ͣڼ䲻շλ
+    void pauseAll();
+    void resumeAll();
+
+    // Ч (ڸԵǼǵ)
+    void setVolume(float volume);
+
+    // ԤصЧ (Чת WAV)֮ play ͬһ·ʱ WAV
+    void preloadEffect(const char* path);
+    // Ԥһص嵥 (Ѽص)Ч AudioEngine Ԥأֽ MusicPlayer Ԥȡ
+    void preloadLevel(int level);
+    // һصı
+    static const char* getLevelMusic(int level);
+
+    int getActiveVoiceCount() const;
+    // λûĴ (塢)
+    int getDroppedCount() const { return _droppedCount; }
+
+    struct SoundDef;
+
+private:
+    AudioManager() {}
+
+    struct Voice
+    {
+        int audioId = -1;           // AudioEngine::INVALID_AUDIO_ID ʾ
+        const SoundDef* def = nullptr;
+        float gain = 0.0f;
+        unsigned int serial = 0;    // ˳ռʱϵ
+    };
+
+    unsigned int start(const char* path, const SoundDef* def, bool loop);
+    // һԱ priority ռķλ (category >= 0 ʱֻڸ)ûз -1
+    int findVictim(int priority, int category) const;
+    void release(Voice& voice, bool stopEngine);
+
+    Voice _voices[Config::AudioMix::MAX_VOICES];
+    unsigned int _serial = 0;
+    float _volume = 1.0f;
+    bool _paused = false;
+    int _droppedCount = 0;
+    int _loadedLevel = 0;
+};
+
+#endif // __AUDIO_MANAGER_H__
@@ -2,6 +2,7 @@
 #define __BEHAVIOR_TREE_H__
 
 #include "cocos2d.h"
+#include "SimRandom.h"
 #include <vector>
 #include <memory>
 #include <functional>
@@ -263,7 +264,7 @@ public:
         if (_children.empty()) return BTNodeStatus::FAILURE;
         
         if (_selectedIndex < 0) {
-            _selectedIndex = rand() % _children.size();
+            _selectedIndex = SimRandom::get(RngStream::AI).range(0, (int)_children.size() - 1);
         }
         
         BTNodeStatus status = _children[_selectedIndex]->tick(dt, blackboard);
@@ -301,7 +302,7 @@ public:
         
         if (_selectedIndex < 0) {
             // Ȩѡ
-            float randomValue = (float)(rand() % 10000) / 10000.0f * _totalWeight;
+            float randomValue = SimRandom::get(RngStream::AI).range(0.0f, _totalWeight);
             float currentWeight = 0.0f;
             
             for (size_t i = 0; i < _weights.size(); i++) {
@@ -1,6 +1,11 @@
 #include "Boss.h"
 #include "FKFireball.h" // 
 #include "HitEffect.h"
+#include "Profiler.h"
+#include "AllocTracker.h"
+#include "Log.h"
+#include "SimRandom.h"
+#include "SimCocos.h"
 
 USING_NS_CC;
 
@@ -157,7 +162,7 @@ void Boss::updateBoss(float dt, const Vec2& playerPos, const std::vector<Rect>&
         if (!_isStunAnimPlaying) {
             _stunTimer -= dt;
             if (_stunTimer <= 0) {
-                CCLOG("Boss Stun Time Up! Recovering...");
+                HK_LOG_DEBUG(AI, "Boss Stun Time Up! Recovering...");
                 recoverFromStun();
             }
         }
@@ -169,7 +174,8 @@ void Boss::updateBoss(float dt, const Vec2& playerPos, const std::vector<Rect>&
         {
             if (_fireballCallback)
             {
-                float randomX = cocos2d::random(470.0f, 2558.0f);
+                HK_ALLOW_ALLOC_SCOPE("Boss::spawnFireball");
+                float randomX = SimRandom::get(RngStream::BOSS).range(470.0f, 2558.0f);
                 float y = this->getPositionY() + 800.0f;
                 _fireballCallback(Vec2(randomX, y));
             }
@@ -238,7 +244,7 @@ void Boss::performNextAction()
         return;
     }
 
-    int choice = cocos2d::random(0, 2); // 0: jump, 1: jump attack, 2: shockwave
+    int choice = SimRandom::get(RngStream::BOSS).range(0, 2); // 0: jump, 1: jump attack, 2: shockwave
     if (choice == 0)
     {
         switchState(State::Pre_Jump);
@@ -257,6 +263,9 @@ void Boss::performNextAction()
 
 void Boss::switchState(State newState)
 {
+    HK_PROFILE_ZONE("Boss::switchState");
+    HK_ALLOW_ALLOC_SCOPE("Boss::switchState"); // ÿ״̬ƴ
+
     _state = newState;
 
     // ״̬лʱǿƹرմ˺
@@ -274,7 +283,7 @@ void Boss::switchState(State newState)
     {
     case State::Idle:
         playAnimation("boss/idle/", 1, 5, true, 0.1f);
-        _stateTimer = cocos2d::random(0.6f, 1.0f);
+        _stateTimer = SimRandom::get(RngStream::BOSS).range(0.6f, 1.0f);
         break;
 
     case State::Falling_Enter:
@@ -433,7 +442,7 @@ void Boss::switchState(State newState)
 
 void Boss::recoverFromStun()
 {
-    CCLOG("Boss Recovering from Stun (early)...");
+    HK_LOG_DEBUG(AI, "Boss Recovering from Stun (early)...");
 
     _hitCount = 0;
     _actionStep = 0;
@@ -442,7 +451,7 @@ void Boss::recoverFromStun()
 
 void Boss::startRampage()
 {
-    CCLOG("Boss starts rampage!");
+    HK_LOG_INFO(AI, "Boss starts rampage!");
     this->setName("Rampage");
     switchState(State::Rampage_Jump);
 }
@@ -466,6 +475,8 @@ void Boss::rampageAttackLoop(int count)
         return;
     }
 
+    _rampageCounter = count;
+
     float newFacing = (count % 2 == 0) ? -1.0f : 1.0f;
     applyFacing(newFacing);
 
@@ -482,6 +493,7 @@ void Boss::rampageAttackLoop(int count)
 
 void Boss::onLand()
 {
+    HK_ALLOW_ALLOC_SCOPE("Boss::onLand"); // еĶƴ
     if (_state == State::Falling_Enter || _state == State::Jumping)
     {
         _velocity = Vec2(0, 0);
@@ -582,6 +594,9 @@ void Boss::scheduleHammerWindow(float startDelay, float duration)
 
 void Boss::playAnimation(std::string folder, int startFrame, int frameCount, bool loop, float delay, std::function<void()> onComplete)
 {
+    HK_PROFILE_ZONE("Boss::playAnimation");
+    HK_ALLOW_ALLOC_SCOPE("Boss::playAnimation");
+
     Vector<SpriteFrame*> frames;
     int endFrame = startFrame + frameCount - 1;
 
@@ -758,4 +773,136 @@ void Boss::die()
     {
         this->setVisible(false);
     }
-}
\ No newline at end of file
+}
+
+// ============================================================
+// 
+// ============================================================
+void Boss::saveSnapshot(BossSnapshot& out) const
+{
+    out.state = (uint8_t)_state;
+    out.position = SimCocos::toSim(this->getPosition());
+    out.velocity = SimCocos::toSim(_velocity);
+    out.facing = _facing;
+
+    out.hitCount = _hitCount;
+    out.stunHitCount = _stunHitCount;
+    out.stunHP = _stunHP;
+    out.stunTimer = _stunTimer;
+    out.isStunAnimPlaying = _isStunAnimPlaying;
+    out.hurtTimer = _hurtTimer;
+    out.lastPlayerX = _lastPlayerX;
+
+    out.isDead = _isDead;
+    out.onGround = _onGround;
+    out.isAttackLanded = _isAttackLanded;
+
+    out.rampageCounter = _rampageCounter;
+    out.rampageFireballTimer = _rampageFireballTimer;
+    out.isRampaging = _isRampaging;
+
+    out.actionStep = _actionStep;
+    out.stateTimer = _stateTimer;
+    out.pendingIdleCount = _pendingIdleCount;
+}
+
+void Boss::restoreSnapshot(const BossSnapshot& in)
+{
+    this->stopAllActions();
+    if (_sprite) {
+        _sprite->stopAllActions();
+        _sprite->setColor(Color3B::WHITE);
+        _sprite->setOpacity(255);
+    }
+    this->setVisible(true);
+    this->setName("Normal");
+    _isHammerActive = false;
+
+    _state = (State)in.state;
+    this->setPosition(SimCocos::toCocos(in.position));
+    _velocity = SimCocos::toCocos(in.velocity);
+    _facing = in.facing >= 0 ? 1.0f : -1.0f;
+    if (_sprite) _sprite->setScaleX(BOSS_SCALE * _facing);
+
+    _hitCount = in.hitCount;
+    _stunHitCount = in.stunHitCount;
+    _stunHP = in.stunHP;
+    _stunTimer = in.stunTimer;
+    _isStunAnimPlaying = in.isStunAnimPlaying;
+    _hurtTimer = in.hurtTimer;
+    _lastPlayerX = in.lastPlayerX;
+
+    _isDead = in.isDead;
+    _onGround = in.onGround;
+    _isAttackLanded = in.isAttackLanded;
+
+    _rampageCounter = in.rampageCounter;
+    _rampageFireballTimer = in.rampageFireballTimer;
+    _isRampaging = in.isRampaging;
+
+    _actionStep = in.actionStep;
+    _stateTimer = in.stateTimer;
+    _pendingIdleCount = in.pendingIdleCount;
+
+    if (_isDead) {
+        this->setName("Dead");
+        this->setVisible(false);
+        return;
+    }
+
+    // ϱ֣ switchState ĵطΪ˲üʱ
+    switch (_state)
+    {
+    case State::Idle:
+        playAnimation("boss/idle/", 1, 5, true, 0.1f);
+        break;
+
+    case State::Falling_Enter:
+        playAnimation("boss/fall/", 1, 7, true, 0.1f);
+        break;
+
+    case State::Jumping:
+    case State::Rampage_Jump:
+        playAnimation("boss/jump/", 1, 10, false, 0.1f);
+        break;
+
+    case State::Jump_Attack:
+        if (_isAttackLanded) {
+            // Ѿҵأ²һ
+            _isAttackLanded = false;
+            onLand();
+        }
+        else if (_sprite) {
+            auto f = Sprite::create("boss/jumpAttack/4.png");
+            if (f) _sprite->setSpriteFrame(f->getSpriteFrame());
+        }
+        break;
+
+    case State::Shockwave_Attack:
+        switchState(State::Shockwave_Attack);
+        break;
+
+    case State::Stunned:
+        if (_isStunAnimPlaying) {
+            switchState(State::Stunned);
+            _stunHitCount = in.stunHitCount;
+            _stunTimer = in.stunTimer;
+        }
+        else {
+            this->setName("Stunned");
+            auto f = Sprite::create("boss/recovery/14.png");
+            if (f && _sprite) _sprite->setSpriteFrame(f->getSpriteFrame());
+        }
+        break;
+
+    case State::Rampage_Attack:
+        rampageAttackLoop(_rampageCounter);
+        break;
+
+    default:
+        // ˲ʱ״̬ (Pre_Jump / Pre_Attack / Recovering) ͣ֡ĩ
+        _state = State::Idle;
+        playAnimation("boss/idle/", 1, 5, true, 0.1f);
+        break;
+    }
+}
@@ -4,6 +4,7 @@
 #include "cocos2d.h"
 #include "FKFireball.h"
 #include "GameEntity.h"
+#include "SimSnapshot.h"
 
 class Boss : public cocos2d::Node
 {
@@ -38,6 +39,7 @@ public:
     cocos2d::Rect getHammerHitbox() const;
 
     bool isDead() const { return _isDead; }
+    bool isRampaging() const { return _isRampaging; }
 
     // ɻĻص
     void setFireballCallback(const std::function<void(const cocos2d::Vec2&)>& callback) {
@@ -47,6 +49,11 @@ public:
         _shockwaveCallback = callback;
     }
 
+    // գֵͼʱԭָƽʽ (Ҵ)
+    // ӵǰһеĿͷ²ţ³ǩ
+    void saveSnapshot(BossSnapshot& out) const;
+    void restoreSnapshot(const BossSnapshot& in);
+
 private:
     // 
     void playAnimation(std::string name, int startFrame, int frameCount, bool loop, float delay = 0.1f, std::function<void()> onComplete = nullptr);
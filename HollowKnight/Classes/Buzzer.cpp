@@ -1,5 +1,10 @@
 #include "Buzzer.h"
 #include "HitEffect.h"
+#include "config.h"
+#include "Profiler.h"
+#include "AllocTracker.h"
+#include "Log.h"
+#include "SimCocos.h"
 
 USING_NS_CC;
 
@@ -38,7 +43,7 @@ bool Buzzer::init()
     playIdleAnimation();
 
     // ֮ ( GameEntity ṩĹ)
-    this->setDreamThought("...Kill...Crush...");
+    this->setDreamThought(Config::Dialogue::THOUGHT_BUZZER);
 
     CCLOG(" [Buzzer::init] Buzzer initialized successfully!");
 
@@ -47,6 +52,8 @@ bool Buzzer::init()
 
 void Buzzer::loadAnimations()
 {
+    HK_PROFILE_ZONE("Buzzer::loadAnimations");
+
     // idle (4֡)
     Vector<SpriteFrame*> idleFrames;
     for (int i = 1; i <= 4; i++)
@@ -56,11 +63,11 @@ void Buzzer::loadAnimations()
         if (sprite)
         {
             idleFrames.pushBack(sprite->getSpriteFrame());
-            CCLOG("  ? Loaded idle frame: %s", frameName.c_str());
+            HK_LOG_TRACE(ANIM, "Loaded idle frame: %s", frameName.c_str());
         }
         else
         {
-            CCLOG("  ? Failed to load idle frame: %s", frameName.c_str());
+            HK_LOG_WARN(ANIM, "Failed to load idle frame: %s", frameName.c_str());
         }
     }
 
@@ -68,7 +75,7 @@ void Buzzer::loadAnimations()
     {
         _idleAnimation = Animation::createWithSpriteFrames(idleFrames, 0.15f);
         _idleAnimation->retain();
-        CCLOG("? Idle animation created with %d frames", (int)idleFrames.size());
+        HK_LOG_DEBUG(ANIM, "Idle animation created with %d frames", (int)idleFrames.size());
     }
     else
     {
@@ -84,11 +91,11 @@ void Buzzer::loadAnimations()
         if (sprite)
         {
             attackFrames.pushBack(sprite->getSpriteFrame());
-            CCLOG("  ? Loaded attack frame: %s", frameName.c_str());
+            HK_LOG_TRACE(ANIM, "Loaded attack frame: %s", frameName.c_str());
         }
         else
         {
-            CCLOG("  ? Failed to load attack frame: %s", frameName.c_str());
+            HK_LOG_WARN(ANIM, "Failed to load attack frame: %s", frameName.c_str());
         }
     }
 
@@ -96,7 +103,7 @@ void Buzzer::loadAnimations()
     {
         _attackAnimation = Animation::createWithSpriteFrames(attackFrames, 0.1f);
         _attackAnimation->retain();
-        CCLOG("? Attack animation created with %d frames", (int)attackFrames.size());
+        HK_LOG_DEBUG(ANIM, "Attack animation created with %d frames", (int)attackFrames.size());
     }
     else
     {
@@ -113,7 +120,7 @@ void Buzzer::playIdleAnimation()
         auto repeat = RepeatForever::create(animate);
         repeat->setTag(100);
         this->runAction(repeat);
-        CCLOG("?? Playing idle animation");
+        HK_LOG_TRACE(ANIM, "Playing idle animation");
     }
 }
 
@@ -126,7 +133,7 @@ void Buzzer::playAttackAnimation()
         auto repeat = RepeatForever::create(animate);
         repeat->setTag(100);
         this->runAction(repeat);
-        CCLOG("? Playing attack animation");
+        HK_LOG_TRACE(ANIM, "Playing attack animation");
     }
 }
 
@@ -140,7 +147,7 @@ void Buzzer::playDeathAnimation()
 
     auto removeSelf = CallFunc::create([this]() {
         this->removeFromParent();
-        CCLOG("?? Buzzer removed from scene");
+        HK_LOG_DEBUG(AI, "Buzzer removed from scene");
     });
 
     auto sequence = Sequence::create(spawn, removeSelf, nullptr);
@@ -148,36 +155,39 @@ void Buzzer::playDeathAnimation()
 }
 
 // ========================================
-// AI ĸº
+// AI ĸº (֪/ߣ JobSystem )
+// ڵ㱾ֻλá״̬ǽ commands
 // ========================================
-void Buzzer::update(float dt, const cocos2d::Vec2& playerPos)
+void Buzzer::think(float dt, const cocos2d::Vec2& playerPos, SceneCommandBuffer& commands, int order)
 {
     if (_currentState == State::DEAD)
     {
         return;
     }
 
+    Vec2 pos = this->getPosition();
+
     // ״ִ̬вͬΪ
     switch (_currentState)
     {
     case State::IDLE:
         // ǷڷΧ
-        if (isPlayerInRange(playerPos))
+        if (isPlayerInRange(playerPos, pos))
         {
-            CCLOG("[Buzzer] Player detected! Starting attack!");
-            changeState(State::ATTACKING);
+            HK_LOG_DEBUG(AI, "[Buzzer] Player detected! Starting attack!");
+            requestState(State::ATTACKING, commands, order);
         }
         break;
 
     case State::ATTACKING:
         // ׷
-        chasePlayer(playerPos, dt);
+        pos = chasePlayer(playerPos, pos, dt, commands, order);
         
         // 뿪Χidle
-        if (!isPlayerInRange(playerPos))
+        if (!isPlayerInRange(playerPos, pos))
         {
-            CCLOG("[Buzzer] Player out of range, returning to idle");
-            changeState(State::IDLE);
+            HK_LOG_DEBUG(AI, "[Buzzer] Player out of range, returning to idle");
+            requestState(State::IDLE, commands, order);
         }
         break;
 
@@ -186,18 +196,17 @@ void Buzzer::update(float dt, const cocos2d::Vec2& playerPos)
     }
 }
 
-bool Buzzer::isPlayerInRange(const cocos2d::Vec2& playerPos)
+bool Buzzer::isPlayerInRange(const cocos2d::Vec2& playerPos, const cocos2d::Vec2& buzzerPos) const
 {
-    Vec2 buzzerPos = this->getPosition();
     // ޸ġֻˮƽ루XᣩǴֱ
     float horizontalDistance = std::abs(playerPos.x - buzzerPos.x);
     return horizontalDistance <= _detectionRange;
 }
 
-void Buzzer::chasePlayer(const cocos2d::Vec2& playerPos, float dt)
+// ׷λ (ͬʱǽ commands)
+cocos2d::Vec2 Buzzer::chasePlayer(const cocos2d::Vec2& playerPos, const cocos2d::Vec2& buzzerPos, float dt,
+                                  SceneCommandBuffer& commands, int order)
 {
-    Vec2 buzzerPos = this->getPosition();
-    
     // ޸ġ͸߶ƣ400500
     float minHeight = 500.0f; // ߶
     
@@ -208,7 +217,7 @@ void Buzzer::chasePlayer(const cocos2d::Vec2& playerPos, float dt)
     float distance = direction.length();
     if (distance < 20.0f)
     {
-        return;
+        return buzzerPos;
     }
     
     // ޸ġBuzzer͸߶ȣֻˮƽƶ
@@ -223,46 +232,40 @@ void Buzzer::chasePlayer(const cocos2d::Vec2& playerPos, float dt)
             
             // ֻӦˮƽٶ
             Vec2 newPos = Vec2(buzzerPos.x + horizontalDirection * _chaseSpeed * dt, minHeight);
-            this->setPosition(newPos);
+            commands.setPosition(order, this, newPos);
             
-            // ޸FlipX߼
-            if (horizontalDirection < 0)
-            {
-                this->setFlippedX(false);  // ƶFlipX=false
-            }
-            else
-            {
-                this->setFlippedX(true);   // ƶңFlipX=true
-            }
+            // ޸FlipX߼ƶFlipX=falseƶңFlipX=true
+            commands.setFlippedX(order, this, horizontalDirection >= 0);
+            return newPos;
         }
+        return buzzerPos;
     }
-    else
+
+    // ׷ֱƶ
+    // һ
+    direction.normalize();
+    
+    // Ӧٶ
+    Vec2 newPos = buzzerPos + direction * _chaseSpeed * dt;
+    
+    // ȷ͸߶
+    if (newPos.y < minHeight)
     {
-        // ׷ֱƶ
-        // һ
-        direction.normalize();
-        
-        // Ӧٶ
-        Vec2 newPos = buzzerPos + direction * _chaseSpeed * dt;
-        
-        // ȷ͸߶
-        if (newPos.y < minHeight)
-        {
-            newPos.y = minHeight;
-        }
-        
-        this->setPosition(newPos);
-        
-        // ޸FlipX߼
-        if (direction.x < 0)
-        {
-            this->setFlippedX(false);  // ƶFlipX=false
-        }
-        else if (direction.x > 0)
-        {
-            this->setFlippedX(true);   // ƶңFlipX=true
-        }
+        newPos.y = minHeight;
+    }
+    
+    commands.setPosition(order, this, newPos);
+    
+    // ޸FlipX߼
+    if (direction.x < 0)
+    {
+        commands.setFlippedX(order, this, false);  // ƶFlipX=false
+    }
+    else if (direction.x > 0)
+    {
+        commands.setFlippedX(order, this, true);   // ƶңFlipX=true
     }
+    return newPos;
 }
 
 void Buzzer::changeState(State newState)
@@ -273,8 +276,32 @@ void Buzzer::changeState(State newState)
     }
 
     _currentState = newState;
+    playStateAnimation(newState);
+}
 
-    switch (_currentState)
+// ߽׶״̬״ֵ̬Чǳ̲߳
+void Buzzer::requestState(State newState, SceneCommandBuffer& commands, int order)
+{
+    if (_currentState == newState)
+    {
+        return;
+    }
+
+    _currentState = newState;
+    commands.call(order, this, &Buzzer::enterStateCommand, (int)newState);
+}
+
+void Buzzer::enterStateCommand(Node* node, int state)
+{
+    static_cast<Buzzer*>(node)->playStateAnimation((State)state);
+}
+
+void Buzzer::playStateAnimation(State state)
+{
+    // ״̬½
+    HK_ALLOW_ALLOC_SCOPE("Buzzer::changeState");
+
+    switch (state)
     {
     case State::IDLE:
         playIdleAnimation();
@@ -299,7 +326,7 @@ void Buzzer::takeDamage(int damage, const cocos2d::Vec2& attackerPos)
 
     _isInvincible = true;
     _health -= damage;
-    CCLOG("?? Buzzer took %d damage! Health: %d/%d", damage, _health, _maxHealth);
+    HK_LOG_DEBUG(COMBAT, "Buzzer took %d damage! Health: %d/%d", damage, _health, _maxHealth);
 
     // ====== ܻЧ ======
     float fxSize = std::max(this->getContentSize().width, this->getContentSize().height) * 0.8f;
@@ -315,7 +342,7 @@ void Buzzer::takeDamage(int damage, const cocos2d::Vec2& attackerPos)
         if (_onDeathCallback)
         {
             _onDeathCallback();
-            CCLOG("Buzzer died -> Trigger callback (Gain Soul)");
+            HK_LOG_DEBUG(COMBAT, "Buzzer died -> Trigger callback (Gain Soul)");
         }
     }
     // ܻЧ
@@ -360,7 +387,7 @@ void Buzzer::takeDamage(int damage, const cocos2d::Vec2& attackerPos)
     // Ƿ
     if (_health <= 0)
     {
-        CCLOG("? Buzzer defeated!");
+        HK_LOG_DEBUG(COMBAT, "Buzzer defeated!");
         changeState(State::DEAD);
     }
 
@@ -417,3 +444,42 @@ Buzzer::~Buzzer()
     CC_SAFE_RELEASE(_idleAnimation);
     CC_SAFE_RELEASE(_attackAnimation);
 }
+
+// ========================================
+// 
+// ========================================
+void Buzzer::saveSnapshot(EntitySnapshot& out) const
+{
+    out.tag = this->getTag();
+    out.kind = EntitySnapshot::Kind::BUZZER;
+    out.state = (uint8_t)_currentState;
+    out.position = SimCocos::toSim(this->getPosition());
+    out.velocity = SimCocos::toSim(_velocity);
+    out.health = _health;
+    out.facingRight = this->isFlippedX(); // FlipX=true ʾ
+    out.onGround = false;
+    out.patrol = PatrolState();
+}
+
+void Buzzer::restoreSnapshot(const EntitySnapshot& in)
+{
+    this->stopAllActions();
+    this->unscheduleAllCallbacks();
+    this->setColor(Color3B::WHITE);
+    this->setOpacity(255);
+    this->setRotation(0);
+    _isInvincible = false;
+
+    this->setPosition(SimCocos::toCocos(in.position));
+    _velocity = SimCocos::toCocos(in.velocity);
+    _health = in.health;
+    this->setFlippedX(in.facingRight);
+
+    _currentState = (State)in.state;
+    switch (_currentState)
+    {
+    case State::IDLE: playIdleAnimation(); break;
+    case State::ATTACKING: playAttackAnimation(); break;
+    case State::DEAD: playDeathAnimation(); break;
+    }
+}
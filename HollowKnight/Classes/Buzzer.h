@@ -1,6 +1,8 @@
 #ifndef __BUZZER_H__
 #define __BUZZER_H__
 #include "GameEntity.h"
+#include "SimSnapshot.h"
+#include "SceneCommandBuffer.h"
 #include "cocos2d.h"
 #include <functional>
 
@@ -19,8 +21,9 @@ public:
     static Buzzer* create(const std::string& filename);
     virtual bool init() override;
 
-    // ·AI߼
-    void update(float dt, const cocos2d::Vec2& playerPos);
+    // ֪/ߣAI߼ڵֻ JobSystem ܣ
+    // λá״̬ () ǽ commands߳ commit
+    void think(float dt, const cocos2d::Vec2& playerPos, SceneCommandBuffer& commands, int order);
 
     // ˷
     void takeDamage(int damage, const cocos2d::Vec2& attackerPos) override;
@@ -43,10 +46,18 @@ public:
     typedef std::function<void()> DeathCallback;
     void setOnDeathCallback(DeathCallback callback) { _onDeathCallback = callback; }
 
+    //  (SimSnapshot.h)ָʱ/˸ȽеĶ޵дڲָ
+    void saveSnapshot(EntitySnapshot& out) const;
+    void restoreSnapshot(const EntitySnapshot& in);
+    bool isDead() const { return _currentState == State::DEAD; }
+
 private:
     // ״̬
     State _currentState;
     void changeState(State newState);
+    void requestState(State newState, SceneCommandBuffer& commands, int order); // ߽׶
+    static void enterStateCommand(cocos2d::Node* node, int state);
+    void playStateAnimation(State state);
 
     // 
     cocos2d::Animation* _idleAnimation;
@@ -68,8 +79,9 @@ private:
     cocos2d::Vec2 _velocity;         // ǰٶ
 
     // 
-    bool isPlayerInRange(const cocos2d::Vec2& playerPos);
-    void chasePlayer(const cocos2d::Vec2& playerPos, float dt);
+    bool isPlayerInRange(const cocos2d::Vec2& playerPos, const cocos2d::Vec2& buzzerPos) const;
+    cocos2d::Vec2 chasePlayer(const cocos2d::Vec2& playerPos, const cocos2d::Vec2& buzzerPos, float dt,
+                              SceneCommandBuffer& commands, int order);
 
     // ص
     DeathCallback _onDeathCallback = nullptr;
@@ -1,8 +1,50 @@
 #include "DreamDialogue.h"
 #include "Config.h" 
+#include "Profiler.h"
 
 USING_NS_CC;
 
+namespace {
+    const char* ANIM_KEY_UP = "dream_dialogue_up";
+    const char* ANIM_KEY_DOWN = "dream_dialogue_down";
+
+    // еĶԻ (Vector  retainƳ󲻻ᱻͷ)
+    Vector<DreamDialogue*> s_pool;
+
+    TTFConfig makeTTFConfig()
+    {
+        // ߴС enableOutline һ£һŲԤȵͼ
+        TTFConfig ttf(Config::Dialogue::FONT, Config::Dialogue::FONT_SIZE);
+        ttf.outlineSize = Config::Dialogue::OUTLINE_SIZE;
+        return ttf;
+    }
+
+    Animation* buildBubbleAnimation(const std::string& format, const char* key)
+    {
+        auto cache = AnimationCache::getInstance();
+        auto anim = cache->getAnimation(key);
+        if (anim) return anim;
+
+        Vector<SpriteFrame*> frames;
+        for (int i = 1; i <= Config::Dialogue::BUBBLE_FRAMES; i++)
+        {
+            std::string path = StringUtils::format(format.c_str(), i);
+
+            auto texture = Director::getInstance()->getTextureCache()->addImage(path);
+            if (texture) {
+                auto frame = SpriteFrame::createWithTexture(texture, Rect(0, 0, texture->getContentSize().width, texture->getContentSize().height));
+                frames.pushBack(frame);
+            }
+            else {
+                CCLOG("Error: Frame not found: %s", path.c_str());
+            }
+        }
+        anim = Animation::createWithSpriteFrames(frames, Config::Dialogue::BUBBLE_FRAME_DELAY);
+        cache->addAnimation(anim, key);
+        return anim;
+    }
+}
+
 DreamDialogue* DreamDialogue::create(const std::string& text) {
     DreamDialogue* pRet = new(std::nothrow) DreamDialogue();
     if (pRet && pRet->init(text)) {
@@ -24,12 +66,12 @@ bool DreamDialogue::init(const std::string& text) {
         this->addChild(_bg);
     }
 
-    // 2. 
-    _label = Label::createWithTTF(text, "fonts/Marker Felt.ttf", 60);
+    // 2.  (Ԥʱʹͬһ TTFConfigͼ)
+    _label = Label::createWithTTF(makeTTFConfig(), text);
     if (_label && _bg) {
         _label->setPosition(_bg->getContentSize().width/2, _bg->getContentSize().height/2+30.0f); // 
         _label->setTextColor(Color4B::WHITE);
-        _label->enableOutline(Color4B::BLACK, 1);
+        _label->enableOutline(Color4B::BLACK, Config::Dialogue::OUTLINE_SIZE);
         _label->setDimensions(_bg->getContentSize().width * 0.8f, 0); // Զ
         _label->setAlignment(TextHAlignment::CENTER);
         _label->setOpacity(0); // ʼ
@@ -39,51 +81,113 @@ bool DreamDialogue::init(const std::string& text) {
     return true;
 }
 
-void DreamDialogue::show()
+// =============================================================
+// 
+// =============================================================
+
+void DreamDialogue::preloadAssets()
 {
-    if (!_bg) return;
+    HK_PROFILE_ZONE("DreamDialogue::preloadAssets");
 
-    // =============================================================
-    // 1. ء֡ (dreamUp 1~5)
-    // =============================================================
-    Vector<SpriteFrame*> upFrames;
-    for (int i = 1; i <= 5; i++)
-    {
-        // ƴ·dialogue/dreamUp/dreamUp_1.png ...
-        std::string path = StringUtils::format(Config::Path::DREAM_DIALOGUE_UP.c_str(), i);
+    // 1. ݶֻһΣŽ AnimationCache
+    buildBubbleAnimation(Config::Path::DREAM_DIALOGUE_UP, ANIM_KEY_UP);
+    buildBubbleAnimation(Config::Path::DREAM_DIALOGUE_DOWN, ANIM_KEY_DOWN);
 
-        auto texture = Director::getInstance()->getTextureCache()->addImage(path);
-        if (texture) {
-            auto frame = SpriteFrame::createWithTexture(texture, Rect(0, 0, texture->getContentSize().width, texture->getContentSize().height));
-            upFrames.pushBack(frame);
-        }
-        else {
-            CCLOG("Error: Frame not found: %s", path.c_str());
+    // 2. Ԥͼַֹǰդ
+    std::string glyphs;
+    for (const char* text : Config::Dialogue::ALL_TEXTS) {
+        glyphs += text;
+    }
+    std::u32string utf32;
+    if (StringUtils::UTF8ToUTF32(glyphs, utf32)) {
+        TTFConfig ttf = makeTTFConfig();
+        auto atlas = FontAtlasCache::getFontAtlasTTF(&ttf);
+        if (atlas) {
+            atlas->prepareLetterDefinitions(utf32);
         }
     }
-    // 0.05һ֡ܿ쵯
-    auto animUp = Animation::createWithSpriteFrames(upFrames, 0.05f);
 
-    // =============================================================
-    // 2. ءʧ (dreamDown 1~5)
-    // =============================================================
-    Vector<SpriteFrame*> downFrames;
-    for (int i = 1; i <= 5; i++)
-    {
-        // ƴ·dialogue/dreamDown/dreamDown_1.png ...
-        std::string path = StringUtils::format(Config::Path::DREAM_DIALOGUE_DOWN.c_str(), i);
+    // 3. ԤȴԻ
+    while (s_pool.size() < Config::Dialogue::POOL_SIZE) {
+        auto dialogue = DreamDialogue::create("");
+        if (!dialogue) break;
+        s_pool.pushBack(dialogue);
+    }
+
+    CCLOG("DreamDialogue: preloaded, pool size = %d", (int)s_pool.size());
+}
+
+DreamDialogue* DreamDialogue::acquire(const std::string& text)
+{
+    if (s_pool.empty()) {
+        return DreamDialogue::create(text);
+    }
+
+    // ȡʱ autorelease һΣֺ create() һü
+    DreamDialogue* dialogue = s_pool.back();
+    dialogue->retain();
+    dialogue->autorelease();
+    s_pool.popBack();
 
-        auto texture = Director::getInstance()->getTextureCache()->addImage(path);
-        if (texture) {
-            auto frame = SpriteFrame::createWithTexture(texture, Rect(0, 0, texture->getContentSize().width, texture->getContentSize().height));
-            downFrames.pushBack(frame);
+    dialogue->setText(text);
+    return dialogue;
+}
+
+void DreamDialogue::purgePool()
+{
+    s_pool.clear();
+}
+
+int DreamDialogue::getPooledCount()
+{
+    return (int)s_pool.size();
+}
+
+void DreamDialogue::setText(const std::string& text)
+{
+    if (_label) _label->setString(text);
+}
+
+void DreamDialogue::reset()
+{
+    if (_bg) {
+        _bg->stopAllActions();
+        auto anim = AnimationCache::getInstance()->getAnimation(ANIM_KEY_UP);
+        if (anim && !anim->getFrames().empty()) {
+            _bg->setSpriteFrame(anim->getFrames().front()->getSpriteFrame());
         }
     }
-    // Ҳ 0.05һ֡
-    auto animDown = Animation::createWithSpriteFrames(downFrames, 0.05f);
+    if (_label) {
+        _label->stopAllActions();
+        _label->setOpacity(0);
+    }
+}
+
+void DreamDialogue::recycle()
+{
+    //  (ӿʱʱ new Щ)ֱƳŸڵͷ
+    if ((int)s_pool.size() >= Config::Dialogue::POOL_SIZE) {
+        this->removeFromParent();
+        return;
+    }
+    // ȷŻس (retain)ٴӸڵƳֹͷ
+    s_pool.pushBack(this);
+    this->removeFromParent();
+    reset();
+}
+
+void DreamDialogue::show()
+{
+    if (!_bg) return;
 
     // =============================================================
-    // 3. ϶ (Sequence)
+    // 1. ȡԤõġ֡/ʧ (dreamUp / dreamDown 1~5)
+    // =============================================================
+    auto animUp = buildBubbleAnimation(Config::Path::DREAM_DIALOGUE_UP, ANIM_KEY_UP);
+    auto animDown = buildBubbleAnimation(Config::Path::DREAM_DIALOGUE_DOWN, ANIM_KEY_DOWN);
+
+    // =============================================================
+    // 2. ϶ (Sequence)
     // =============================================================
 
     // A: ֵ
@@ -96,21 +200,23 @@ void DreamDialogue::show()
         if (_label) _label->runAction(FadeOut::create(0.2f));
         });
 
-    // C:  (ӸڵƳ)
-    auto killSelf = RemoveSelf::create();
+    // C: յ (ԭ RemoveSelf)
+    auto recycleSelf = CallFunc::create([this]() {
+        recycle();
+        });
 
     // ž籾
     auto seq = Sequence::create(
         Animate::create(animUp),      // 1. ݴС󵯳
         showTextAction,               // 2. 
-        DelayTime::create(5.0f),      // 3. ͣĶ5
+        DelayTime::create(Config::Dialogue::HOLD_TIME), // 3. ͣĶ5
         hideTextAction,               // 4. ʧ
         DelayTime::create(0.2f),      // 5. ΢һ
         Animate::create(animDown),    // 6. ݴӴСʧ
-        killSelf,                     // 7. ɾͷڴ
+        recycleSelf,                  // 7. Żسӣ´ֱӸ
         nullptr
     );
 
     // ʼִ
     _bg->runAction(seq);
-}
\ No newline at end of file
+}
@@ -8,12 +8,32 @@ public:
     static DreamDialogue* create(const std::string& text);
     virtual bool init(const std::string& text);
 
-    // ִʾ̣ -> ͣ -> ʧ -> Ի
+    // =============================================================
+    // ؽӿ
+    // =============================================================
+    // ʱãԤݶԤͼԤȴ POOL_SIZE Ի
+    static void preloadAssets();
+    // ӳȡһԻ (ؿʱ½)ȡճ addChild + show()
+    static DreamDialogue* acquire(const std::string& text);
+    // ˳ʱճ
+    static void purgePool();
+    // пеĶԻ (ʾ)
+    static int getPooledCount();
+
+    // ʾ ( Label´)
+    void setText(const std::string& text);
+
+    // ִʾ̣ -> ͣ -> ʧ -> յ
     void show();
 
 private:
-    cocos2d::Sprite* _bg;
-    cocos2d::Label* _label;
+    // õʼ״̬ (һ֡ + ͸)
+    void reset();
+    // ŽӸڵƳŻس
+    void recycle();
+
+    cocos2d::Sprite* _bg = nullptr;
+    cocos2d::Label* _label = nullptr;
 };
 
-#endif
\ No newline at end of file
+#endif
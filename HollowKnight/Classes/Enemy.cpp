@@ -1,5 +1,10 @@
 #include "Enemy.h"
 #include "HitEffect.h"
+#include "config.h"
+#include "Profiler.h"
+#include "AllocTracker.h"
+#include "Log.h"
+#include "SimCocos.h"
 USING_NS_CC;
 
 Enemy* Enemy::create(const std::string& filename)
@@ -35,13 +40,11 @@ bool Enemy::init()
     _currentState = State::PATROL;
     _health = 3;
     _maxHealth = 3;
-    _moveSpeed = 50.0f;
-    _movingRight = true;
-    
-    _patrolLeftBound = 0.0f;
-    _patrolRightBound = 300.0f;
+    _patrol.speed = 50.0f;
+    _patrol.movingRight = true;
+    PatrolAI::setRange(_patrol, 0.0f, 300.0f);
 
-    this->setDreamThought("...Duty... ...King...");
+    this->setDreamThought(Config::Dialogue::THOUGHT_ENEMY);
 
     // ض
     loadAnimations();
@@ -59,6 +62,8 @@ bool Enemy::init()
 
 void Enemy::loadAnimations()
 {
+    HK_PROFILE_ZONE("Enemy::loadAnimations");
+
     Vector<SpriteFrame*> walkFrames;
     bool anyFrameFailed = false;
     for (int i = 1; i <= 4; i++)
@@ -69,11 +74,11 @@ void Enemy::loadAnimations()
         {
             auto frame = testSprite->getSpriteFrame();
             walkFrames.pushBack(frame);
-            CCLOG("   Loaded frame: %s", frameName.c_str());
+            HK_LOG_TRACE(ANIM, "Loaded frame: %s", frameName.c_str());
         }
         else
         {
-            CCLOG("   Failed to load frame: %s", frameName.c_str());
+            HK_LOG_WARN(ANIM, "Failed to load frame: %s", frameName.c_str());
             anyFrameFailed = true;
         }
     }
@@ -82,14 +87,14 @@ void Enemy::loadAnimations()
     {
         _walkAnimation = Animation::createWithSpriteFrames(walkFrames, 0.15f);
         _walkAnimation->retain();
-        CCLOG(" Walk animation created with %d frames", (int)walkFrames.size());
+        HK_LOG_DEBUG(ANIM, "Walk animation created with %d frames", (int)walkFrames.size());
         if (anyFrameFailed) {
-            CCLOG(" [Enemy::loadAnimations] Some frames failed to load, animation may be incomplete.");
+            HK_LOG_WARN(ANIM, "[Enemy::loadAnimations] Some frames failed to load, animation may be incomplete.");
         }
     }
     else
     {
-        CCLOG(" [Enemy::loadAnimations] No frames loaded, animation will not play!");
+        HK_LOG_WARN(ANIM, "[Enemy::loadAnimations] No frames loaded, animation will not play!");
         _walkAnimation = nullptr;
     }
 
@@ -103,11 +108,11 @@ void Enemy::playWalkAnimation()
         auto animate = Animate::create(_walkAnimation);
         auto repeat = RepeatForever::create(animate);
         this->runAction(repeat);
-        CCLOG(" Playing walk animation");
+        HK_LOG_TRACE(ANIM, "Playing walk animation");
     }
     else
     {
-        CCLOG(" Cannot play animation - _walkAnimation is null");
+        HK_LOG_WARN(ANIM, "Cannot play animation - _walkAnimation is null");
     }
 }
 
@@ -121,7 +126,7 @@ void Enemy::playDeathAnimation()
     
     auto removeSelf = CallFunc::create([this]() {
         this->removeFromParent();
-        CCLOG("Enemy removed from scene");
+        HK_LOG_DEBUG(AI, "Enemy removed from scene");
     });
 
     auto sequence = Sequence::create(spawn, removeSelf, nullptr);
@@ -135,33 +140,45 @@ void Enemy::update(float dt)
         return;
     }
 
-    // Ѳ߼
-    Vec2 currentPos = this->getPosition();
+    // Ѳ߼ (PatrolAI ƶͱ߽ͷ)
+    bool turned = false;
+    float x = stepPatrol(dt, turned);
+    this->setPositionX(x);
 
-    if (_movingRight)
+    if (turned)
     {
-        currentPos.x += _moveSpeed * dt;
-
-        if (currentPos.x >= _patrolRightBound)
-        {
-            _movingRight = false;
-            this->setFlippedX(true);
-            CCLOG("[Enemy] Reached right bound, turning left");
-        }
+        this->setFlippedX(!_patrol.movingRight);
     }
-    else
+}
+
+// Ĳо߽׶εãڵֻλúͳǽ commands
+void Enemy::think(float dt, SceneCommandBuffer& commands, int order)
+{
+    if (_currentState == State::DEAD)
     {
-        currentPos.x -= _moveSpeed * dt;
+        return;
+    }
 
-        if (currentPos.x <= _patrolLeftBound)
-        {
-            _movingRight = true;
-            this->setFlippedX(false);
-            CCLOG("[Enemy] Reached left bound, turning right");
-        }
+    bool turned = false;
+    float x = stepPatrol(dt, turned);
+    commands.setPosition(order, this, Vec2(x, this->getPositionY()));
+
+    if (turned)
+    {
+        commands.setFlippedX(order, this, !_patrol.movingRight);
     }
+}
 
-    this->setPosition(currentPos);
+float Enemy::stepPatrol(float dt, bool& turned)
+{
+    float x = PatrolAI::step(_patrol, this->getPositionX(), dt, &turned);
+    if (turned)
+    {
+        HK_LOG_DEBUG(AI, "[Enemy] Reached %s bound, turning %s",
+            _patrol.movingRight ? "left" : "right",
+            _patrol.movingRight ? "right" : "left");
+    }
+    return x;
 }
 
 // ======================================================================
@@ -172,7 +189,7 @@ void Enemy::takeDamage(int damage, const cocos2d::Vec2& attackerPos)
     if (_currentState == State::DEAD || _isInvincible) return;
 
     _health -= damage;
-    CCLOG(" Enemy took % d damage!Health: % d / % d", damage, _health, _maxHealth);
+    HK_LOG_DEBUG(COMBAT, "Enemy took % d damage!Health: % d / % d", damage, _health, _maxHealth);
     _isInvincible = true;
     // ========================================
     // 1. ܻЧλ΢ƫ£
@@ -188,7 +205,7 @@ void Enemy::takeDamage(int damage, const cocos2d::Vec2& attackerPos)
     // 3. 
     float knockbackDistance = 30.0f;
     float knockbackDuration = 0.2f;
-    float direction = _movingRight ? -1.0f : 1.0f;
+    float direction = _patrol.movingRight ? -1.0f : 1.0f;
     Vec2 currentPos = this->getPosition();
     Vec2 knockbackTarget = Vec2(currentPos.x + direction * knockbackDistance, currentPos.y);
     auto knockback = MoveTo::create(knockbackDuration, knockbackTarget);
@@ -199,7 +216,7 @@ void Enemy::takeDamage(int damage, const cocos2d::Vec2& attackerPos)
         }, 0.2f, "invincible_cooldown");
     if (_health <= 0)
     {
-        CCLOG("Enemy defeated!");
+        HK_LOG_DEBUG(COMBAT, "Enemy defeated!");
         changeState(State::DEAD);
         if (_onDeathCallback)
         {
@@ -212,12 +229,15 @@ void Enemy::changeState(State newState)
 {
     if (_currentState == newState)
     {
-        CCLOG("[Enemy::changeState] State unchanged: %d", (int)newState);
+        HK_LOG_TRACE(AI, "[Enemy::changeState] State unchanged: %d", (int)newState);
         return;
     }
 
     _currentState = newState;
-    CCLOG("[Enemy::changeState] State changed to: %d", (int)newState);
+    HK_LOG_DEBUG(AI, "[Enemy::changeState] State changed to: %d", (int)newState);
+
+    // ״̬½
+    HK_ALLOW_ALLOC_SCOPE("Enemy::changeState");
 
     switch (_currentState)
     {
@@ -228,16 +248,15 @@ void Enemy::changeState(State newState)
         playDeathAnimation();
         break;
     default:
-        CCLOG("[Enemy::changeState] Unknown state: %d", (int)_currentState);
+        HK_LOG_WARN(AI, "[Enemy::changeState] Unknown state: %d", (int)_currentState);
         break;
     }
 }
 
 void Enemy::setPatrolRange(float leftBound, float rightBound)
 {
-    _patrolLeftBound = leftBound;
-    _patrolRightBound = rightBound;
-    CCLOG("[Enemy] Patrol range set: %.0f to %.0f", leftBound, rightBound);
+    PatrolAI::setRange(_patrol, leftBound, rightBound);
+    HK_LOG_DEBUG(AI, "[Enemy] Patrol range set: %.0f to %.0f", leftBound, rightBound);
 }
 
 // ȡ˵ײ
@@ -281,12 +300,49 @@ void Enemy::onCollideWithPlayer(const cocos2d::Vec2& playerPos)
     auto easeOut = EaseOut::create(knockback, 2.0f);
     this->runAction(easeOut);
 
-    CCLOG("[Enemy] Knocked back by player collision");
+    HK_LOG_DEBUG(COMBAT, "[Enemy] Knocked back by player collision");
 }
 
 Enemy::~Enemy()
 {
-    CCLOG("[Enemy::~Enemy] Destructor called. Releasing animations.");
+    HK_LOG_TRACE(AI, "[Enemy::~Enemy] Destructor called. Releasing animations.");
     CC_SAFE_RELEASE(_walkAnimation);
     CC_SAFE_RELEASE(_deathAnimation);
 }
+
+// ========================================
+// 
+// ========================================
+void Enemy::saveSnapshot(EntitySnapshot& out) const
+{
+    out.tag = this->getTag();
+    out.kind = EntitySnapshot::Kind::ENEMY;
+    out.state = (uint8_t)_currentState;
+    out.position = SimCocos::toSim(this->getPosition());
+    out.velocity = SimVec2();
+    out.health = _health;
+    out.facingRight = _patrol.movingRight;
+    out.onGround = true;
+    out.patrol = _patrol;
+}
+
+void Enemy::restoreSnapshot(const EntitySnapshot& in)
+{
+    this->stopAllActions();
+    this->unscheduleAllCallbacks();
+    this->setColor(Color3B::WHITE);
+    this->setOpacity(255);
+    this->setRotation(0);
+    _isInvincible = false;
+
+    this->setPosition(SimCocos::toCocos(in.position));
+    _health = in.health;
+    _patrol = in.patrol;
+    this->setFlippedX(!_patrol.movingRight);
+
+    _currentState = (State)in.state;
+    if (_currentState == State::DEAD) playDeathAnimation();
+    else playWalkAnimation();
+
+    this->scheduleUpdate();
+}
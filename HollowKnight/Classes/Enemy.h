@@ -3,6 +3,9 @@
 #include <functional> 
 #include "cocos2d.h"
 #include "GameEntity.h" // 
+#include "PatrolAI.h"
+#include "SimSnapshot.h"
+#include "SceneCommandBuffer.h"
 
 USING_NS_CC;
 
@@ -21,8 +24,10 @@ public:
     // ʼ
     virtual bool init() override;
 
-    // ÿ֡
+    // ÿ֡ ()
     void update(float dt) override;
+    //  update Ѳ߾ߣڵֻ JobSystem ܣλúͳǽ commands
+    void think(float dt, SceneCommandBuffer& commands, int order);
 
     // Ѳ߷Χ
     void setPatrolRange(float leftBound, float rightBound);
@@ -41,6 +46,11 @@ public:
     // ûصĺ
     void setOnDeathCallback(DeathCallback callback) { _onDeathCallback = callback; }
 
+    //  (SimSnapshot.h)ָʱ/˸ȽеĶ޵дڲָ
+    void saveSnapshot(EntitySnapshot& out) const;
+    void restoreSnapshot(const EntitySnapshot& in);
+    bool isDead() const { return _currentState == State::DEAD; }
+
     // 
     virtual ~Enemy();
 
@@ -55,10 +65,9 @@ private:
     void playDeathAnimation();
 
     // ƶ
-    float _moveSpeed;           // ƶٶ
-    bool _movingRight;          // Ƿƶ
-    float _patrolLeftBound;     // Ѳ߽
-    float _patrolRightBound;    // Ѳұ߽
+    // Ѳ (ٶȡұ߽)߼ͷ PatrolAI
+    PatrolState _patrol;
+    float stepPatrol(float dt, bool& turned);   // µ xĽڵ
 
     // 
     int _health;                // ֵ
@@ -1,4 +1,6 @@
 #include "FKFireball.h"
+#include "SimCocos.h"
+#include "SceneCommandBuffer.h"
 
 USING_NS_CC;
 
@@ -38,31 +40,47 @@ bool FKFireball::init(const std::string& imagePath)
     return true;
 }
 
-void FKFireball::update(float dt, const std::vector<Rect>& groundRects)
+Rect FKFireball::step(float dt, const std::vector<Rect>& groundRects, SceneCommandBuffer& commands, int order)
 {
     _velocity.y += FK_GRAVITY * dt;
-    this->setPosition(this->getPosition() + _velocity * dt);
+    Vec2 pos = this->getPosition() + _velocity * dt;
+    commands.setPosition(order, this, pos);
 
-    Rect bbox = getCollisionBox();
+    Rect bbox = getCollisionBoxAt(pos);
     for (const auto& ground : groundRects)
     {
         if (bbox.intersectsRect(ground))
         {
-            this->removeFromParent();
-            return;
+            commands.removeFromParent(order, this);
+            return Rect::ZERO;
         }
     }
+    return bbox;
 }
 
-Rect FKFireball::getCollisionBox() const
+Rect FKFireball::getCollisionBoxAt(const Vec2& pos) const
 {
     if (!_sprite) return Rect::ZERO;
 
     Size size = _sprite->getContentSize();
     Vec2 anchor = _sprite->getAnchorPoint();
-    Vec2 pos = this->getPosition();
 
     float originX = pos.x - size.width * anchor.x;
     float originY = pos.y - size.height * anchor.y;
     return Rect(originX, originY, size.width, size.height);
 }
+
+void FKFireball::saveSnapshot(ProjectileSnapshot& out) const
+{
+    out.kind = ProjectileSnapshot::Kind::BOSS_FIREBALL;
+    out.position = SimCocos::toSim(this->getPosition());
+    out.velocity = SimCocos::toSim(_velocity);
+    out.life = 0.0f;
+    out.dir = 0.0f;
+}
+
+void FKFireball::restoreSnapshot(const ProjectileSnapshot& in)
+{
+    this->setPosition(SimCocos::toCocos(in.position));
+    _velocity = SimCocos::toCocos(in.velocity);
+}
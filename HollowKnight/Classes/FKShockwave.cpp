@@ -1,4 +1,6 @@
 #include "FKShockwave.h"
+#include "SimCocos.h"
+#include "SceneCommandBuffer.h"
 
 USING_NS_CC;
 
@@ -43,13 +45,14 @@ bool FKShockwave::init(const std::string& imagePath, float direction)
     return true;
 }
 
-void FKShockwave::update(float dt, const std::vector<Rect>& groundRects)
+Rect FKShockwave::step(float dt, const std::vector<Rect>& groundRects, SceneCommandBuffer& commands, int order)
 {
     Vec2 delta = _velocity * dt;
-    this->setPosition(this->getPosition() + delta);
+    Vec2 pos = this->getPosition() + delta;
+    commands.setPosition(order, this, pos);
     _lifeDistance += std::abs(delta.x);
 
-    Rect bbox = getCollisionBox();
+    Rect bbox = getCollisionBoxAt(pos);
 
     // ֻײֱǽʱƳػ
     for (const auto& rect : groundRects)
@@ -61,16 +64,16 @@ void FKShockwave::update(float dt, const std::vector<Rect>& groundRects)
         {
             if (bbox.getMaxX() >= rect.getMinX() && bbox.getMinX() < rect.getMinX())
             {
-                this->removeFromParent();
-                return;
+                commands.removeFromParent(order, this);
+                return Rect::ZERO;
             }
         }
         else
         {
             if (bbox.getMinX() <= rect.getMaxX() && bbox.getMaxX() > rect.getMaxX())
             {
-                this->removeFromParent();
-                return;
+                commands.removeFromParent(order, this);
+                return Rect::ZERO;
             }
         }
     }
@@ -78,11 +81,13 @@ void FKShockwave::update(float dt, const std::vector<Rect>& groundRects)
     // ֹ޴
     if (_lifeDistance > 4000.0f)
     {
-        this->removeFromParent();
+        commands.removeFromParent(order, this);
+        return Rect::ZERO;
     }
+    return bbox;
 }
 
-Rect FKShockwave::getCollisionBox() const
+Rect FKShockwave::getCollisionBoxAt(const Vec2& pos) const
 {
     if (!_sprite) return Rect::ZERO;
 
@@ -103,7 +108,6 @@ Rect FKShockwave::getCollisionBox() const
     float hitHeight = finalHeight * hitBoxRatioH;
 
     Vec2 anchor = _sprite->getAnchorPoint();
-    Vec2 pos = this->getPosition();
 
     // Ӿ
     float centerX = pos.x + finalWidth * (0.5f - anchor.x);
@@ -112,4 +116,20 @@ Rect FKShockwave::getCollisionBox() const
     // ӾСײ
     return Rect(centerX - hitWidth / 2, centerY - hitHeight / 2, hitWidth, hitHeight);
     // --- ޸Ľ ---
-}
\ No newline at end of file
+}
+
+void FKShockwave::saveSnapshot(ProjectileSnapshot& out) const
+{
+    out.kind = ProjectileSnapshot::Kind::SHOCKWAVE;
+    out.position = SimCocos::toSim(this->getPosition());
+    out.velocity = SimCocos::toSim(_velocity);
+    out.life = _lifeDistance;
+    out.dir = _dir;
+}
+
+void FKShockwave::restoreSnapshot(const ProjectileSnapshot& in)
+{
+    this->setPosition(SimCocos::toCocos(in.position));
+    _velocity = SimCocos::toCocos(in.velocity);
+    _lifeDistance = in.life;
+}
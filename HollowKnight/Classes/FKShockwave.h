@@ -2,6 +2,9 @@
 #define __FK_SHOCKWAVE_H__
 
 #include "cocos2d.h"
+#include "SimSnapshot.h"
+
+class SceneCommandBuffer;
 
 class FKShockwave : public cocos2d::Node
 {
@@ -9,10 +12,19 @@ public:
     static FKShockwave* create(const std::string& imagePath, float direction);
     virtual bool init(const std::string& imagePath, float direction);
 
-    void update(float dt, const std::vector<cocos2d::Rect>& groundRects);
-    cocos2d::Rect getCollisionBox() const;
+    // 推进一帧 (可以在 JobSystem 的工作线程上调用)：只改自己的速度/计时，
+    // 新位置和移除记进 commands，主线程 commit 后才生效
+    // 返回新位置上的碰撞框；这一帧要被移除时返回 Rect::ZERO
+    cocos2d::Rect step(float dt, const std::vector<cocos2d::Rect>& groundRects, SceneCommandBuffer& commands, int order);
+    cocos2d::Rect getCollisionBox() const { return getCollisionBoxAt(this->getPosition()); }
+
+    // 快照 (方向在 create 时给定，这里只恢复位置和已飞行距离)
+    void saveSnapshot(ProjectileSnapshot& out) const;
+    void restoreSnapshot(const ProjectileSnapshot& in);
 
 private:
+    cocos2d::Rect getCollisionBoxAt(const cocos2d::Vec2& pos) const;
+
     cocos2d::Sprite* _sprite = nullptr;
     cocos2d::Vec2 _velocity;
     float _dir = 1.0f;
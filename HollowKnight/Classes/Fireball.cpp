@@ -1,5 +1,7 @@
 #include "Fireball.h"
 #include "config.h"
+#include "Profiler.h"
+#include "SimCocos.h"
 
 Fireball* Fireball::create(const std::string& firstFrame)
 {
@@ -166,5 +168,24 @@ void Fireball::addHitEnemy(int enemyTag)
 
 void Fireball::loadAnimation()
 {
+    HK_PROFILE_ZONE("Fireball::loadAnimation");
+
     // ÷ҪĻ
 }
+
+// 
+void Fireball::saveSnapshot(ProjectileSnapshot& out) const
+{
+    out.kind = ProjectileSnapshot::Kind::PLAYER_FIREBALL;
+    out.position = SimCocos::toSim(this->getPosition());
+    out.velocity = SimCocos::toSim(_velocity);
+    out.life = _lifeTime;
+    out.dir = _velocity.x < 0 ? -1.0f : 1.0f;
+}
+
+void Fireball::restoreSnapshot(const ProjectileSnapshot& in)
+{
+    shoot(std::abs(in.velocity.x), in.dir < 0 ? -1 : 1);
+    this->setPosition(SimCocos::toCocos(in.position));
+    _lifeTime = in.life;
+}
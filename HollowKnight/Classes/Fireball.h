@@ -2,6 +2,7 @@
 #define __FIREBALL_H__
 
 #include "cocos2d.h"
+#include "SimSnapshot.h"
 
 USING_NS_CC;
 
@@ -33,6 +34,11 @@ public:
 
     // ŷж (Ϊӵʱ)
     void playFlyAnimation();
+
+    // գֻ淢ȥĻ (ϵĵɳ¼)
+    bool isLaunched() const { return _isLaunched; }
+    void saveSnapshot(ProjectileSnapshot& out) const;
+    void restoreSnapshot(const ProjectileSnapshot& in);
 private:
     // 
     void loadAnimation();
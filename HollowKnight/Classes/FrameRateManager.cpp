@@ -0,0 +1,74 @@
+#include "FrameRateManager.h"
+#include "config.h"
+#include <algorithm>
+
+USING_NS_CC;
+
+FrameRateManager* FrameRateManager::s_instance = nullptr;
+
+FrameRateManager* FrameRateManager::getInstance()
+{
+    if (!s_instance)
+    {
+        s_instance = new FrameRateManager();
+    }
+    return s_instance;
+}
+
+FrameRateManager::FrameRateManager()
+    : _isIdle(false)
+    , _idleFPS(Config::Power::DEFAULT_IDLE_FPS)
+{
+    int saved = UserDefault::getInstance()->getIntegerForKey(Config::Power::IDLE_FPS_KEY, Config::Power::DEFAULT_IDLE_FPS);
+    _idleFPS = std::max(Config::Power::MIN_IDLE_FPS, std::min(saved, Config::Power::ACTIVE_FPS));
+}
+
+void FrameRateManager::applyFPS(int fps)
+{
+    Director::getInstance()->setAnimationInterval(1.0f / fps);
+}
+
+void FrameRateManager::enterIdle()
+{
+    if (_isIdle) return;
+    _isIdle = true;
+
+    applyFPS(_idleFPS);
+    CCLOG("FrameRate: idle (%d fps)", _idleFPS);
+}
+
+void FrameRateManager::enterActive()
+{
+    // ȡûʱĽ֡
+    Director::getInstance()->getScheduler()->unschedule("frame_rate_idle", this);
+
+    if (!_isIdle) return;
+    _isIdle = false;
+
+    applyFPS(Config::Power::ACTIVE_FPS);
+    CCLOG("FrameRate: active (%d fps)", Config::Power::ACTIVE_FPS);
+}
+
+void FrameRateManager::onUserInput()
+{
+    if (!_isIdle) return;
+
+    // Ȼָ֡һʱûٽȥ
+    applyFPS(Config::Power::ACTIVE_FPS);
+
+    auto scheduler = Director::getInstance()->getScheduler();
+    scheduler->unschedule("frame_rate_idle", this);
+    scheduler->schedule([this](float) {
+        if (_isIdle) applyFPS(_idleFPS);
+        }, this, 0, 0, Config::Power::INPUT_BOOST_TIME, false, "frame_rate_idle");
+}
+
+void FrameRateManager::setIdleFPS(int fps)
+{
+    _idleFPS = std::max(Config::Power::MIN_IDLE_FPS, std::min(fps, Config::Power::ACTIVE_FPS));
+
+    UserDefault::getInstance()->setIntegerForKey(Config::Power::IDLE_FPS_KEY, _idleFPS);
+    UserDefault::getInstance()->flush();
+
+    if (_isIdle) applyFPS(_idleFPS);
+}
@@ -0,0 +1,42 @@
+#ifndef __FRAME_RATE_MANAGER_H__
+#define __FRAME_RATE_MANAGER_H__
+
+#include "cocos2d.h"
+
+// ==========================================
+// ֡ʹ
+// ûϷģʱ (ʼ˵ͣ) ֡ʽ idle 
+// ˵аʱʱָ֡صϷָ֡
+// ==========================================
+class FrameRateManager
+{
+public:
+    static FrameRateManager* getInstance();
+
+    // ˵/ͣ
+    void enterIdle();
+    // صϷ
+    void enterActive();
+
+    // ˵룺֡һСʱ䣬ù궯
+    void onUserInput();
+
+    bool isIdle() const { return _isIdle; }
+
+    // ֡ (ᱣ浽 UserDefault)
+    int getIdleFPS() const { return _idleFPS; }
+    void setIdleFPS(int fps);
+
+private:
+    FrameRateManager();
+    ~FrameRateManager() = default;
+
+    static FrameRateManager* s_instance;
+
+    bool _isIdle;
+    int _idleFPS;
+
+    void applyFPS(int fps);
+};
+
+#endif // __FRAME_RATE_MANAGER_H__
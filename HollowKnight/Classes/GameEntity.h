@@ -32,7 +32,7 @@ public:
     {
         if (!_dreamThought.empty())
         {
-            auto dialogue = DreamDialogue::create(_dreamThought);
+            auto dialogue = DreamDialogue::acquire(_dreamThought);
             if (dialogue) {
                 // ĬʾͷϷ 60 
                 dialogue->setPosition(this->getPosition() + cocos2d::Vec2(0, 60));
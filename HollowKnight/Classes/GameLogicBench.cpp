@@ -0,0 +1,322 @@
+#include "benchmark/benchmark.h"
+#include "SimWorld.h"
+#include "SimBatch.h"
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+// ============================================================
+// 淨ȵ·ܲ (Google Benchmark)
+//
+// Ĭϰѽд bench_results.jsonԱȲͬ汾
+//   GameLogicBench                                  -> bench_results.json
+//   GameLogicBench --benchmark_out=other.json       -> Լָļ
+//
+//  HK_BENCH_HEADLESS ʱֻͷĲ ( cocos)
+// Ϊ /  / λ⼸Ҫ cocos ͷļͿ (Ҫ GL )
+// ============================================================
+
+#ifndef HK_BENCH_HEADLESS
+#include "cocos2d.h"
+#include "BehaviorTree.h"
+#include "KeyBindingScene.h"
+#endif
+
+namespace {
+
+// ̶ӵ֤ͬ࣬ÿɵĵͼһ
+struct BenchRng
+{
+    unsigned int state;
+    explicit BenchRng(unsigned int seed) : state(seed) {}
+    float next01() { state = state * 1664525u + 1013904223u; return (state >> 8) * (1.0f / 16777216.0f); }
+    float range(float lo, float hi) { return lo + (hi - lo) * next01(); }
+};
+
+//  count /ǽھΣ [0, worldW] x [0, worldH] 
+SimRectList makeSyntheticMap(int count, float worldW, float worldH)
+{
+    BenchRng rng(12345u);
+    SimRectList rects;
+    rects.reserve(count);
+    for (int i = 0; i < count; i++) {
+        rects.push_back(SimRect(rng.range(0, worldW), rng.range(0, worldH), rng.range(40, 400), rng.range(20, 120)));
+    }
+    return rects;
+}
+
+PlayerBody makeBody(const SimVec2& pos)
+{
+    PlayerBody body;
+    body.position = pos;
+    body.localBox = SimRect(-25, 30, 50, 100); //  Player::init ı
+    return body;
+}
+
+} // namespace
+
+// ============================================================
+// 1. ײ (Player::updateCollisionX/Y ίи PlayerPhysics)
+// ============================================================
+static void BM_PlayerCollisionX(benchmark::State& state)
+{
+    const int count = (int)state.range(0);
+    SimRectList map = makeSyntheticMap(count, 20000.0f, 4000.0f);
+    PlayerBody body = makeBody(SimVec2(10000, 2000));
+
+    for (auto _ : state) {
+        body.position = SimVec2(10000, 2000);
+        body.velocity = SimVec2(300, 0);
+        PlayerPhysics::collideX(body, map);
+        benchmark::DoNotOptimize(body);
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+    state.SetComplexityN(count);
+}
+BENCHMARK(BM_PlayerCollisionX)->RangeMultiplier(10)->Range(100, 100000)->Complexity(benchmark::oN);
+
+static void BM_PlayerCollisionY(benchmark::State& state)
+{
+    const int count = (int)state.range(0);
+    SimRectList map = makeSyntheticMap(count, 20000.0f, 4000.0f);
+    PlayerBody body = makeBody(SimVec2(10000, 2000));
+
+    for (auto _ : state) {
+        body.position = SimVec2(10000, 2000);
+        body.velocity = SimVec2(0, -500);
+        PlayerPhysics::collideY(body, map);
+        benchmark::DoNotOptimize(body);
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+    state.SetComplexityN(count);
+}
+BENCHMARK(BM_PlayerCollisionY)->RangeMultiplier(10)->Range(100, 100000)->Complexity(benchmark::oN);
+
+// һ ( + ײ)Ӧÿ֡ Player::update 
+static void BM_PlayerPhysicsStep(benchmark::State& state)
+{
+    const int count = (int)state.range(0);
+    SimRectList map = makeSyntheticMap(count, 20000.0f, 4000.0f);
+    map.push_back(SimRect(0, 0, 20000, 100)); // ֤е
+    PlayerBody body = makeBody(SimVec2(10000, 200));
+
+    for (auto _ : state) {
+        body.velocity.x = 300;
+        PlayerPhysics::step(body, 1.0f / 60, map);
+        benchmark::DoNotOptimize(body);
+    }
+    state.SetComplexityN(count);
+}
+BENCHMARK(BM_PlayerPhysicsStep)->RangeMultiplier(10)->Range(100, 100000)->Complexity(benchmark::oN);
+
+// ============================================================
+// 2. ж vs N  (HelloWorld::update  4 ڵı)
+// ============================================================
+static void BM_AttackHitboxVsEnemies(benchmark::State& state)
+{
+    const int count = (int)state.range(0);
+    BenchRng rng(777u);
+    std::vector<SimPatroller> enemies(count);
+    for (auto& e : enemies) {
+        e.position = SimVec2(rng.range(0, 20000), rng.range(0, 4000));
+        e.size = SimVec2(80, 90);
+    }
+    SimRect attack(10000, 2000, 180, 120);
+
+    for (auto _ : state) {
+        int hits = 0;
+        for (const auto& e : enemies) {
+            if (e.isAlive() && attack.intersectsRect(e.getHitbox())) hits++;
+        }
+        benchmark::DoNotOptimize(hits);
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+    state.SetComplexityN(count);
+}
+BENCHMARK(BM_AttackHitboxVsEnemies)->RangeMultiplier(4)->Range(16, 16384)->Complexity(benchmark::oN);
+
+// ============================================================
+// 3. ͷ岽 (/һܵ)
+// ============================================================
+static void BM_SimWorldStep(benchmark::State& state)
+{
+    SimWorld world;
+    world.setPlatforms(makeSyntheticMap((int)state.range(0), 20000.0f, 4000.0f));
+    world.addPlatform(SimRect(0, 0, 20000, 100));
+    world.spawnPlayer(SimVec2(500, 200), SimRect(-25, 30, 50, 100));
+    for (int i = 0; i < 32; i++) {
+        world.addPatroller(SimVec2(500.0f + i * 500, 100), SimVec2(80, 90), 400.0f + i * 500, 700.0f + i * 500, 50.0f);
+    }
+
+    SimInput input;
+    unsigned long long frame = 0;
+    for (auto _ : state) {
+        input.moveX = ((frame / 300) % 2 == 0) ? 1 : -1;
+        input.jump = (frame % 50) < 20;
+        world.step(1.0f / 60, input);
+        frame++;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_SimWorldStep)->Arg(100)->Arg(1000);
+
+// Ự߳ 1/2/4/8Ƿ
+static void BM_SimBatchSessions(benchmark::State& state)
+{
+    std::vector<SimSessionSpec> specs(64);
+    for (size_t i = 0; i < specs.size(); i++) {
+        specs[i].seed = i + 1;
+        specs[i].frames = 3600;
+    }
+    SimBatchRunner runner((int)state.range(0));
+    std::vector<SimSessionResult> results;
+
+    for (auto _ : state) {
+        SimBatchSummary summary = runner.run(specs, results);
+        benchmark::DoNotOptimize(summary);
+    }
+    state.SetItemsProcessed(state.iterations() * specs.size() * 3600);
+}
+BENCHMARK(BM_SimBatchSessions)->Arg(1)->Arg(2)->Arg(4)->Arg(8)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+#ifndef HK_BENCH_HEADLESS
+// ============================================================
+// 4. Ϊ tick (һܳ Sequence ) Ϳ (һ Selector ºܶ)
+// ============================================================
+namespace {
+
+std::shared_ptr<BTNode> makeDeepTree(int depth)
+{
+    std::shared_ptr<BTNode> node = std::make_shared<BTAction>([](float, Blackboard&) {
+        return BTNodeStatus::SUCCESS;
+        });
+    for (int i = 0; i < depth; i++) {
+        auto seq = std::make_shared<BTSequence>();
+        seq->addChild(std::make_shared<BTCondition>([](Blackboard& bb) { return bb.getBool("alive", true); }));
+        seq->addChild(node);
+        node = seq;
+    }
+    return node;
+}
+
+std::shared_ptr<BTNode> makeWideTree(int width)
+{
+    auto selector = std::make_shared<BTSelector>();
+    // ǰ width-1 ȫʧܣһɹÿ tick Ҫ
+    for (int i = 0; i < width - 1; i++) {
+        selector->addChild(std::make_shared<BTCondition>([](Blackboard& bb) { return bb.getFloat("distance") < 0.0f; }));
+    }
+    selector->addChild(std::make_shared<BTAction>([](float, Blackboard&) { return BTNodeStatus::SUCCESS; }));
+    return selector;
+}
+
+} // namespace
+
+static void BM_BehaviorTreeDeep(benchmark::State& state)
+{
+    auto root = makeDeepTree((int)state.range(0));
+    Blackboard bb;
+    bb.setBool("alive", true);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(root->tick(1.0f / 60, bb));
+    }
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_BehaviorTreeDeep)->RangeMultiplier(4)->Range(4, 1024)->Complexity(benchmark::oN);
+
+static void BM_BehaviorTreeWide(benchmark::State& state)
+{
+    auto root = makeWideTree((int)state.range(0));
+    Blackboard bb;
+    bb.setFloat("distance", 100.0f);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(root->tick(1.0f / 60, bb));
+    }
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_BehaviorTreeWide)->RangeMultiplier(4)->Range(4, 1024)->Complexity(benchmark::oN);
+
+// ============================================================
+// 5. Ƭι֡ʽ +  SpriteFrameCache +  Animation
+// ( PlayerAnimator ƬͬĲ裬֡ԲҪ GL)
+// ============================================================
+static void BM_AnimationClipBuild(benchmark::State& state)
+{
+    const int frameCount = (int)state.range(0);
+    const char* format = "bench/clip/clip_%d.png";
+    auto cache = cocos2d::SpriteFrameCache::getInstance();
+    for (int i = 1; i <= frameCount; i++) {
+        auto frame = cocos2d::SpriteFrame::createWithTexture(nullptr, cocos2d::Rect(0, 0, 64, 64));
+        cache->addSpriteFrame(frame, cocos2d::StringUtils::format(format, i));
+    }
+
+    for (auto _ : state) {
+        cocos2d::Vector<cocos2d::SpriteFrame*> frames;
+        frames.reserve(frameCount);
+        for (int i = 1; i <= frameCount; i++) {
+            auto frame = cache->getSpriteFrameByName(cocos2d::StringUtils::format(format, i));
+            if (frame) frames.pushBack(frame);
+        }
+        auto anim = cocos2d::Animation::createWithSpriteFrames(frames, 0.1f);
+        benchmark::DoNotOptimize(anim);
+        cocos2d::PoolManager::getInstance()->getCurrentPool()->clear();
+    }
+    state.SetItemsProcessed(state.iterations() * frameCount);
+}
+BENCHMARK(BM_AnimationClipBuild)->Arg(4)->Arg(12)->Arg(32);
+
+// ============================================================
+// 6. λַHelloWorld ̻صʵߵ·
+//    fillKeyTable (λûʱֻȽϰ汾) + InputQueue ƽ̱± +  + ÿȡ
+// ============================================================
+static void BM_KeyBindingDispatch(benchmark::State& state)
+{
+    auto kbm = KeyBindingManager::getInstance();
+    InputQueue queue;
+    // µľʵҪ鵽βĶͬ
+    int code = (int)kbm->getKeyForAction(KeyBindingManager::Action::DREAM_NAIL);
+
+    uint16_t bits = 0;
+    double simTime = 0.0;
+    for (auto _ : state) {
+        // һΰ + һɿ update ͷȡ (в)
+        kbm->fillKeyTable(queue);
+        uint16_t keyBits = queue.bitsForKey(code);
+        if (!(keyBits & InputQueue::PAUSE_BIT)) queue.push(keyBits, true, simTime);
+        kbm->fillKeyTable(queue);
+        queue.push(queue.bitsForKey(code), false, simTime);
+        simTime += 1.0 / 60;
+        queue.beginStep(simTime, bits);
+        benchmark::DoNotOptimize(bits);
+    }
+    state.SetItemsProcessed(state.iterations() * 2);
+}
+BENCHMARK(BM_KeyBindingDispatch);
+#endif // HK_BENCH_HEADLESS
+
+// ============================================================
+// mainûָļʱĬд JSON
+// ============================================================
+int main(int argc, char** argv)
+{
+    std::vector<char*> args(argv, argv + argc);
+    bool hasOut = false;
+    for (int i = 1; i < argc; i++) {
+        if (std::strncmp(argv[i], "--benchmark_out=", 16) == 0) hasOut = true;
+    }
+
+    static char outArg[] = "--benchmark_out=bench_results.json";
+    static char fmtArg[] = "--benchmark_out_format=json";
+    if (!hasOut) {
+        args.push_back(outArg);
+        args.push_back(fmtArg);
+    }
+
+    int newArgc = (int)args.size();
+    benchmark::Initialize(&newArgc, args.data());
+    if (benchmark::ReportUnrecognizedArguments(newArgc, args.data())) return 1;
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
@@ -5,6 +5,15 @@
 #include "Buzzer.h"
 #include "Boss.h"
 #include "HelloWorldScene.h"
+#include "ScenarioRunner.h"
+#include "Profiler.h"
+#include "AllocTracker.h"
+#include "Log.h"
+#include "InputRecorder.h"
+#include "KeyBindingScene.h"
+
+// Ҫ cocos Ĳԣͷģ (Sim*PlayerPhysicsPatrolAIJobSystemInputQueue)
+// Ĳ SimCoreTest.cppǸĿ겻 cocos
 
 // 1. Player ؼ߼
 TEST(PlayerTest, HealthChange) {
@@ -68,3 +77,144 @@ TEST(SceneTest, MapLoadFail) {
     scene->loadMap("maps/not_exist.tmx");
     // д־
 }
+
+// 7. ع飺űأp99 ֡ʱԤ
+TEST(ScenarioTest, BuiltinScenariosWithinFrameBudget) {
+    ScenarioRunner runner;
+    for (const auto& scenario : ScenarioRunner::builtinScenarios()) {
+        ScenarioReport report = runner.run(scenario);
+        EXPECT_GT(report.frames, 0) << scenario.name;
+        EXPECT_TRUE(report.withinBudget()) << scenario.name << " p99=" << report.p99Ms << "ms";
+        // űסʱ p99 ǱĲ
+        EXPECT_TRUE(report.goalReached()) << scenario.name << " completed=" << report.completed
+                                          << " rampage=" << report.reachedRampage;
+    }
+}
+
+// 8. ֶμʱֻڲɼм¼õļ
+TEST(ProfilerTest, RecordsOnlyWhileCapturing) {
+    auto profiler = Profiler::getInstance();
+    { HK_PROFILE_ZONE("test.idle"); }
+    profiler->beginCapture();
+    { HK_PROFILE_ZONE("test.zone"); }
+    EXPECT_EQ(profiler->getEventCount(), 1u);
+    std::string path = profiler->endCapture();
+    EXPECT_FALSE(path.empty());
+    EXPECT_TRUE(cocos2d::FileUtils::getInstance()->isFileExist(path));
+}
+
+// 9. ѷͳ (Ҫ HK_TRACK_ALLOCS )
+#ifdef HK_TRACK_ALLOCS
+TEST(AllocTrackerTest, AttributesToZoneAndCatchesStrictViolations) {
+    AllocTracker::beginFrame();
+    {
+        HK_PROFILE_ZONE("test.allocZone");
+        std::unique_ptr<int> p(new int(1));
+    }
+    AllocTracker::beginFrame();
+    AllocTracker::ZoneStat zones[8];
+    int count = AllocTracker::getLastFrameZones(zones, 8);
+    bool found = false;
+    for (int i = 0; i < count; i++) {
+        if (std::string(zones[i].name) == "test.allocZone") found = true;
+    }
+    EXPECT_TRUE(found);
+
+    AllocTracker::setStrict(true);
+    size_t before = AllocTracker::getViolationCount();
+    {
+        HK_NO_ALLOC_SCOPE("test.noAlloc");
+        int onStack = 42;
+        (void)onStack;
+    }
+    EXPECT_EQ(AllocTracker::getViolationCount(), before);
+
+    // ķ䲻Υ
+    {
+        HK_NO_ALLOC_SCOPE("test.noAlloc");
+        HK_ALLOW_ALLOC_SCOPE("test.allowed");
+        std::unique_ptr<int> p(new int(2));
+    }
+    EXPECT_EQ(AllocTracker::getViolationCount(), before);
+
+    // ֻģʽ
+    AllocTracker::setReportOnly(true);
+    {
+        HK_NO_ALLOC_SCOPE("test.reportOnly");
+        std::unique_ptr<int> p(new int(3));
+    }
+    EXPECT_EQ(AllocTracker::getViolationCount(), before + 1);
+    AllocTracker::setReportOnly(false);
+    AllocTracker::setStrict(false);
+}
+#endif
+
+// 10. ־ӳٸʽ
+TEST(LogTest, FormatsPackedArguments) {
+    LogRecord record = {};
+    record.level = LogLevel::Warn;
+    record.category = LogCat::COMBAT;
+    record.fmt = "hit %s x%d at %.1f (%u%%)";
+
+    memcpy(record.strings, "Boss", 5);
+    record.stringBytes = 5;
+    record.args[0].type = LogRecord::ArgType::STRING; record.args[0].offset = 0;
+    record.args[1].type = LogRecord::ArgType::INT;    record.args[1].i = 3;
+    record.args[2].type = LogRecord::ArgType::DOUBLE; record.args[2].d = 12.5;
+    record.args[3].type = LogRecord::ArgType::UINT;   record.args[3].u = 50;
+    record.argCount = 4;
+
+    std::string line;
+    Log::format(record, line);
+    EXPECT_NE(line.find("[WARN ][Combat] hit Boss x3 at 12.5 (50%)"), std::string::npos);
+}
+
+// 11. ¼
+TEST(ReplayTest, RecordingRoundTrip) {
+    std::vector<InputFrame> frames;
+    for (int i = 0; i < 500; i++) {
+        uint16_t bits = (i / 50) % 2 ? InputBit::MOVE_RIGHT : 0;
+        if (i % 30 < 3) bits |= InputBit::ATTACK;
+        float dt = (i % 7 == 0) ? 0.0171f : 1.0f / 60;
+        frames.push_back({ bits, dt });
+    }
+
+    std::string data;
+    InputRecorder::encodeHeader(data, 0x1234567890ABCDEFull, 1);
+    float lastDt = 0.0f;
+    for (const auto& f : frames) InputRecorder::encodeRun(data, f.bits, f.dt, 1, lastDt);
+
+    InputRecording recording;
+    ASSERT_TRUE(recording.decode(data));
+    EXPECT_EQ(recording.seed, 0x1234567890ABCDEFull);
+    EXPECT_EQ(recording.startLevel, 1);
+    ASSERT_EQ(recording.frames.size(), frames.size());
+    for (size_t i = 0; i < frames.size(); i++) {
+        EXPECT_EQ(recording.frames[i].bits, frames[i].bits);
+        EXPECT_EQ(recording.frames[i].dt, frames[i].dt);
+    }
+
+    // ͬ֡ϲһ
+    std::string compact;
+    lastDt = 0.0f;
+    InputRecorder::encodeRun(compact, InputBit::JUMP, 1.0f / 60, 1000, lastDt);
+    EXPECT_EQ(compact.size(), 8u);
+}
+
+// 12. λỰ
+TEST(KeyBindingTest, SessionScopeIsolatesBindings) {
+    KeyBindingManager session(false);
+    InputQueue queue;
+    {
+        KeyBindingManager::Scope scope(session);
+        ASSERT_EQ(KeyBindingManager::getInstance(), &session);
+        session.setKeyForAction(KeyBindingManager::Action::JUMP, EventKeyboard::KeyCode::KEY_Q);
+        KeyBindingManager::getInstance()->fillKeyTable(queue);
+        EXPECT_EQ(queue.bitsForKey((int)EventKeyboard::KeyCode::KEY_Q), InputBit::JUMP);
+    }
+    EXPECT_NE(KeyBindingManager::getInstance(), &session);
+
+    // ؽʵ汾Ųͬؽ
+    KeyBindingManager::getInstance()->fillKeyTable(queue);
+    EXPECT_EQ(queue.getBindingVersion(), KeyBindingManager::getInstance()->getVersion());
+}
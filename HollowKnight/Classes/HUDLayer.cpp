@@ -1,5 +1,6 @@
 #include "HUDLayer.h"
 #include "config.h" 
+#include "Profiler.h"
 
 USING_NS_CC;
 
@@ -9,14 +10,25 @@ HUDLayer* HUDLayer::createLayer()
     return layer;
 }
 
+HUDLayer::~HUDLayer()
+{
+    CC_SAFE_RELEASE(_heartFullFrame);
+    CC_SAFE_RELEASE(_heartEmptyFrame);
+    CC_SAFE_RELEASE(_soulEmptyFrame);
+    CC_SAFE_RELEASE(_frameStaticFrame);
+}
+
 bool HUDLayer::init()
 {
     if (!Layer::init()) return false;
 
     auto visibleSize = Director::getInstance()->getVisibleSize();
 
-    // 1. 
-    _healthBarContainer = Node::create();
+    // 0. ͼԤ HUD 
+    this->loadHUDAssets();
+
+    // 1.  (ƽڵ㣬 HUD ֻһ draw call)
+    _healthBarContainer = SpriteBatchNode::create(Config::HUD::ATLAS_TEXTURE, Config::HUD::BATCH_CAPACITY);
     _healthBarContainer->setScale(2.5f);
     // λ
     _healthBarContainer->setPosition(Vec2(250.0f, visibleSize.height - 200.0f));
@@ -32,7 +44,7 @@ bool HUDLayer::init()
     // 2.  (Frame) - ʼʾ1֡
     // ============================================================
     std::string startFrame = StringUtils::format(Config::Soul::PATH_FRAME_ANIM.c_str(), 1);
-    _soulFrame = Sprite::create(startFrame);
+    _soulFrame = Sprite::createWithSpriteFrameName(startFrame);
 
     if (_soulFrame)
     {
@@ -43,7 +55,7 @@ bool HUDLayer::init()
     // ============================================================
     // 3. Һ (Orb)
     // ============================================================
-    _soulOrb = Sprite::create(Config::Soul::PATH_EMPTY);
+    _soulOrb = Sprite::createWithSpriteFrame(_soulEmptyFrame);
 
     if (_soulOrb)
     {
@@ -58,33 +70,139 @@ bool HUDLayer::init()
     return true;
 }
 
+void HUDLayer::onEnter()
+{
+    Layer::onEnter();
+
+    // ÿ֡ update ֮ˢ HUD
+    _afterUpdateListener = _eventDispatcher->addCustomEventListener(Director::EVENT_AFTER_UPDATE, [this](EventCustom*) {
+        this->flushDirtyStats();
+        });
+}
+
+void HUDLayer::onExit()
+{
+    if (_afterUpdateListener) {
+        _eventDispatcher->removeEventListener(_afterUpdateListener);
+        _afterUpdateListener = nullptr;
+    }
+
+    Layer::onExit();
+}
+
 // ============================================================
-// ȳٳѪ
+// ǣֻ¼ֱֵ
 // ============================================================
-void HUDLayer::playOpeningSequence()
+void HUDLayer::notifyHealthChanged(int currentHp, int maxHp)
 {
-    if (!_soulFrame) return;
+    _pendingHp = currentHp;
+    _pendingMaxHp = maxHp;
+    _healthDirty = true;
+}
+
+void HUDLayer::notifySoulChanged(int currentSoul)
+{
+    _pendingSoul = currentSoul;
+    _soulDirty = true;
+}
+
+void HUDLayer::flushDirtyStats()
+{
+    if (_healthDirty) {
+        _healthDirty = false;
+        updateHealth(_pendingHp, _pendingMaxHp);
+    }
+    if (_soulDirty) {
+        _soulDirty = false;
+        updateSoul(_pendingSoul);
+    }
+}
+
+// ============================================================
+// Ԥأͼ + ж֮ʱٲļ/
+// ============================================================
+void HUDLayer::loadHUDAssets()
+{
+    HK_PROFILE_ZONE("HUDLayer::loadHUDAssets");
+
+    auto frameCache = SpriteFrameCache::getInstance();
+    frameCache->addSpriteFramesWithFile(Config::HUD::ATLAS_PLIST);
+
+    // 1. ̬֡ (Լ retain һݣֹ汻)
+    _heartFullFrame = frameCache->getSpriteFrameByName(Config::Health::PATH_FULL);
+    _heartEmptyFrame = frameCache->getSpriteFrameByName(Config::Health::PATH_EMPTY);
+    _soulEmptyFrame = frameCache->getSpriteFrameByName(Config::Soul::PATH_EMPTY);
+    _frameStaticFrame = frameCache->getSpriteFrameByName(Config::Soul::PATH_FRAME_STATIC);
+    CC_SAFE_RETAIN(_heartFullFrame);
+    CC_SAFE_RETAIN(_heartEmptyFrame);
+    CC_SAFE_RETAIN(_soulEmptyFrame);
+    CC_SAFE_RETAIN(_frameStaticFrame);
+
+    // 2.  / Ѫ / Ѫ
+    auto frameGrow = buildAnimation(Config::Soul::PATH_FRAME_ANIM, Config::Soul::FRAMES_FRAME_COUNT, Config::HUD::FRAME_GROW_SPEED);
+    if (frameGrow) {
+        frameGrow->setRestoreOriginalFrame(false); // ԭͣһ֡
+        _animations.insert("frame_grow", frameGrow);
+    }
+
+    auto appear = buildAnimation(Config::Health::PATH_APPEAR, Config::Health::FRAMES_APPEAR, Config::HUD::HEALTH_ANIM_SPEED);
+    if (appear) {
+        appear->setRestoreOriginalFrame(false);
+        _animations.insert("health_appear", appear);
+    }
+
+    auto breakAnim = buildAnimation(Config::Health::PATH_BREAK, Config::Health::FRAMES_BREAK, Config::HUD::HEALTH_ANIM_SPEED);
+    if (breakAnim) {
+        _animations.insert("health_break", breakAnim);
+    }
+
+    // 3. ƿ 1~4 ѭлʱֱӸ
+    for (int soul = 1; soul <= 4; soul++)
+    {
+        Action* action = createSoulAction(soul);
+        if (!action) {
+            CCLOG("HUD: soul action %d missing, atlas not loaded?", soul);
+            action = RepeatForever::create(DelayTime::create(1.0f)); // ռλ֤±
+        }
+        _soulActions.pushBack(action);
+    }
+}
+
+Animation* HUDLayer::buildAnimation(const std::string& format, int count, float delay)
+{
+    HK_PROFILE_ZONE("HUDLayer::buildAnimation");
+
+    auto frameCache = SpriteFrameCache::getInstance();
 
-    // 1. ׼ (Frame 1 -> 6)
     Vector<SpriteFrame*> frames;
-    for (int i = 1; i <= Config::Soul::FRAMES_FRAME_COUNT; i++)
+    for (int i = 1; i <= count; i++)
     {
-        std::string name = StringUtils::format(Config::Soul::PATH_FRAME_ANIM.c_str(), i);
-        auto sprite = Sprite::create(name);
-        if (sprite) frames.pushBack(sprite->getSpriteFrame());
+        std::string name = StringUtils::format(format.c_str(), i);
+        auto frame = frameCache->getSpriteFrameByName(name);
+        if (frame) frames.pushBack(frame);
     }
 
-    if (frames.empty()) return;
+    if (frames.empty()) return nullptr;
+
+    return Animation::createWithSpriteFrames(frames, delay);
+}
+
+// ============================================================
+// ȳٳѪ
+// ============================================================
+void HUDLayer::playOpeningSequence()
+{
+    if (!_soulFrame) return;
 
-    // ٶ
-    auto animation = Animation::createWithSpriteFrames(frames, 0.1f);
-    animation->setRestoreOriginalFrame(false); // ԭͣһ֡
+    // 1.  (Frame 1 -> 6)
+    auto animation = _animations.at("frame_grow");
+    if (!animation) return;
     auto animate = Animate::create(animation);
 
     // 2. ص
     auto finishCallback = CallFunc::create([this]() {
         // ǿƻɾ̬ͼ (ڵ6)
-        this->_soulFrame->setTexture(Config::Soul::PATH_FRAME_STATIC);
+        if (_frameStaticFrame) this->_soulFrame->setSpriteFrame(_frameStaticFrame);
 
         // ʼѪ (ӵ0ʼܹ5)
         //  5 Ǵ Player  MaxHP
@@ -103,14 +221,21 @@ void HUDLayer::spawnNextHealth(int index, int maxHp)
     // ֹ
     if (index >= maxHp) {
         // ȫϺǿˢһ UIȷ״̬ȷ
-        // ҪȡǵǰʵѪûдȫΪ
-        this->updateHealth(maxHp, maxHp);
+        // ڼյѪ֪ͨʵѪȫΪ
+        if (_pendingMaxHp == maxHp) {
+            this->updateHealth(_pendingHp, _pendingMaxHp);
+        }
+        else {
+            this->updateHealth(maxHp, maxHp);
+        }
         return;
     }
 
+    auto animation = _animations.at("health_appear");
+    if (!animation) return;
+
     // 1. Ѫ Sprite (ʼ appear_1)
-    std::string startImg = StringUtils::format(Config::Health::PATH_APPEAR.c_str(), 1);
-    auto heart = Sprite::create(startImg);
+    auto heart = Sprite::createWithSpriteFrame(animation->getFrames().front()->getSpriteFrame());
     if (!heart) return;
 
     // 2. λ ( updateHealth ߼һ)
@@ -120,26 +245,23 @@ void HUDLayer::spawnNextHealth(int index, int maxHp)
     _healthBarContainer->addChild(heart, 10);
     _heartSprites.push_back(heart);
 
-    // 3. ׼ Appear  (1 -> 5)
-    Vector<SpriteFrame*> frames;
-    for (int i = 1; i <= Config::Health::FRAMES_APPEAR; i++)
-    {
-        std::string name = StringUtils::format(Config::Health::PATH_APPEAR.c_str(), i);
-        auto sprite = Sprite::create(name);
-        if (sprite) frames.pushBack(sprite->getSpriteFrame());
+    // ͬʱ׼һЧ (Z 20ڿѪ)
+    auto breakEffect = Sprite::createWithSpriteFrame(_heartEmptyFrame);
+    breakEffect->setPosition(heart->getPosition());
+    breakEffect->setVisible(false);
+    _healthBarContainer->addChild(breakEffect, 20);
+    _breakSprites.push_back(breakEffect);
+    if (auto breakAnim = _animations.at("health_break")) {
+        _breakActions.pushBack(Sequence::create(Animate::create(breakAnim), Hide::create(), nullptr));
     }
 
-    // 
-    if (frames.empty()) return;
-
-    auto animation = Animation::createWithSpriteFrames(frames, 0.06f);
-    animation->setRestoreOriginalFrame(false);
+    // 3. Appear  (1 -> 5)
     auto animate = Animate::create(animation);
 
     // 4. صǰ꣬һ
     auto finishCallback = CallFunc::create([this, index, maxHp, heart]() {
         // 󻻳ɾ̬ Full ͼ
-        heart->setTexture(Config::Health::PATH_FULL);
+        heart->setSpriteFrame(_heartFullFrame);
 
         // ݹ顿һ
         this->spawnNextHealth(index + 1, maxHp);
@@ -153,6 +275,11 @@ void HUDLayer::updateHealth(int currentHp, int maxHp)
 {
     if (_heartSprites.size() != maxHp) return;
 
+    // ϴȾĽһʲô
+    if (currentHp == _lastHp && maxHp == _lastMaxHp) return;
+    _lastHp = currentHp;
+    _lastMaxHp = maxHp;
+
     // --------------------------------------------------------
     // B. ״̬
     // --------------------------------------------------------
@@ -167,7 +294,7 @@ void HUDLayer::updateHealth(int currentHp, int maxHp)
             // ֮ǰѪǵһˢ
             if (currentTag != 1)
             {
-                heart->setTexture(Config::Health::PATH_FULL);
+                heart->setSpriteFrame(_heartFullFrame);
                 heart->setOpacity(255);
                 heart->setTag(1); // ΪѪ
             }
@@ -180,10 +307,10 @@ void HUDLayer::updateHealth(int currentHp, int maxHp)
             if (currentTag == 1)
             {
                 // 1. 鶯 ()
-                playBreakAnimation(heart);
+                playBreakAnimation(i);
 
                 // 2. лΪѪ (Ϊ)
-                heart->setTexture(Config::Health::PATH_EMPTY);
+                heart->setSpriteFrame(_heartEmptyFrame);
 
                 // 3. ΪѪ
                 heart->setTag(0);
@@ -193,44 +320,19 @@ void HUDLayer::updateHealth(int currentHp, int maxHp)
     }
 }
 
-void HUDLayer::playBreakAnimation(Sprite* heartSprite)
+void HUDLayer::playBreakAnimation(int index)
 {
-    // 1. ض֡
-    Vector<SpriteFrame*> frames;
-    for (int i = 1; i <= 6; i++)
-    {
-        std::string name = StringUtils::format(Config::Health::PATH_BREAK.c_str() , i);
-        auto sprite = Sprite::create(name);
-        if (sprite) {
-            frames.pushBack(sprite->getSpriteFrame());
-        }
-    }
-
-    if (frames.empty()) return;
-
-    // 2.  (ٶȿһ㣬0.04һ֡)
-    auto animation = Animation::createWithSpriteFrames(frames, 0.06f);
-    auto animate = Animate::create(animation);
-
-    // 3. ʱ Sprite
-    // ΪͼƬߴһֱӶ꼴ɣƫ
-    auto effectSprite = Sprite::create();
-    effectSprite->setPosition(heartSprite->getPosition());
-
-    // ZΪ 20֤ڿѪ
-    _healthBarContainer->addChild(effectSprite, 20);
-
-    // 4. Ų
-    auto seq = Sequence::create(
-        animate,
-        RemoveSelf::create(),
-        nullptr
-    );
+    if (index < 0 || index >= _breakSprites.size() || index >= _breakActions.size()) return;
 
-    effectSprite->runAction(seq);
+    // һԤȽõЧͶ (أ´)
+    auto effectSprite = _breakSprites[index];
+    effectSprite->stopAllActions();
+    effectSprite->setVisible(true);
+    effectSprite->runAction(_breakActions.at(index));
 }
 
 // ĺƿ " -> ȴ -> ѭ" Ķ
+// ֻ loadHUDAssets һΣ _soulActions
 Action* HUDLayer::createSoulAction(int soulValue)
 {
     std::string pathFormat;
@@ -259,20 +361,9 @@ Action* HUDLayer::createSoulAction(int soulValue)
         return nullptr;
     }
 
-    // ض֡
-    Vector<SpriteFrame*> frames;
-    for (int i = 1; i <= frameCount; i++)
-    {
-        std::string name = StringUtils::format(pathFormat.c_str(), i);
-        auto sprite = Sprite::create(name);
-        if (sprite) {
-            frames.pushBack(sprite->getSpriteFrame());
-        }
-    }
-
-    if (frames.empty()) return nullptr;
+    auto animation = buildAnimation(pathFormat, frameCount, Config::Soul::FRAME_SPEED);
+    if (!animation) return nullptr;
 
-    auto animation = Animation::createWithSpriteFrames(frames, Config::Soul::FRAME_SPEED);
     auto animate = Animate::create(animation);
 
     // ߼(4)Ҫȴ״̬(1,2,3)ѭ
@@ -311,19 +402,14 @@ void HUDLayer::updateSoul(int currentSoul)
     if (safeSoul == 0)
     {
         // ƿʾֹͼ
-        _soulOrb->setTexture(Config::Soul::PATH_EMPTY);
+        _soulOrb->setSpriteFrame(_soulEmptyFrame);
 
         // ȷ͸ (ֹ֮ǰĳЩ͸)
         _soulOrb->setOpacity(255);
     }
     else
     {
-        // л꣺Ŷ
-        Action* action = createSoulAction(currentSoul);
-        if (action)
-        {
-            _soulOrb->runAction(action);
-        }
-
+        // л꣺ֱӸԤõѭ
+        _soulOrb->runAction(_soulActions.at(safeSoul - 1));
     }
-}
\ No newline at end of file
+}
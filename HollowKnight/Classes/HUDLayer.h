@@ -9,6 +9,17 @@ class HUDLayer : public cocos2d::Layer
 public:
     static HUDLayer* createLayer(); // Զ崴
     virtual bool init() override;
+    virtual void onEnter() override;
+    virtual void onExit() override;
+    virtual ~HUDLayer();
+
+    // ==========================================
+    // ۲߽ӿڣֵ仯ʱֻ¼
+    // ÿ֡߼½ (EVENT_AFTER_UPDATE) ͳһˢһ
+    // ͬһ֡ڶα仯ֻˢĽ
+    // ==========================================
+    void notifyHealthChanged(int currentHp, int maxHp);
+    void notifySoulChanged(int currentSoul);
 
     // ĽӿڣѪʾ
     // currentHp: ǰѪ, maxHp: Ѫ
@@ -20,13 +31,30 @@ public:
     CREATE_FUNC(HUDLayer);
 
 private:
+    // ˢ
+    void flushDirtyStats();
+
+    cocos2d::EventListenerCustom* _afterUpdateListener = nullptr;
+    bool _healthDirty = false;
+    bool _soulDirty = false;
+    int _pendingHp = -1;
+    int _pendingMaxHp = -1;
+    int _pendingSoul = 0;
+
+    // һȾ״̬ (Ƚϣû仯Ͳ)
+    int _lastHp = -1;
+    int _lastMaxHp = -1;
 	int _lastSoul = -1; // ¼һεֵظ
     // 洢еѪͼ꾫
     std::vector<cocos2d::Sprite*> _heartSprites;
-
+    // ÿѪӦһЧ (ƽʱأѪʱ)
+    std::vector<cocos2d::Sprite*> _breakSprites;
+    // ÿ鶯 ( + );һ𽨺ãѪʱֱӸ
+    cocos2d::Vector<cocos2d::Action*> _breakActions;
 
     // UI ڵ (ƶ)
-    cocos2d::Node* _healthBarContainer;
+    //  HUD 鶼ͬһͼ SpriteBatchNode һλ
+    cocos2d::SpriteBatchNode* _healthBarContainer;
 
     // ==========================================
     // ޸ġΪ
@@ -34,8 +62,22 @@ private:
     cocos2d::Sprite* _soulOrb;   // ²㣺Һ (𶯻)
     cocos2d::Sprite* _soulFrame; // ϲ㣺 (ֹ)
 
+    // ==========================================
+    // ԤԴinit ʱһԽãֻ֮л֡/
+    // ==========================================
+    void loadHUDAssets();
+    cocos2d::Animation* buildAnimation(const std::string& format, int count, float delay);
+
+    cocos2d::Map<std::string, cocos2d::Animation*> _animations;
+    cocos2d::Vector<cocos2d::Action*> _soulActions; // ± 0~3 Ӧֵ 1~4
+
+    cocos2d::SpriteFrame* _heartFullFrame = nullptr;
+    cocos2d::SpriteFrame* _heartEmptyFrame = nullptr;
+    cocos2d::SpriteFrame* _soulEmptyFrame = nullptr;
+    cocos2d::SpriteFrame* _frameStaticFrame = nullptr;
+
     // 鶯
-    void playBreakAnimation(cocos2d::Sprite* heartSprite);
+    void playBreakAnimation(int index);
 
     // ֵ "+ȴ" ѭ
     cocos2d::Action* createSoulAction(int soulValue);
@@ -47,4 +89,4 @@ private:
     void spawnNextHealth(int index, int maxHp); // ݹѪ
 };
 
-#endif // __HUD_LAYER_H__
\ No newline at end of file
+#endif // __HUD_LAYER_H__
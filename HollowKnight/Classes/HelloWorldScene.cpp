@@ -1,5 +1,6 @@
 ﻿#include "HelloWorldScene.h"
-#include "SimpleAudioEngine.h"
+#include "AudioManager.h"
+#include "MusicPlayer.h"
 #include "Enemy.h"
 #include "Zombie.h"
 #include "Spike.h"
@@ -14,9 +15,24 @@
 #include "FKFireball.h" 
 #include "FKShockwave.h"
 #include "DreamDialogue.h"
+#include "FrameRateManager.h"
+#include "Profiler.h"
+#include "AllocTracker.h"
+#include "PerfOverlayLayer.h"
+#include "Log.h"
+#include "SimRandom.h"
+#include "InputRecorder.h"
+#include "JobSystem.h"
+#include "AssetPreloader.h"
+#include "TextureResidency.h"
 
 USING_NS_CC;
 
+namespace {
+    // Level 1 的怪物：Enemy / Zombie / Spike / Buzzer x2
+    const int LEVEL1_ENTITY_TAGS[] = { 999, 998, 997, 996, 995 };
+}
+
 Scene* HelloWorld::createScene()
 {
     return HelloWorld::create();
@@ -66,13 +82,24 @@ bool HelloWorld::init()
     _isGamePaused = false;
     _pauseLayer = nullptr;
 
-    PlayerAnimator::preloadSounds();
+    // 怪物决策和 Boss 弹幕的并行更新：按线程数准备命令通道，预留容量 (update 里不再分配)
+    _sceneCommands.resize(JobSystem::getInstance()->getThreadCount(), SimSnapshot::MAX_PROJECTILES);
+    _projectileWork.reserve(SimSnapshot::MAX_PROJECTILES);
+    _aiWork.reserve(SimSnapshot::MAX_ENTITIES);
+
+    // 会话种子：回放/回归测试时预设，正常游戏随机生成并写进录像
+    uint64_t sessionSeed = SimRandom::takeSessionSeed();
+    SimRandom::seedAll(sessionSeed);
+    InputRecorder::getInstance()->beginSession(this,
+        FileUtils::getInstance()->getWritablePath() + Config::Replay::FILE_NAME, sessionSeed, _currentLevel);
 
-    // 播放背景音乐 (使用 Config)
-    auto audio = CocosDenshion::SimpleAudioEngine::getInstance();
-    audio->playBackgroundMusic(Config::Audio::BGM_DIRTMOUTH, true);
-    audio->setBackgroundMusicVolume(0.5f);
-    audio->setEffectsVolume(0.8f);
+    // 第一关的音效和音乐 (启动预加载已经读过的直接跳过；场景测试/回放不经过 PreloadScene)
+    AudioManager::getInstance()->preloadLevel(_currentLevel);
+    DreamDialogue::preloadAssets(); // 梦语气泡：预建动画 + 预热字形
+
+    // 播放背景音乐 (从键位配置界面进来，淡入)
+    MusicPlayer::getInstance()->play(AudioManager::getLevelMusic(_currentLevel));
+    AudioManager::getInstance()->setVolume(0.8f);
 
     auto visibleSize = Director::getInstance()->getVisibleSize();
     Vec2 origin = Director::getInstance()->getVisibleOrigin();
@@ -105,116 +132,21 @@ bool HelloWorld::init()
     // 4. 在 init 中创建 Level 1 特有的敌人
     //////////////////////////////////////////////////////////////////////
 
-    // --- 创建 Enemy ---
-    auto enemy = Enemy::create("enemies/enemy_walk_1.png");
-    if (enemy)
-    {
-        enemy->setPosition(Vec2(600, 430));
-        enemy->setPatrolRange(500, 800);
-        enemy->setTag(999);
-        _gameLayer->addChild(enemy, 5);
-
-        // 死亡回调 (回魂 + 音效)
-        enemy->setOnDeathCallback([=]() {
-            if (_player) {
-                _player->gainSoulOnKill();
-                CCLOG("Soul gained from Enemy!");
-            }
-            // SimpleAudioEngine::getInstance()->playEffect("audio/enemy_death.wav");
-            });
-
-        CCLOG("Enemy spawned!");
-    }
-
-    // --- 创建 Zombie 敌人 ---
-    auto zombie = Zombie::create("zombie/walk/walk_1.png");
-    if (zombie)
-    {
-        zombie->setPosition(Vec2(1200, 430));
-        zombie->setPatrolRange(1000, 1400);
-        zombie->setTag(998);
-        _gameLayer->addChild(zombie, 5);
-
-        // 死亡回调
-        zombie->setOnDeathCallback([=]() {
-            if (_player) {
-                // 兼容不同写法，这里假设 Player 有 gainSoulOnKill
-                _player->gainSoulOnKill();
-                CCLOG("Soul gained from Zombie!");
-            }
-            // SimpleAudioEngine::getInstance()->playEffect("audio/enemy_death.wav");
-            });
-
-        CCLOG("Zombie spawned at position (1200, 430)!");
-    }
-
-    // --- 创建 Spike 陷阱 ---
-    auto textureCache = Director::getInstance()->getTextureCache();
-    auto spikeTexture = textureCache->addImage("traps/spike.png");
-    Spike* spike = nullptr;
-
-    if (spikeTexture) {
-        spike = Spike::create("traps/spike.png");
-    }
-    else {
-        spike = Spike::create("enemies/enemy_walk_1.png"); // Fallback
-    }
-
-    if (spike)
+    for (int tag : LEVEL1_ENTITY_TAGS)
     {
-        Vec2 spikePos = Vec2(3590.0f, 1000.0f);
-        spike->setInitialPosition(spikePos);
-        spike->setTag(997);
-        spike->setAnchorPoint(Vec2(0.5f, 0.5f));
-        spike->setVisible(true);
-        spike->setOpacity(255);
-        spike->setScale(1.0f);
-        spike->setBlendFunc(BlendFunc::ALPHA_PREMULTIPLIED);
-        _gameLayer->addChild(spike, 5);
-    }
-
-    // --- 创建 Buzzer 飞行敌人 ---
-    auto buzzer1 = Buzzer::create("buzzer/idle/idle_1.png");
-    if (buzzer1)
-    {
-        Vec2 buzzer1Pos = Vec2(4000.0f, 900.0f);
-        buzzer1->setInitialPosition(buzzer1Pos);
-        buzzer1->setTag(996);
-        _gameLayer->addChild(buzzer1, 5);
-
-        buzzer1->setOnDeathCallback([=]() {
-            if (_player) {
-                _player->gainSoulOnKill(); // 调用主角加魂
-                CCLOG("Soul gained from Buzzer 1!");
-            }
-            });
-    }
-
-    auto buzzer2 = Buzzer::create("buzzer/idle/idle_1.png");
-    if (buzzer2)
-    {
-        Vec2 buzzer2Pos = Vec2(6000.0f, 700.0f);
-        buzzer2->setInitialPosition(buzzer2Pos);
-        buzzer2->setTag(995);
-        _gameLayer->addChild(buzzer2, 5);
-
-        buzzer2->setOnDeathCallback([=]() {
-            if (_player) {
-                _player->gainSoulOnKill(); // 调用主角加魂
-                CCLOG("Soul gained from Buzzer 2!");
-            }
-            });
+        spawnEntity(tag);
     }
 
     //////////////////////////////////////////////////////////////////////
     // 5. 创建主角 (Player)
     //////////////////////////////////////////////////////////////////////
-    _player = Player::create("Knight/idle/idle_1.png");
+    _player = Player::create("knight/idle/idle_1.png");
 
     if (_player)
     {
         _player->setPosition(Vec2(450, 1300));  
         _gameLayer->addChild(_player, 10);
+        _player->setInputQueue(&_inputQueue);
         CCLOG("Player created successfully!");
     }
     else
@@ -230,137 +162,88 @@ bool HelloWorld::init()
     this->addChild(hudLayer, 100);
 
     if (_player) {
-        // 血量监听
+        // 血量监听 (只打脏标记，帧末统一刷新)
         _player->setOnHealthChanged([=](int hp, int maxHp) {
-            hudLayer->updateHealth(hp, maxHp);
+            hudLayer->notifyHealthChanged(hp, maxHp);
             });
 
         // 魂量监听 
         _player->setOnSoulChanged([=](int soul) {
-            hudLayer->updateSoul(soul);
+            hudLayer->notifySoulChanged(soul);
             });
 
         // 初始化 UI
-        hudLayer->updateHealth(_player->getHealth(), _player->getMaxHealth());
+        hudLayer->notifyHealthChanged(_player->getHealth(), _player->getMaxHealth());
     }
 
+    // 性能面板 (默认隐藏，放在暂停层之上，暂停时也能看)
+    auto perfOverlay = PerfOverlayLayer::create();
+    perfOverlay->setTag(901);
+    this->addChild(perfOverlay, 400);
+    perfOverlay->setCounterProvider([this](PerfCounters& counters) {
+        if (!_gameLayer) return;
+        counters.entities = (int)_gameLayer->getChildrenCount();
+        for (auto child : _gameLayer->getChildren())
+        {
+            if (dynamic_cast<GameEntity*>(child) && !dynamic_cast<Jar*>(child)) counters.enemies++;
+            else if (dynamic_cast<Boss*>(child)) counters.enemies++;
+            else if (dynamic_cast<Fireball*>(child) || dynamic_cast<FKFireball*>(child) || dynamic_cast<FKShockwave*>(child)) counters.projectiles++;
+        }
+        });
+
     //////////////////////////////////////////////////////////////////////
     // 7. 键盘监听器
     //////////////////////////////////////////////////////////////////////
+    refreshKeyTable();
     auto listener = EventListenerKeyboard::create();
-    // 【重要】不要在这里捕获 kbm，而是在每次回调中动态获取
 
     // --- 按下按键 ---
     listener->onKeyPressed = [=](EventKeyboard::KeyCode code, Event* event) {
         if (_player == nullptr) return;
 
-        // 【修复】每次都重新获取 KeyBindingManager 实例，确保使用最新的键位配置
-        auto kbm = KeyBindingManager::getInstance();
-
-        // ============================================================
-        // 使用配置的 PAUSE 键来暂停
-        // ============================================================
-        if (code == kbm->getKeyForAction(KeyBindingManager::Action::PAUSE))
+#if HK_PROFILER_ENABLED
+        // 性能采集开关 (导出 Chrome trace)，暂停时也能用
+        if (code == Config::Profiler::CAPTURE_KEY)
         {
-            auto pauseScene = KeyBindingScene::create();
-            if (pauseScene)
-            {
-                pauseScene->setPauseMode(true);
-                Director::getInstance()->pushScene(pauseScene);
-                return;
-            }
-        }
-
-        // 使用键位管理器检查按键
-        if (code == kbm->getKeyForAction(KeyBindingManager::Action::MOVE_RIGHT))
-        {
-            _isRightPressed = true;
-            updatePlayerMovement();
-        }
-        else if (code == kbm->getKeyForAction(KeyBindingManager::Action::MOVE_LEFT))
-        {
-            _isLeftPressed = true;
-            updatePlayerMovement();
-        }
-        else if (code == kbm->getKeyForAction(KeyBindingManager::Action::MOVE_UP))
-        {
-            _isUpPressed = true;
-            updatePlayerMovement();
-        }
-        else if (code == kbm->getKeyForAction(KeyBindingManager::Action::MOVE_DOWN))
-        {
-            _isDownPressed = true;
-            updatePlayerMovement();
-        }
-        else if (code == kbm->getKeyForAction(KeyBindingManager::Action::JUMP))
-        {
-            _player->setJumpPressed(true);
-        }
-        else if (code == kbm->getKeyForAction(KeyBindingManager::Action::ATTACK))
-        {
-            _player->setAttackPressed(true);
+            Profiler::getInstance()->toggleCapture();
+            return;
         }
-        else if (code == kbm->getKeyForAction(KeyBindingManager::Action::FOCUS))
+#endif
+        if (code == Config::PerfOverlay::TOGGLE_KEY)
         {
-            _player->setFocusInput(true);
+            if (auto overlay = dynamic_cast<PerfOverlayLayer*>(getChildByTag(901))) overlay->toggle();
+            return;
         }
-        else if (code == kbm->getKeyForAction(KeyBindingManager::Action::CAST_SPELL))
+
+        if (_isGamePaused) return; // 暂停时按键交给暂停层处理
+
+        // 键位表是平铺数组，查一次下标；键位改过 (暂停菜单里改键) 会先重建
+        refreshKeyTable();
+        uint16_t bits = _inputQueue.bitsForKey((int)code);
+
+        // 使用配置的 PAUSE 键来暂停
+        if (bits & InputQueue::PAUSE_BIT)
         {
-            _player->setCastInput(true);
+            showPauseMenu();
+            return;
         }
-        else if (code == kbm->getKeyForAction(KeyBindingManager::Action::DREAM_NAIL))
+
+        // 玩法按键：带时间戳进队列，下一步模拟开始时按顺序生效 (同一份输入位也用于录像)
+        if (bits)
         {
-            _player->setDreamNailInput(true);
+            _inputQueue.push(bits, true, _simTime);
         }
         };
 
     // --- 松开按键 ---
     listener->onKeyReleased = [=](EventKeyboard::KeyCode code, Event* event) {
         if (_player == nullptr) return;
+        if (_isGamePaused) return;
 
-        // 【修复】每次都重新获取 KeyBindingManager 实例
-        auto kbm = KeyBindingManager::getInstance();
-
-        // 使用键位管理器检查按键
-        if (code == kbm->getKeyForAction(KeyBindingManager::Action::FOCUS))
-        {
-            _player->setFocusInput(false);
-        }
-        else if (code == kbm->getKeyForAction(KeyBindingManager::Action::MOVE_LEFT))
-        {
-            _isLeftPressed = false;
-            updatePlayerMovement();
-        }
-        else if (code == kbm->getKeyForAction(KeyBindingManager::Action::MOVE_RIGHT))
-        {
-            _isRightPressed = false;
-            updatePlayerMovement();
-        }
-        else if (code == kbm->getKeyForAction(KeyBindingManager::Action::MOVE_UP))
-        {
-            _isUpPressed = false;
-            updatePlayerMovement();
-        }
-        else if (code == kbm->getKeyForAction(KeyBindingManager::Action::MOVE_DOWN))
-        {
-            _isDownPressed = false;
-            updatePlayerMovement();
-        }
-        else if (code == kbm->getKeyForAction(KeyBindingManager::Action::JUMP))
-        {
-            _player->setJumpPressed(false);
-        }
-        else if (code == kbm->getKeyForAction(KeyBindingManager::Action::ATTACK))
+        refreshKeyTable();
+        if (uint16_t bits = _inputQueue.bitsForKey((int)code))
         {
-            _player->setAttackPressed(false);
-        }
-        else if (code == kbm->getKeyForAction(KeyBindingManager::Action::CAST_SPELL))
-        {
-            _player->setCastInput(false);
-        }
-        else if (code == kbm->getKeyForAction(KeyBindingManager::Action::DREAM_NAIL))
-        {
-            _player->setDreamNailInput(false);
+            _inputQueue.push(bits, false, _simTime);
         }
         };
 
@@ -427,24 +310,71 @@ void HelloWorld::updatePlayerMovement()
     _player->setInputDirectionY(dirY);
 }
 
+void HelloWorld::refreshKeyTable()
+{
+    // 键位没变就什么都不做 (每个按键事件只多一次整数比较)
+    KeyBindingManager::getInstance()->fillKeyTable(_inputQueue);
+}
+
+void HelloWorld::setInputBits(uint16_t bits)
+{
+    uint16_t changed = bits ^ _inputBits;
+    _inputBits = bits;
+    if (!changed || !_player) return;
+
+    const uint16_t moveBits = InputBit::MOVE_LEFT | InputBit::MOVE_RIGHT | InputBit::MOVE_UP | InputBit::MOVE_DOWN;
+    if (changed & moveBits) {
+        _isLeftPressed = (bits & InputBit::MOVE_LEFT) != 0;
+        _isRightPressed = (bits & InputBit::MOVE_RIGHT) != 0;
+        _isUpPressed = (bits & InputBit::MOVE_UP) != 0;
+        _isDownPressed = (bits & InputBit::MOVE_DOWN) != 0;
+        updatePlayerMovement();
+    }
+    if (changed & InputBit::JUMP) _player->setJumpPressed((bits & InputBit::JUMP) != 0);
+    if (changed & InputBit::ATTACK) _player->setAttackPressed((bits & InputBit::ATTACK) != 0);
+    if (changed & InputBit::FOCUS) _player->setFocusInput((bits & InputBit::FOCUS) != 0);
+    if (changed & InputBit::CAST_SPELL) _player->setCastInput((bits & InputBit::CAST_SPELL) != 0);
+    if (changed & InputBit::DREAM_NAIL) _player->setDreamNailInput((bits & InputBit::DREAM_NAIL) != 0);
+}
+
 // 每帧更新：实现相机跟随、碰撞检测、关卡切换
 void HelloWorld::update(float dt)
 {
+    // 暂停时整个模拟停住，只显示定格画面 + 暂停菜单
+    if (_isGamePaused) return;
+
+    // 取出两步之间到达的按键事件 (按时间顺序)，得到这一步的有效输入 (含输入缓冲)
+    // 事件按到达时的模拟时间打戳，缓冲按模拟时间过期
+    // 录像回放/场景脚本直接设输入位，不往队列里放事件，这里不会覆盖它们
+    _simTime += dt;
+    uint16_t liveBits = 0;
+    if (_inputQueue.beginStep(_simTime, liveBits)) setInputBits(liveBits);
+
+    // 录像：记下这一步的有效输入和 dt
+    InputRecorder::getInstance()->recordStep(this, _inputBits, dt);
+    _simFrame++;
+
     if (!_player || !_gameLayer) return;
 
     auto map = _gameLayer->getChildByTag(123);
     if (!map) return;
 
+    HK_PROFILE_FRAME();
+    HK_ALLOC_FRAME();
+    HK_PROFILE_ZONE("HelloWorld::update");
+    HK_PROFILE_SECTIONS(sections);
+
     // ========================================
     // 0. 检测玩家位置，触发场景切换 (Level 1 -> 2)
     // ========================================
+    HK_PROFILE_NEXT(sections, "update.0_levelSwitch");
  // Level 1 -> Level 2
     if (_currentLevel == 1 && !_isTransitioning)
     {
         Vec2 playerPos = _player->getPosition();
         if (playerPos.x >= 6500.0f)
         {
-            CCLOG("Player reached level1 end! Triggering level switch...");
+            HK_LOG_INFO(LEVEL, "Player reached level1 end! Triggering level switch...");
             switchToLevel2();
             return;
         }
@@ -455,13 +385,13 @@ void HelloWorld::update(float dt)
         Vec2 playerPos = _player->getPosition();
         if (playerPos.x <= 100.0f)
         {
-            CCLOG("Player reached level2 left! Triggering level 1 switch...");
+            HK_LOG_INFO(LEVEL, "Player reached level2 left! Triggering level 1 switch...");
             switchToLevel1();
             return;
         }
         if (playerPos.x >= 6325.0f)
         {
-            CCLOG("Player reached level2 end! Triggering level 3 switch...");
+            HK_LOG_INFO(LEVEL, "Player reached level2 end! Triggering level 3 switch...");
             switchToLevel3();
             return;
         }
@@ -472,49 +402,73 @@ void HelloWorld::update(float dt)
         Vec2 playerPos = _player->getPosition();
         if (playerPos.x <= 100.0f)
         {
-            CCLOG("Player reached level3 left! Triggering level 2 switch...");
+            HK_LOG_INFO(LEVEL, "Player reached level3 left! Triggering level 2 switch...");
             switchToLevel2FromRight();
             return;
         }
     }
 
 
+    // 检查点：进关后 (黑屏结束) 的第一帧存一份；上一帧死了就恢复到这里
+    if (!_isTransitioning)
+    {
+        if (_pendingRespawn)
+        {
+            _pendingRespawn = false;
+            if (_checkpointLevel != _currentLevel || !restoreSnapshot(_checkpoint)) {
+                respawnAtLevelStart();
+            }
+        }
+        if (_checkpointLevel != _currentLevel)
+        {
+            captureSnapshot(_checkpoint);
+            _checkpointLevel = _currentLevel;
+        }
+    }
+
+    // 主角动画片段的后台加载 (会分配内存)
+    _player->pumpAnimationLoads();
+
     // ========================================
     // 1. 更新玩家位置 (包含 Jar 平台逻辑)
     // ========================================
+    HK_PROFILE_NEXT(sections, "update.1_player");
+
+    // 从这里到 update 结束是每帧的稳定步 (主角/怪物/弹幕推进 + 碰撞)，严格模式 (HK_ALLOC_STRICT) 下不许分配
+    // 切动画、命中、生成物体这些确实要分配的地方，各自用 HK_ALLOW_ALLOC_SCOPE 标了名字
+    HK_NO_ALLOC_SCOPE("HelloWorld::update.step");
+
+   // 先清理失效/已碎的罐子 (移除节点引用)
+   for (int i = _jars.size() - 1; i >= 0; i--)
+   {
+       auto jar = _jars.at(i);
+       if (!jar || jar->getReferenceCount() == 0 || jar->isDestroyed()) {
+           _jars.erase(i);
+       }
+   }
+
    if (_jars.empty())
    {
        _player->update(dt, _groundRects); // ⚡️ 零拷贝，极速！
    }
    else
    {
-       // 只有 Level 2 有罐子时，才不得不复制一份
-       std::vector<Rect> dynamicGroundRects = _groundRects;
-
-       // 倒序遍历清理坏罐子
-       for (int i = _jars.size() - 1; i >= 0; i--)
+       // 只有 Level 2 有罐子时，才需要地面 + 罐子顶部；复用成员缓冲，容量在 loadMap 里预留好
+       _dynamicGroundRects.assign(_groundRects.begin(), _groundRects.end());
+       for (auto jar : _jars)
        {
-           auto jar = _jars.at(i);
-
-           // 检查指针有效性
-           if (!jar || jar->getReferenceCount() == 0) {
-               _jars.erase(i); continue;
-           }
-           if (jar->isDestroyed()) {
-               _jars.erase(i); continue;
-           }
-
            // 添加罐子顶部平台
            Rect topPlatform = jar->getTopPlatformBox();
            if (!topPlatform.equals(Rect::ZERO)) {
-               dynamicGroundRects.push_back(topPlatform);
+               _dynamicGroundRects.push_back(topPlatform);
            }
        }
-       _player->update(dt, dynamicGroundRects);
+       _player->update(dt, _dynamicGroundRects);
    }
     // ========================================
     // 2. 获取玩家位置并更新坐标显示
     // ========================================
+    HK_PROFILE_NEXT(sections, "update.2_coords");
    Vec2 playerPos = _player->getPosition();
 
    /* if (_coordLabel)
@@ -527,36 +481,40 @@ void HelloWorld::update(float dt)
     // ========================================
     // 3. 相机立即跟随玩家
     // ========================================
-    Size visibleSize = Director::getInstance()->getVisibleSize();
-    Size mapSize = map->getContentSize();
-    float scaleValue = _gameLayer->getScale();
+    HK_PROFILE_NEXT(sections, "update.3_camera");
+    {
+        // 相机跟随 + 听者更新
+        Size visibleSize = Director::getInstance()->getVisibleSize();
+        Size mapSize = map->getContentSize();
+        float scaleValue = _gameLayer->getScale();
 
-    float targetX = visibleSize.width * 0.5f - playerPos.x * scaleValue;
-    float targetY = visibleSize.height * 0.5f - playerPos.y * scaleValue;
+        float targetX = visibleSize.width * 0.5f - playerPos.x * scaleValue;
+        float targetY = visibleSize.height * 0.5f - playerPos.y * scaleValue;
 
-    float scaledMapWidth = mapSize.width * scaleValue;
-    float scaledMapHeight = mapSize.height * scaleValue;
+        float scaledMapWidth = mapSize.width * scaleValue;
+        float scaledMapHeight = mapSize.height * scaleValue;
 
-    float minX = -(scaledMapWidth - visibleSize.width);
-    float maxX = 0.0f;
-    float minY = -(scaledMapHeight - visibleSize.height);
-    float maxY = 0.0f;
+        float minX = -(scaledMapWidth - visibleSize.width);
+        float maxX = 0.0f;
+        float minY = -(scaledMapHeight - visibleSize.height);
+        float maxY = 0.0f;
 
-    if (scaledMapWidth > visibleSize.width) {
-        targetX = std::max(minX, std::min(targetX, maxX));
-    }
-    else {
-        targetX = (visibleSize.width - scaledMapWidth) * 0.5f;
-    }
+        if (scaledMapWidth > visibleSize.width) {
+            targetX = std::max(minX, std::min(targetX, maxX));
+        }
+        else {
+            targetX = (visibleSize.width - scaledMapWidth) * 0.5f;
+        }
 
-    if (scaledMapHeight > visibleSize.height) {
-        targetY = std::max(minY, std::min(targetY, maxY));
-    }
-    else {
-        targetY = (visibleSize.height - scaledMapHeight) * 0.5f;
-    }
+        if (scaledMapHeight > visibleSize.height) {
+            targetY = std::max(minY, std::min(targetY, maxY));
+        }
+        else {
+            targetY = (visibleSize.height - scaledMapHeight) * 0.5f;
+        }
 
-    _gameLayer->setPosition(targetX, targetY);
+        _gameLayer->setPosition(targetX, targetY);
+    }
 
     // ============================================================
        // 3. 【优化】定义通用的怪物碰撞处理 Lambda
@@ -579,8 +537,9 @@ void HelloWorld::update(float dt)
                 Rect attackBox = _player->getAttackHitbox();
                 if (attackBox.intersectsRect(monsterBox))
                 {
+                    HK_ALLOW_ALLOC_SCOPE("combat.hit");
                     // 使用 tag 区分日志，方便调试
-                    CCLOG("HIT! Player hit Monster (Tag: %d)", monster->getTag());
+                    HK_LOG_DEBUG(COMBAT, "HIT! Player hit Monster (Tag: %d)", monster->getTag());
 
                     monster->takeDamage(1, _player->getPosition());
                     isHit = true;
@@ -597,7 +556,8 @@ void HelloWorld::update(float dt)
                 {
                     if (!_player->isInvincible())
                     {
-                        CCLOG("Player collided with Monster (Tag: %d)", monster->getTag());
+                        HK_ALLOW_ALLOC_SCOPE("combat.hit");
+                        HK_LOG_DEBUG(COMBAT, "Player collided with Monster (Tag: %d)", monster->getTag());
                         _player->takeDamage(1, monster->getPosition(), _groundRects);
                         monster->onCollideWithPlayer(_player->getPosition());
                     }
@@ -610,37 +570,39 @@ void HelloWorld::update(float dt)
     // ============================================================
     // 4. 应用通用逻辑到各个怪物
     // ============================================================
+    HK_PROFILE_NEXT(sections, "update.4_monsters");
+
+    // A. 感知/决策：每只怪只读主角位置和地形、只写自己，节点树的修改 (位置/朝向/切状态) 记进 _sceneCommands
+    _aiWork.clear();
+    if (auto enemy = dynamic_cast<Enemy*>(_gameLayer->getChildByTag(999))) _aiWork.push_back({ enemy, nullptr, nullptr });   // Enemy
+    if (auto zombie = dynamic_cast<Zombie*>(_gameLayer->getChildByTag(998))) _aiWork.push_back({ nullptr, zombie, nullptr }); // Zombie
+    if (auto buzzer1 = dynamic_cast<Buzzer*>(_gameLayer->getChildByTag(996))) _aiWork.push_back({ nullptr, nullptr, buzzer1 }); // Buzzer 1
+    if (auto buzzer2 = dynamic_cast<Buzzer*>(_gameLayer->getChildByTag(995))) _aiWork.push_back({ nullptr, nullptr, buzzer2 }); // Buzzer 2
+
+    JobSystem::getInstance()->parallelFor((int)_aiWork.size(), Config::Jobs::MIN_ITEMS_PER_JOB,
+        [this, dt, &playerPos](int begin, int end) {
+            for (int i = begin; i < end; i++) {
+                const AIWork& work = _aiWork[i];
+                if (work.enemy) work.enemy->think(dt, _sceneCommands, i);
+                else if (work.zombie) work.zombie->think(dt, playerPos, _groundRects, _sceneCommands, i);
+                else work.buzzer->think(dt, playerPos, _sceneCommands, i);
+            }
+        });
+    _sceneCommands.commit();
 
-    // --- Enemy (999) ---
-    if (auto enemy = dynamic_cast<Enemy*>(_gameLayer->getChildByTag(999))) {
-        // 先调用各自独特的 update (参数可能不同)
-        // Enemy 的 update 需要 groundRects
-        // 【注意】这里不要 retain，handleCommonCollision 里面会 retain
-        enemy->update(dt);
-        handleCommonCollision(enemy); // 传入 lambda 处理碰撞
-    }
-
-    // --- Zombie (998) ---
-    if (auto zombie = dynamic_cast<Zombie*>(_gameLayer->getChildByTag(998))) {
-        zombie->update(dt, playerPos, _groundRects);
-        handleCommonCollision(zombie);
-    }
-
-    // --- Buzzer 1 (996) ---
-    if (auto buzzer1 = dynamic_cast<Buzzer*>(_gameLayer->getChildByTag(996))) {
-        // Buzzer 的 update 不需要 groundRects (根据你原代码)
-        buzzer1->update(dt, playerPos);
-        handleCommonCollision(buzzer1);
+    // B. 回到主线程，按原来的顺序结算碰撞
+    for (const auto& work : _aiWork)
+    {
+        if (work.enemy) handleCommonCollision(work.enemy);
+        else if (work.zombie) handleCommonCollision(work.zombie);
+        else handleCommonCollision(work.buzzer);
     }
+    _aiWork.clear();
 
-    // --- Buzzer 2 (995) ---
-    if (auto buzzer2 = dynamic_cast<Buzzer*>(_gameLayer->getChildByTag(995))) {
-        buzzer2->update(dt, playerPos);
-        handleCommonCollision(buzzer2);
-    }
     // ========================================
     // 5. Spike 陷阱检测
     // ========================================
+    HK_PROFILE_NEXT(sections, "update.5_spike");
     auto spike = dynamic_cast<Spike*>(_gameLayer->getChildByTag(997));
     if (spike)
     {
@@ -664,7 +626,8 @@ void HelloWorld::update(float dt)
             {
                 if (!_player->isInvincible())
                 {
-                    CCLOG("Player hit by Spike!");
+                    HK_ALLOW_ALLOC_SCOPE("combat.hit");
+                    HK_LOG_DEBUG(COMBAT, "Player hit by Spike!");
                     _player->takeDamage(1, spike->getPosition(), _groundRects);
                 }
             }
@@ -682,6 +645,7 @@ void HelloWorld::update(float dt)
     // ========================================
     // 6. Jar 罐子碰撞检测
     // ========================================
+    HK_PROFILE_NEXT(sections, "update.6_jars");
    // 使用迭代器遍历，安全删除无效的罐子指针
     if (_currentLevel == 2 && !_jars.empty())
     {
@@ -709,7 +673,8 @@ void HelloWorld::update(float dt)
 
                 if (!jarBox.equals(Rect::ZERO) && attackBox.intersectsRect(jarBox))
                 {
-                    CCLOG("Player hit the jar!");
+                    HK_ALLOW_ALLOC_SCOPE("combat.hit"); // 碎罐特效 + 888 号罐子生成复仇之魂
+                    HK_LOG_DEBUG(COMBAT, "Player hit the jar!");
                     jar->takeDamage();
                     // 罐子也是可以下劈的
                     if (_player->getAttackDir() == -1) {
@@ -721,7 +686,7 @@ void HelloWorld::update(float dt)
                     // ============================================================
                     if (jar->getTag() == 888&&jar->isDestroyed())
                     {
-                        CCLOG("Special Jar Broken! Spawning Fireball at fixed position...");
+                        HK_LOG_INFO(LEVEL, "Special Jar Broken! Spawning Fireball at fixed position...");
 
                         auto fireball = Fireball::create("fireball/idle/fireball_1.png");
                         if (fireball)
@@ -768,6 +733,7 @@ void HelloWorld::update(float dt)
     // ========================================
     // 8. 复仇之魂拾取逻辑 (Tag 987)
     // ========================================
+    HK_PROFILE_NEXT(sections, "update.8_pickup");
     auto skillItemNode = _gameLayer->getChildByTag(987);
     if (skillItemNode)
     {
@@ -780,7 +746,8 @@ void HelloWorld::update(float dt)
 
             if (playerBox.intersectsRect(itemBox))
             {
-                CCLOG("INTERACTION: Acquired Vengeful Spirit!");
+                HK_ALLOW_ALLOC_SCOPE("item.pickup");
+                HK_LOG_INFO(PLAYER, "INTERACTION: Acquired Vengeful Spirit!");
 
                 // 1. 解锁技能
                 _player->unlockFireball();
@@ -803,71 +770,25 @@ void HelloWorld::update(float dt)
     // ========================================
     // 9. Boss 战斗逻辑 (Level 3)
     // ========================================
+    HK_PROFILE_NEXT(sections, "update.9_boss");
     if (_currentLevel == 3)
     {
         updateBossInteraction(dt); // Boss 本体
-        updateBossProjectiles(dt); // Boss 弹幕
-    }
-
-    // ========================================
-    // 10. FKFireball 碰撞检测 (Level 3)
-    // ========================================
-    if (_currentLevel == 3)
-    {
-        auto children = _gameLayer->getChildren();
-        for (auto child : children)
-        {
-            auto fireball = dynamic_cast<FKFireball*>(child);
-            if (fireball)
-            {
-                fireball->update(dt, _groundRects);
-                Rect fireballBox = fireball->getCollisionBox();
-                if (!fireballBox.equals(Rect::ZERO))
-                {
-                    Rect playerBox = _player->getCollisionBox();
-                    if (playerBox.intersectsRect(fireballBox))
-                    {
-                        if (!_player->isInvincible())
-                        {
-                            CCLOG("Player hit by FKFireball!");
-                            _player->takeDamage(1, fireball->getPosition(), _groundRects);
-                            fireball->removeFromParent(); // 火球碰到玩家后消失
-                        }
-                    }
-                }
-            }
-            else if (auto shockwave = dynamic_cast<FKShockwave*>(child))
-            {
-                shockwave->update(dt, _groundRects);
-                Rect swBox = shockwave->getCollisionBox();
-                if (!swBox.equals(Rect::ZERO))
-                {
-                    Rect playerBox = _player->getCollisionBox();
-                    if (playerBox.intersectsRect(swBox))
-                    {
-                        if (!_player->isInvincible())
-                        {
-                            CCLOG("Player hit by FKShockwave!");
-                            _player->takeDamage(1, shockwave->getPosition(), _groundRects);
-                            shockwave->removeFromParent();
-                        }
-                    }
-                }
-            }
-        }
+        updateBossProjectiles(dt); // Boss 弹幕 (每帧只在这里更新一次)
     }
 
     // ============================================================
-    // 11.主角火球 vs Boss 碰撞检测
+    // 10.主角火球 vs Boss 碰撞检测
     // ============================================================
+    HK_PROFILE_NEXT(sections, "update.10_fireballVsBoss");
     if (_currentLevel == 3 && _boss && _bossTriggered)
     {
-        // 遍历所有子节点找到主角的火球
-        auto children = _gameLayer->getChildren();
-        for (auto child : children)
+        // 遍历所有子节点找到主角的火球 (倒序：命中的火球会当场移除，不用先拷一份子节点表)
+        const auto& children = _gameLayer->getChildren();
+        for (ssize_t i = children.size() - 1; i >= 0; i--)
         {
             // 1. 筛选：必须是 Fireball 类，且 Tag 为 5000 (Player.cpp里定义的)
-            auto pFireball = dynamic_cast<Fireball*>(child);
+            auto pFireball = dynamic_cast<Fireball*>(children.at(i));
             if (pFireball && pFireball->getTag() == 5000)
             {
                 // 2. 获取 Boss 的身体判定框
@@ -876,7 +797,8 @@ void HelloWorld::update(float dt)
                 // 3. 检测碰撞
                 if (!bossBox.equals(Rect::ZERO) && pFireball->getHitbox().intersectsRect(bossBox))
                 {
-                    CCLOG("HIT! Vengeful Spirit hit the Boss!");
+                    HK_ALLOW_ALLOC_SCOPE("combat.hit");
+                    HK_LOG_DEBUG(COMBAT, "HIT! Vengeful Spirit hit the Boss!");
 
                     // A. Boss 扣血 (法术伤害通常比平砍高，设为 3 或者 10)
                     _boss->takeDamage(3);
@@ -893,8 +815,9 @@ void HelloWorld::update(float dt)
     }
 
     // ========================================
-    // 12.梦之钉 碰撞检测
+    // 11.梦之钉 碰撞检测
     // ========================================
+    HK_PROFILE_NEXT(sections, "update.11_dreamNail");
     if (_player->isDreamNailActive())
     {
         bool hasHit = false; // 防止一帧内多次判定
@@ -907,6 +830,7 @@ void HelloWorld::update(float dt)
                 // 使用多态获取碰撞箱 (Jar 和 Enemy 的 getHitbox 实现不同，但接口一致)
                 if (_player->getDreamNailHitbox().intersectsRect(entity->getHitbox()))
                 {
+                    HK_ALLOW_ALLOC_SCOPE("dreamNail.hit");
                     // 2. 【核心】调用实体内部的梦语逻辑
                     // 它会自动读取 setDreamThought 设置的文本并弹窗
                     entity->onDreamNailHit();
@@ -915,7 +839,7 @@ void HelloWorld::update(float dt)
                     _player->setDreamNailActive(false);
                     hasHit = true;
 
-                    CCLOG("Dream Nail hit entity Tag: %d", entity->getTag());
+                    HK_LOG_DEBUG(COMBAT, "Dream Nail hit entity Tag: %d", entity->getTag());
                 }
             }
             };
@@ -944,6 +868,16 @@ void HelloWorld::update(float dt)
     }
 }
 
+void HelloWorld::onExit()
+{
+    Scene::onExit();
+
+    InputRecorder::getInstance()->endSession(this);
+
+    // 池中空闲的对话框不在场景树里，场景退出时一并释放
+    DreamDialogue::purgePool();
+}
+
 void HelloWorld::menuCloseCallback(Ref* pSender)
 {
     Director::getInstance()->end();
@@ -954,6 +888,8 @@ void HelloWorld::menuCloseCallback(Ref* pSender)
 // ========================================
 void HelloWorld::loadMap(const std::string& mapPath)
 {
+    HK_PROFILE_ZONE("HelloWorld::loadMap");
+
     // 【修复建议】在移除旧地图之前，首先清理依赖于它的对象
     if (_currentLevel == 3)
     {
@@ -1013,32 +949,38 @@ void HelloWorld::loadMap(const std::string& mapPath)
         _bossTriggered = false;
     }
 
-    CCLOG("DEBUG_STEP_1: Starting TMXTiledMap::create with path: %s", mapPath.c_str());
+    HK_LOG_TRACE(LEVEL, "DEBUG_STEP_1: Starting TMXTiledMap::create with path: %s", mapPath.c_str());
    
-    // 4. 加载新地图
-    auto map = TMXTiledMap::create(mapPath);
+    // 4. 加载新地图 (启动时预读过的直接从内存解析，图块集路径相对于 tmx 所在目录)
+    TMXTiledMap* map = nullptr;
+    if (const std::string* xml = AssetPreloader::getInstance()->getMapXml(mapPath)) {
+        map = TMXTiledMap::createWithXML(*xml, mapPath.substr(0, mapPath.find_last_of('/')));
+    }
+    else {
+        map = TMXTiledMap::create(mapPath);
+    }
     if (map == nullptr) {
-        CCLOG("Error: Failed to load %s", mapPath.c_str());
+        HK_LOG_ERROR(LEVEL, "Error: Failed to load %s", mapPath.c_str());
         return;
     }
-    CCLOG("DEBUG_STEP_2: Map created successfully. Setting tag...");
+    HK_LOG_TRACE(LEVEL, "DEBUG_STEP_2: Map created successfully. Setting tag...");
 
     map->setAnchorPoint(Vec2(0, 0));
     map->setPosition(Vec2(0, 0));
     map->setTag(123);
     _gameLayer->addChild(map, -99);
 
-    CCLOG("DEBUG_STEP_3: Parsing collisions...");
+    HK_LOG_TRACE(LEVEL, "DEBUG_STEP_3: Parsing collisions...");
 
     // 5. 解析碰撞数据
     this->parseMapCollisions(map);
-    CCLOG("DEBUG_STEP_4: Collisions parsed. GroundRects size: %d", (int)_groundRects.size());
+    HK_LOG_TRACE(LEVEL, "DEBUG_STEP_4: Collisions parsed. GroundRects size: %d", (int)_groundRects.size());
     // ============================================================
     // 【修改】Level 3 偏移量统一管理
     // 定义一个 mapOffset 变量，同时应用于背景图和碰撞框
     // ============================================================
     Vec2 mapOffset = Vec2::ZERO;
-    CCLOG("DEBUG_STEP_5: Creating Boss...");
+    HK_LOG_TRACE(LEVEL, "DEBUG_STEP_5: Creating Boss...");
 
     if (_currentLevel == 3)
     {
@@ -1062,7 +1004,7 @@ void HelloWorld::loadMap(const std::string& mapPath)
     //     drawNode->drawRect(rect.origin, rect.origin + rect.size, Color4F::RED);
     // }
 
-    CCLOG("========== Map Loaded: %s ==========", mapPath.c_str());
+    HK_LOG_INFO(LEVEL, "========== Map Loaded: %s ==========", mapPath.c_str());
 
     // 7. 根据关卡创建特定的敌人和对象
     // 修复：切换地图时只加载当前关卡对象，避免level2对象穿越到level1
@@ -1074,15 +1016,17 @@ void HelloWorld::loadMap(const std::string& mapPath)
     {
         _jars.clear();
         Jar::setupPuzzleJars(_gameLayer, _jars);
+        // 每帧拼 地面 + 罐子顶 用的缓冲，一次预留够
+        _dynamicGroundRects.reserve(_groundRects.size() + _jars.size());
         // 只创建level2对象
         auto visibleSize = Director::getInstance()->getVisibleSize();
-        auto hintDialog = DreamDialogue::create("Listen to the dream...Three voices... Only one speaks the truth...Save that one to hold the flame...");
+        auto hintDialog = DreamDialogue::acquire(Config::Dialogue::HINT_LEVEL_2);
         if (hintDialog)
         {
             hintDialog->setPosition(Vec2(visibleSize.width / 2, visibleSize.height-300));
             this->addChild(hintDialog, 200);
             hintDialog->show();
-            CCLOG("Level 2 Hint displayed.");
+            HK_LOG_DEBUG(LEVEL, "Level 2 Hint displayed.");
         }
     }
     else if (_currentLevel == 3)
@@ -1095,15 +1039,15 @@ void HelloWorld::loadMap(const std::string& mapPath)
             bg->setPosition(mapOffset);
             map->addChild(bg, -1);
             map->setContentSize(bg->getContentSize());
-            CCLOG("Success: Level 3 background loaded manually.");
+            HK_LOG_DEBUG(LEVEL, "Success: Level 3 background loaded manually.");
         }
         else
         {
-            CCLOG("Error: Failed to load Level 3 background 'maps/GameAsset/fight.png'");
+            HK_LOG_ERROR(LEVEL, "Error: Failed to load Level 3 background 'maps/GameAsset/fight.png'");
         }
         float groundY = 856.0f + mapOffset.y;
         _boss = Boss::create(Vec2(1650 + mapOffset.x, groundY + 200));
-        CCLOG("DEBUG_STEP_6: Boss create() returned.");
+        HK_LOG_TRACE(LEVEL, "DEBUG_STEP_6: Boss create() returned.");
         if (_boss)
         {
             _boss->setTag(980);
@@ -1125,31 +1069,29 @@ void HelloWorld::loadMap(const std::string& mapPath)
                     _gameLayer->addChild(shockwave, 7);
                 }
             });
-            CCLOG("Boss created at (%.0f, %.0f) for falling", 1650 + mapOffset.x, groundY + 200);
+            HK_LOG_DEBUG(LEVEL, "Boss created at (%.0f, %.0f) for falling", 1650 + mapOffset.x, groundY + 200);
         }
         else
         {
-            CCLOG("Error: Failed to create Boss!");
+            HK_LOG_ERROR(LEVEL, "Error: Failed to create Boss!");
         }
-        CCLOG("Level 3 loaded - Ready for battle!");
+        HK_LOG_INFO(LEVEL, "Level 3 loaded - Ready for battle!");
     }
 
-// ============================================================
-    // 【新增】音乐切换逻辑
+    // 8. 纹理驻留：登记这张地图的图块集，超出显存预算时淘汰其它关卡最久没用的纹理
+    auto residency = TextureResidency::getInstance();
+    residency->trackMap(map, _currentLevel);
+    residency->onLevelEnter(_currentLevel);
+
     // ============================================================
-auto audio = CocosDenshion::SimpleAudioEngine::getInstance();
+    // 9. 音乐切换
+    // ============================================================
+    // 这一关的音效/音乐清单在黑屏期间全部预加载，进关后第一次播放不用再解码
+    AudioManager::getInstance()->preloadLevel(_currentLevel);
 
-if (_currentLevel == 3)
-{
-    // 进入 Boss 关：切换到战斗音乐
-    audio->stopBackgroundMusic();
-    audio->playBackgroundMusic(Config::Audio::BGM_BOSS, true); // true = 循环播放
-    CCLOG("Music: Switched to BOSS BGM");
-}
-else
-{
-   
-}
+    // 换成这一关的音乐：切关开始时已经 prefetch 过，这里和黑屏过渡同步交叉淡化
+    // (同一首就继续放，Level 1/2 之间来回不会重新开始)
+    MusicPlayer::getInstance()->play(AudioManager::getLevelMusic(_currentLevel));
 }
 // ========================================
 // 切换到Level2的方法
@@ -1159,7 +1101,8 @@ void HelloWorld::switchToLevel2()
     if (_isTransitioning || _currentLevel == 2) return;
 
     _isTransitioning = true;
-    CCLOG("========== Switching to Level 2 ==========");
+    HK_LOG_INFO(LEVEL, "========== Switching to Level 2 ==========");
+    MusicPlayer::getInstance()->prefetch(AudioManager::getLevelMusic(2));
 
     auto blackLayer = LayerColor::create(Color4B::BLACK);
     blackLayer->setOpacity(0);
@@ -1184,7 +1127,7 @@ void HelloWorld::switchToLevel2()
     auto cleanup = CallFunc::create([this, blackLayer]() {
         blackLayer->removeFromParent();
         _isTransitioning = false;
-        CCLOG("========== Level 2 loaded successfully ==========");
+        HK_LOG_INFO(LEVEL, "========== Level 2 loaded successfully ==========");
         });
 
     blackLayer->runAction(Sequence::create(fadeIn, switchMap, delay, fadeOut, cleanup, nullptr));
@@ -1198,7 +1141,10 @@ void HelloWorld::switchToLevel3()
     if (_isTransitioning || _currentLevel == 3) return;
 
     _isTransitioning = true;
-    CCLOG("========== Switching to Level 3 ==========");
+    HK_LOG_INFO(LEVEL, "========== Switching to Level 3 ==========");
+
+    // 黑屏淡入期间让 Boss 音乐先在后台打开解码，loadMap 里直接交叉淡化过去
+    MusicPlayer::getInstance()->prefetch(AudioManager::getLevelMusic(3));
 
     auto blackLayer = LayerColor::create(Color4B::BLACK);
     blackLayer->setOpacity(0);
@@ -1223,7 +1169,7 @@ void HelloWorld::switchToLevel3()
     auto cleanup = CallFunc::create([this, blackLayer]() {
         blackLayer->removeFromParent();
         _isTransitioning = false;
-        CCLOG("========== Level 3 loaded successfully ==========");
+        HK_LOG_INFO(LEVEL, "========== Level 3 loaded successfully ==========");
         });
 
     blackLayer->runAction(Sequence::create(fadeIn, switchMap, delay, fadeOut, cleanup, nullptr));
@@ -1236,7 +1182,8 @@ void HelloWorld::switchToLevel1()
 {
     if (_isTransitioning || _currentLevel == 1) return;
     _isTransitioning = true;
-    CCLOG("========== Switching to Level 1 ==========");
+    HK_LOG_INFO(LEVEL, "========== Switching to Level 1 ==========");
+    MusicPlayer::getInstance()->prefetch(AudioManager::getLevelMusic(1));
     auto blackLayer = LayerColor::create(Color4B::BLACK);
     blackLayer->setOpacity(0);
     this->addChild(blackLayer, 999);
@@ -1256,7 +1203,7 @@ void HelloWorld::switchToLevel1()
     auto cleanup = CallFunc::create([this, blackLayer]() {
         blackLayer->removeFromParent();
         _isTransitioning = false;
-        CCLOG("========== Level 1 loaded successfully ==========");
+        HK_LOG_INFO(LEVEL, "========== Level 1 loaded successfully ==========");
         });
     blackLayer->runAction(Sequence::create(fadeIn, switchMap, delay, fadeOut, cleanup, nullptr));
 }
@@ -1268,7 +1215,8 @@ void HelloWorld::switchToLevel2FromRight()
 {
     if (_isTransitioning || _currentLevel == 2) return;
     _isTransitioning = true;
-    CCLOG("========== Switching to Level 2 (from right) ==========");
+    HK_LOG_INFO(LEVEL, "========== Switching to Level 2 (from right) ==========");
+    MusicPlayer::getInstance()->prefetch(AudioManager::getLevelMusic(2));
     auto blackLayer = LayerColor::create(Color4B::BLACK);
     blackLayer->setOpacity(0);
     this->addChild(blackLayer, 999);
@@ -1288,7 +1236,7 @@ void HelloWorld::switchToLevel2FromRight()
     auto cleanup = CallFunc::create([this, blackLayer]() {
         blackLayer->removeFromParent();
         _isTransitioning = false;
-        CCLOG("========== Level 2 loaded successfully (from right) ==========");
+        HK_LOG_INFO(LEVEL, "========== Level 2 loaded successfully (from right) ==========");
         });
     blackLayer->runAction(Sequence::create(fadeIn, switchMap, delay, fadeOut, cleanup, nullptr));
 }
@@ -1306,7 +1254,7 @@ void HelloWorld::updateBossInteraction(float dt)
     // 1. 触发逻辑
     if (!_bossTriggered && playerPos.x >= 1000.0f) {
         _bossTriggered = true;
-        CCLOG("========== BOSS TRIGGERED ==========");
+        HK_LOG_INFO(AI, "========== BOSS TRIGGERED ==========");
     }
     if (!_bossTriggered) return;
 
@@ -1325,26 +1273,27 @@ void HelloWorld::updateBossInteraction(float dt)
         // A. 玩家平砍
         if (_player->isAttackPressed()) {
             if (_player->getAttackHitbox().intersectsRect(bossBodyBox)) {
-                CCLOG("HIT! Player hit the Boss!");
+                HK_ALLOW_ALLOC_SCOPE("combat.hit");
+                HK_LOG_DEBUG(COMBAT, "HIT! Player hit the Boss!");
                 _boss->takeDamage(1);
                 isBossHit = true;
                 if (_player->getAttackDir() == -1) _player->pogoJump();
 
                 // 受击回魂
-                static int bossHitCombo = 0;
-                if (++bossHitCombo >= 3) {
-                    bossHitCombo = 0;
+                if (++_bossHitCombo >= 3) {
+                    _bossHitCombo = 0;
                     if (_player->getStats()->getSoul() < _player->getStats()->getMaxSoul())
                         _player->gainSoul(1);
                 }
             }
         }
 
-        // B. 玩家法术 (复仇之魂)
-        auto children = _gameLayer->getChildren();
-        for (auto child : children) {
-            if (auto pFireball = dynamic_cast<Fireball*>(child)) {
+        // B. 玩家法术 (复仇之魂)：倒序遍历，命中的火球当场移除
+        const auto& children = _gameLayer->getChildren();
+        for (ssize_t i = children.size() - 1; i >= 0; i--) {
+            if (auto pFireball = dynamic_cast<Fireball*>(children.at(i))) {
                 if (pFireball->getTag() == 5000 && pFireball->getHitbox().intersectsRect(bossBodyBox)) {
+                    HK_ALLOW_ALLOC_SCOPE("combat.hit");
                     _boss->takeDamage(3);
                     pFireball->removeFromParent();
                 }
@@ -1354,6 +1303,7 @@ void HelloWorld::updateBossInteraction(float dt)
         // C. 撞人
         if (!isBossHit) {
             if (_player->getCollisionBox().intersectsRect(bossBodyBox) && !_player->isInvincible()) {
+                HK_ALLOW_ALLOC_SCOPE("combat.hit");
                 _player->takeDamage(1, _boss->getPosition(), _groundRects);
             }
         }
@@ -1363,6 +1313,7 @@ void HelloWorld::updateBossInteraction(float dt)
     Rect bossHammerBox = _boss->getHammerHitbox();
     if (!bossHammerBox.equals(Rect::ZERO)) {
         if (_player->getCollisionBox().intersectsRect(bossHammerBox) && !_player->isInvincible()) {
+            HK_ALLOW_ALLOC_SCOPE("combat.hit");
             _player->takeDamage(1, _boss->getPosition(), _groundRects);
         }
     }
@@ -1372,37 +1323,167 @@ void HelloWorld::updateBossInteraction(float dt)
 
 void HelloWorld::updateBossProjectiles(float dt)
 {
-    auto children = _gameLayer->getChildren();
-    for (auto child : children)
+    // 1. 收集本帧的弹幕 (容器在 init 里预留过容量)
+    _projectileWork.clear();
+    for (auto child : _gameLayer->getChildren())
     {
-        // 1. FKFireball
         if (auto fireball = dynamic_cast<FKFireball*>(child)) {
-            fireball->update(dt, _groundRects);
-            if (!fireball->getCollisionBox().equals(Rect::ZERO) &&
-                _player->getCollisionBox().intersectsRect(fireball->getCollisionBox()) &&
-                !_player->isInvincible())
-            {
-                _player->takeDamage(1, fireball->getPosition(), _groundRects);
-                fireball->removeFromParent();
-            }
-            continue;
+            _projectileWork.push_back({ fireball, nullptr, Rect::ZERO });
         }
-
-        // 2. FKShockwave
-        if (auto shockwave = dynamic_cast<FKShockwave*>(child)) {
-            shockwave->update(dt, _groundRects);
-            if (!shockwave->getCollisionBox().equals(Rect::ZERO) &&
-                _player->getCollisionBox().intersectsRect(shockwave->getCollisionBox()) &&
-                !_player->isInvincible())
-            {
-                _player->takeDamage(1, shockwave->getPosition(), _groundRects);
-                shockwave->removeFromParent();
+        else if (auto shockwave = dynamic_cast<FKShockwave*>(child)) {
+            _projectileWork.push_back({ nullptr, shockwave, Rect::ZERO });
+        }
+    }
+    if (_projectileWork.empty()) return;
+
+    // 2. 并行推进：每颗弹幕只读地形、只写自己，节点树的修改记进 _sceneCommands
+    JobSystem::getInstance()->parallelFor((int)_projectileWork.size(), Config::Jobs::MIN_ITEMS_PER_JOB,
+        [this, dt](int begin, int end) {
+            for (int i = begin; i < end; i++) {
+                ProjectileWork& work = _projectileWork[i];
+                work.hitbox = work.fireball
+                    ? work.fireball->step(dt, _groundRects, _sceneCommands, i)
+                    : work.shockwave->step(dt, _groundRects, _sceneCommands, i);
             }
+        });
+
+    // 3. 回到主线程：先落位置/移除，再按原顺序结算伤害
+    _sceneCommands.commit();
+
+    for (const auto& work : _projectileWork)
+    {
+        if (work.hitbox.equals(Rect::ZERO)) continue; // 这一帧已经撞墙/落地消失
+
+        if (_player->getCollisionBox().intersectsRect(work.hitbox) && !_player->isInvincible())
+        {
+            HK_ALLOW_ALLOC_SCOPE("combat.hit");
+            Node* projectile = work.fireball ? (Node*)work.fireball : (Node*)work.shockwave;
+            _player->takeDamage(1, projectile->getPosition(), _groundRects);
+            projectile->removeFromParent();
         }
     }
+    _projectileWork.clear();
+}
+
+// ========================================
+// 暂停系统
+// ========================================
+void HelloWorld::pauseNodeTree(Node* node)
+{
+    node->pause();
+    for (auto child : node->getChildren()) {
+        pauseNodeTree(child);
+    }
+}
+
+void HelloWorld::resumeNodeTree(Node* node)
+{
+    node->resume();
+    for (auto child : node->getChildren()) {
+        resumeNodeTree(child);
+    }
+}
+
+void HelloWorld::showPauseMenu()
+{
+    if (_isGamePaused) return;
+
+    auto visibleSize = Director::getInstance()->getVisibleSize();
+    Vec2 origin = Director::getInstance()->getVisibleOrigin();
+    auto hud = this->getChildByTag(900);
+
+    // 1. 暂停层和画面定格只在第一次暂停时创建
+    if (!_pauseSnapshot)
+    {
+        _pauseSnapshot = RenderTexture::create((int)visibleSize.width, (int)visibleSize.height);
+        _pauseSnapshot->setPosition(origin + visibleSize / 2);
+        this->addChild(_pauseSnapshot, 300);
+    }
+    if (!_pauseLayer)
+    {
+        _pauseLayer = KeyBindingLayer::create();
+        _pauseLayer->setPauseMode(true);
+        _pauseLayer->setOnResume([this]() {
+            this->hidePauseMenu();
+            });
+        this->addChild(_pauseLayer, 301);
+    }
+
+    // 2. 把当前画面画进 RenderTexture (必须在隐藏游戏层之前 visit)
+    _pauseSnapshot->setVisible(false);
+    _pauseSnapshot->beginWithClear(0, 0, 0, 1);
+    if (_gameLayer) _gameLayer->visit();
+    if (hud) hud->visit();
+    _pauseSnapshot->end();
+    _pauseSnapshot->setVisible(true);
+
+    // 3. 停掉模拟：游戏层和 HUD 不再绘制、不再跑动作
+    if (_gameLayer) {
+        pauseNodeTree(_gameLayer);
+        _gameLayer->setVisible(false);
+    }
+    if (hud) {
+        pauseNodeTree(hud);
+        hud->setVisible(false);
+    }
+
+    // 循环音效 (跑步、凝聚) 跟着暂停，背景音乐继续
+    AudioManager::getInstance()->pauseAll();
+
+    // 4. 显示暂停菜单
+    _pauseLayer->refresh();
+    _pauseLayer->setVisible(true);
+    _pauseLayer->resume();
+
+    _isGamePaused = true;
+    FrameRateManager::getInstance()->enterIdle();
+    HK_LOG_INFO(UI, "Game Paused");
+}
+
+void HelloWorld::hidePauseMenu()
+{
+    if (!_isGamePaused) return;
+
+    // 先恢复满帧，恢复后的第一帧就是 60fps
+    FrameRateManager::getInstance()->enterActive();
+
+    // 1. 收起暂停菜单 (pause 会同时停掉它的键盘监听)
+    if (_pauseLayer) {
+        _pauseLayer->setVisible(false);
+        _pauseLayer->pause();
+    }
+    if (_pauseSnapshot) {
+        _pauseSnapshot->setVisible(false);
+    }
+
+    // 2. 恢复游戏层和 HUD
+    auto hud = this->getChildByTag(900);
+    if (_gameLayer) {
+        _gameLayer->setVisible(true);
+        resumeNodeTree(_gameLayer);
+    }
+    if (hud) {
+        hud->setVisible(true);
+        resumeNodeTree(hud);
+    }
+
+    AudioManager::getInstance()->resumeAll();
+
+    // 3. 暂停期间松开的按键收不到，这里统一清空输入 (连同没取的事件和缓冲)
+    _inputQueue.reset();
+    setInputBits(0);
+
+    _isGamePaused = false;
+    HK_LOG_INFO(UI, "Game Resumed");
 }
 
 void HelloWorld::onPlayerDeath()
+{
+    // 这里还在主角状态机里 (StateDead::enter)，不能立刻换状态：交给下一帧的 update
+    _pendingRespawn = true;
+}
+
+void HelloWorld::respawnAtLevelStart()
 {
     // 主角死亡后重生在当前地图的左端
     if (_player) {
@@ -1421,4 +1502,293 @@ void HelloWorld::onPlayerDeath()
         _player->setVelocityX(0);
         // 可选：重置主角状态、血量等
     }
-}
\ No newline at end of file
+}
+
+// ========================================
+// Level 1 怪物 (按 Tag 创建)
+// ========================================
+Node* HelloWorld::spawnEntity(int tag)
+{
+    // 死亡回调 (回魂)
+    auto onKill = [this](const char* who) {
+        if (_player) {
+            _player->gainSoulOnKill();
+            HK_LOG_DEBUG(COMBAT, "Soul gained from %s!", who);
+        }
+    };
+
+    switch (tag)
+    {
+    case 999:
+    {
+        // --- 创建 Enemy ---
+        auto enemy = Enemy::create("enemies/enemy_walk_1.png");
+        if (!enemy) return nullptr;
+        enemy->setPosition(Vec2(600, 430));
+        enemy->setPatrolRange(500, 800);
+        enemy->setTag(999);
+        _gameLayer->addChild(enemy, 5);
+        enemy->setOnDeathCallback([=]() { onKill("Enemy"); });
+        HK_LOG_DEBUG(LEVEL, "Enemy spawned at (%.0f, %.0f)", enemy->getPositionX(), enemy->getPositionY());
+        return enemy;
+    }
+    case 998:
+    {
+        // --- 创建 Zombie 敌人 ---
+        auto zombie = Zombie::create("zombie/walk/walk_1.png");
+        if (!zombie) return nullptr;
+        zombie->setPosition(Vec2(1200, 430));
+        zombie->setPatrolRange(1000, 1400);
+        zombie->setTag(998);
+        _gameLayer->addChild(zombie, 5);
+        zombie->setOnDeathCallback([=]() { onKill("Zombie"); });
+        HK_LOG_DEBUG(LEVEL, "Zombie spawned at (%.0f, %.0f)", zombie->getPositionX(), zombie->getPositionY());
+        return zombie;
+    }
+    case 997:
+    {
+        // --- 创建 Spike 陷阱 ---
+        auto textureCache = Director::getInstance()->getTextureCache();
+        auto spikeTexture = textureCache->addImage("traps/spike.png");
+        Spike* spike = spikeTexture ? Spike::create("traps/spike.png")
+                                    : Spike::create("enemies/enemy_walk_1.png"); // Fallback
+        if (!spike) return nullptr;
+        spike->setInitialPosition(Vec2(3590.0f, 1000.0f));
+        spike->setTag(997);
+        spike->setAnchorPoint(Vec2(0.5f, 0.5f));
+        spike->setVisible(true);
+        spike->setOpacity(255);
+        spike->setScale(1.0f);
+        spike->setBlendFunc(BlendFunc::ALPHA_PREMULTIPLIED);
+        _gameLayer->addChild(spike, 5);
+        return spike;
+    }
+    case 996:
+    case 995:
+    {
+        // --- 创建 Buzzer 飞行敌人 ---
+        auto buzzer = Buzzer::create("buzzer/idle/idle_1.png");
+        if (!buzzer) return nullptr;
+        buzzer->setInitialPosition(tag == 996 ? Vec2(4000.0f, 900.0f) : Vec2(6000.0f, 700.0f));
+        buzzer->setTag(tag);
+        _gameLayer->addChild(buzzer, 5);
+        buzzer->setOnDeathCallback([=]() { onKill(tag == 996 ? "Buzzer 1" : "Buzzer 2"); });
+        return buzzer;
+    }
+    default:
+        return nullptr;
+    }
+}
+
+// ========================================
+// 快照：抓取 / 恢复
+// ========================================
+void HelloWorld::captureSnapshot(SimSnapshot& out)
+{
+    HK_PROFILE_ZONE("HelloWorld::captureSnapshot");
+
+    out.begin(_simFrame, _currentLevel);
+    out.bossTriggered = _bossTriggered;
+    out.bossHitCombo = _bossHitCombo;
+    if (_player) _player->saveSnapshot(out.player);
+
+    // 1. 活着的怪物 (正在播死亡动画的不存，恢复时会被移除)
+    for (int tag : LEVEL1_ENTITY_TAGS)
+    {
+        auto node = _gameLayer->getChildByTag(tag);
+        if (!node) continue;
+
+        EntitySnapshot* e = nullptr;
+        if (auto enemy = dynamic_cast<Enemy*>(node)) {
+            if (!enemy->isDead() && (e = out.addEntity())) enemy->saveSnapshot(*e);
+        }
+        else if (auto zombie = dynamic_cast<Zombie*>(node)) {
+            if (!zombie->isDead() && (e = out.addEntity())) zombie->saveSnapshot(*e);
+        }
+        else if (auto spike = dynamic_cast<Spike*>(node)) {
+            if (!spike->isDead() && (e = out.addEntity())) spike->saveSnapshot(*e);
+        }
+        else if (auto buzzer = dynamic_cast<Buzzer*>(node)) {
+            if (!buzzer->isDead() && (e = out.addEntity())) buzzer->saveSnapshot(*e);
+        }
+    }
+
+    // 2. 没碎的罐子 + 地上的复仇之魂
+    for (auto jar : _jars)
+    {
+        if (!jar || jar->isDestroyed()) continue;
+        if (JarSnapshot* j = out.addJar()) jar->saveSnapshot(*j);
+    }
+    out.hasSkillPickup = _gameLayer->getChildByTag(987) != nullptr;
+
+    // 3. 弹幕
+    for (auto child : _gameLayer->getChildren())
+    {
+        ProjectileSnapshot* p = nullptr;
+        if (auto fireball = dynamic_cast<Fireball*>(child)) {
+            if (fireball->getTag() != 5000 || !fireball->isLaunched()) continue;
+            if ((p = out.addProjectile())) fireball->saveSnapshot(*p);
+        }
+        else if (auto fkFireball = dynamic_cast<FKFireball*>(child)) {
+            if ((p = out.addProjectile())) fkFireball->saveSnapshot(*p);
+        }
+        else if (auto shockwave = dynamic_cast<FKShockwave*>(child)) {
+            if ((p = out.addProjectile())) shockwave->saveSnapshot(*p);
+        }
+        else continue;
+
+        if (!p) {
+            HK_LOG_WARN(GENERAL, "Snapshot: projectile capacity (%d) exceeded, dropping the rest", SimSnapshot::MAX_PROJECTILES);
+            break;
+        }
+    }
+
+    // 4. Boss
+    out.hasBoss = _boss != nullptr;
+    if (_boss) _boss->saveSnapshot(out.boss);
+
+    // 5. 随机流
+    out.captureRandom();
+}
+
+bool HelloWorld::restoreSnapshot(const SimSnapshot& in)
+{
+    HK_PROFILE_ZONE("HelloWorld::restoreSnapshot");
+
+    if (!in.isValid()) {
+        HK_LOG_WARN(GENERAL, "Snapshot: invalid header, restore rejected");
+        return false;
+    }
+    // 跨关卡恢复需要重新加载地图，不在快照的职责内
+    if (in.level != _currentLevel || in.hasBoss != (_boss != nullptr) || !_player) {
+        HK_LOG_WARN(GENERAL, "Snapshot: level %d does not match current level %d", in.level, _currentLevel);
+        return false;
+    }
+
+    // 1. 怪物：还在的直接写回，已经没了的重新创建，快照里没有的移除
+    for (int tag : LEVEL1_ENTITY_TAGS)
+    {
+        const EntitySnapshot* e = in.findEntity(tag);
+        auto node = _gameLayer->getChildByTag(tag);
+        if (!e) {
+            if (node) node->removeFromParent();
+            continue;
+        }
+        if (!node) node = spawnEntity(tag);
+        if (!node) continue;
+
+        switch (e->kind)
+        {
+        case EntitySnapshot::Kind::ENEMY:  if (auto n = dynamic_cast<Enemy*>(node)) n->restoreSnapshot(*e); break;
+        case EntitySnapshot::Kind::ZOMBIE: if (auto n = dynamic_cast<Zombie*>(node)) n->restoreSnapshot(*e); break;
+        case EntitySnapshot::Kind::SPIKE:  if (auto n = dynamic_cast<Spike*>(node)) n->restoreSnapshot(*e); break;
+        case EntitySnapshot::Kind::BUZZER: if (auto n = dynamic_cast<Buzzer*>(node)) n->restoreSnapshot(*e); break;
+        default: break;
+        }
+    }
+
+    // 2. 罐子：快照里有但已经碎了的，整组重建 (Jar 没有"复原"的表现)
+    if (_currentLevel == 2)
+    {
+        bool rebuild = false;
+        for (int i = 0; i < in.jarCount && !rebuild; i++)
+        {
+            bool alive = false;
+            for (auto jar : _jars) {
+                if (jar && jar->getTag() == in.jars[i].tag && !jar->isDestroyed()) { alive = true; break; }
+            }
+            rebuild = !alive;
+        }
+        if (rebuild)
+        {
+            Vector<Node*> oldJars;
+            for (auto child : _gameLayer->getChildren()) {
+                if (dynamic_cast<Jar*>(child)) oldJars.pushBack(child);
+            }
+            for (auto old : oldJars) old->removeFromParent();
+            _jars.clear();
+            Jar::setupPuzzleJars(_gameLayer, _jars);
+        }
+
+        for (int i = _jars.size() - 1; i >= 0; i--)
+        {
+            auto jar = _jars.at(i);
+            const JarSnapshot* j = (jar && !jar->isDestroyed()) ? in.findJar(jar->getTag()) : nullptr;
+            if (j) {
+                jar->restoreSnapshot(*j);
+            }
+            else {
+                if (jar) jar->removeFromParent();
+                _jars.erase(i);
+            }
+        }
+    }
+
+    // 3. 复仇之魂道具
+    auto pickup = _gameLayer->getChildByTag(987);
+    if (in.hasSkillPickup && !pickup)
+    {
+        auto fireball = Fireball::create("fireball/idle/fireball_1.png");
+        if (fireball)
+        {
+            fireball->setPosition(Vec2(5529.0f, 650.0f));
+            fireball->setTag(987);
+            _gameLayer->addChild(fireball, 5);
+        }
+    }
+    else if (!in.hasSkillPickup && pickup)
+    {
+        pickup->removeFromParent();
+    }
+
+    // 4. 弹幕：全部清掉按快照重建 (数量少，没必要逐个对应)
+    auto children = _gameLayer->getChildren();
+    for (auto child : children)
+    {
+        auto fireball = dynamic_cast<Fireball*>(child);
+        if ((fireball && fireball->getTag() == 5000) || dynamic_cast<FKFireball*>(child) || dynamic_cast<FKShockwave*>(child)) {
+            child->removeFromParent();
+        }
+    }
+    for (int i = 0; i < in.projectileCount; i++)
+    {
+        const ProjectileSnapshot& p = in.projectiles[i];
+        switch (p.kind)
+        {
+        case ProjectileSnapshot::Kind::PLAYER_FIREBALL:
+            if (auto fireball = Fireball::create("fireball/idle/fireball_1.png")) {
+                fireball->setTag(5000);
+                fireball->restoreSnapshot(p);
+                _gameLayer->addChild(fireball, 10);
+            }
+            break;
+        case ProjectileSnapshot::Kind::BOSS_FIREBALL:
+            if (auto fireball = FKFireball::create("boss/rampageAttack/fk-fireball.png")) {
+                fireball->restoreSnapshot(p);
+                _gameLayer->addChild(fireball, 7);
+            }
+            break;
+        case ProjectileSnapshot::Kind::SHOCKWAVE:
+            if (auto shockwave = FKShockwave::create("boss/shockwaveAttack/fk-shockwave.png", p.dir)) {
+                shockwave->restoreSnapshot(p);
+                _gameLayer->addChild(shockwave, 7);
+            }
+            break;
+        }
+    }
+
+    // 5. Boss、主角
+    _bossTriggered = in.bossTriggered;
+    _bossHitCombo = in.bossHitCombo;
+    if (_boss && in.hasBoss) _boss->restoreSnapshot(in.boss);
+
+    _player->restoreSnapshot(in.player);
+    updatePlayerMovement(); // 按住的方向键继续生效
+
+    // 6. 随机流放在最后：上面的恢复过程不能消耗随机数
+    in.restoreRandom();
+    _simFrame = in.frame;
+
+    HK_LOG_INFO(GENERAL, "Snapshot: restored frame %u (level %d)", in.frame, in.level);
+    return true;
+}
@@ -29,6 +29,9 @@
 #include "Player.h"
 #include "Jar.h"
 #include "GameEntity.h"
+#include "SimSnapshot.h"
+#include "SceneCommandBuffer.h"
+#include "InputQueue.h"
 
 class HelloWorld : public cocos2d::Scene
 {
@@ -42,19 +45,33 @@ public:
 
     virtual void update(float dt) override;
 
+    virtual void onExit() override;
+
     // ĬϵĹرհťص˳Ϸ
     void menuCloseCallback(cocos2d::Ref* pSender);
 
     void onPlayerDeath(); // 
 
+    //  (㸴 / ع)ֵֻ֧ǰؿڻָؿһʱ restore  false
+    void captureSnapshot(SimSnapshot& out);
+    bool restoreSnapshot(const SimSnapshot& in);
+
+    // ǰס淨 (InputBit)̡¼طźͻعطŶͨ·
+    void setInputBits(uint16_t bits);
+
     // һк cocos     
     CREATE_FUNC(HelloWorld);
 
+    // عֱ update / ؿл
+    friend class ScenarioRunner;
+
 private: 
     Player* _player; 
 
     //ͼеĵο
     std::vector<cocos2d::Rect> _groundRects;
+    // ڶ  + Ӷƽ̨ (ÿ֡·)
+    std::vector<cocos2d::Rect> _dynamicGroundRects;
 
     // ͼײĸ
     void parseMapCollisions(cocos2d::TMXTiledMap* map);
@@ -65,11 +82,31 @@ private:
     // Boss ָ
     class Boss* _boss;
     bool _bossTriggered;  // Boss ǷѾ
+    int _bossHitCombo = 0; // ƽ Boss ļ 3 λ 1 
 
     // Boss ߼뺯
     void updateBossInteraction(float dt); //  Boss 塢ҹ Boss
     void updateBossProjectiles(float dt); //  FKFireball  FKShockwave
 
+    // Boss Ļ JobSystem ϲƽص߳ٽ
+    struct ProjectileWork
+    {
+        class FKFireball* fireball;     // ָֻһǿ
+        class FKShockwave* shockwave;
+        cocos2d::Rect hitbox;           // step ֮ײZERO = ֡Ƴ
+    };
+    std::vector<ProjectileWork> _projectileWork;
+
+    // ĸ֪/ͬܣײص̰߳˳
+    struct AIWork
+    {
+        class Enemy* enemy;             // ָֻһǿ
+        class Zombie* zombie;
+        class Buzzer* buzzer;
+    };
+    std::vector<AIWork> _aiWork;
+    SceneCommandBuffer _sceneCommands;
+
     //״̬־λ
     bool _isLeftPressed = false;
     bool _isRightPressed = false;
@@ -79,6 +116,12 @@ private:
     // ݵǰ״̬ٶ
     void updatePlayerMovement();
 
+    uint16_t _inputBits = 0;
+    // ¼ȽУÿģ⿪ʼʱͳһȡ (update ͷ)
+    InputQueue _inputQueue;
+    // λĹؽ  -> λ 
+    void refreshKeyTable();
+
     // ʾǩ
     cocos2d::Label* _coordLabel;
 
@@ -103,14 +146,32 @@ private:
     void switchToLevel2FromRight();
     void switchToLevel3();
 
+    // ========================================
+    //  / 
+    // ========================================
+    uint32_t _simFrame = 0;          // ģ֡ ()
+    double _simTime = 0.0;           // ۼģʱ ()еʱ
+    SimSnapshot _checkpoint = {};    // ؿһ֡״̬ʱָ
+    int _checkpointLevel = 0;        // _checkpoint һ (0 = û)
+    bool _pendingRespawn = false;    // ״̬һ֡ͷٻָ
+
+    // Level 1 Ĺﰴ Tag  (init Ϳջָ)
+    cocos2d::Node* spawnEntity(int tag);
+    void respawnAtLevelStart();      // ûпüʱľ߼͵ؿ
+
     // ========================================
     // ͣϵͳر뺯
     // ========================================
     bool _isGamePaused;           // ϷǷͣ
-    cocos2d::Layer* _pauseLayer;  // ͣ˵
+    class KeyBindingLayer* _pauseLayer;  // ͣ˵ (һͣʱ֮)
+    cocos2d::RenderTexture* _pauseSnapshot = nullptr; // ͣ˲Ļ涨
 
     void showPauseMenu();         // ʾͣ˵
     void hidePauseMenu();         // ͣ˵ (Ϸ)
+
+    // ݹͣ/ָڵϵĶ͵
+    static void pauseNodeTree(cocos2d::Node* node);
+    static void resumeNodeTree(cocos2d::Node* node);
 };
 
 #endif // __HELLOWORLD_SCENE_H__
\ No newline at end of file
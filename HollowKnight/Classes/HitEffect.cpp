@@ -1,8 +1,10 @@
 #include "HitEffect.h"
+#include "AllocTracker.h"
 
 USING_NS_CC;
 
 void HitEffect::play(Node* parent, const Vec2& center, float size, float duration) {
+    HK_ALLOW_ALLOC_SCOPE("HitEffect::play");
     // ֡ˮƽ˳hit_crack0, hit_crack1, hit_crack2
     Vector<SpriteFrame*> frames;
     for (int i = 0; i < 3; ++i) {
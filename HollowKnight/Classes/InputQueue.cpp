@@ -0,0 +1,121 @@
+#include "InputQueue.h"
+
+InputQueue::InputQueue()
+{
+    static_assert((CAPACITY & (CAPACITY - 1)) == 0, "InputQueue capacity must be a power of two");
+    clearBindings();
+    for (int i = 0; i < 16; i++) {
+        _window[i] = 0.0f;
+        _expire[i] = 0.0;
+    }
+    setBufferWindow(InputBit::JUMP, Config::Input::JUMP_BUFFER);
+    setBufferWindow(InputBit::ATTACK, Config::Input::ATTACK_BUFFER);
+    setBufferWindow(InputBit::CAST_SPELL, Config::Input::CAST_BUFFER);
+}
+
+int InputQueue::bitIndex(uint16_t bit)
+{
+    int index = 0;
+    while (bit > 1) {
+        bit >>= 1;
+        index++;
+    }
+    return index;
+}
+
+// ============================================================
+// λ
+// ============================================================
+void InputQueue::clearBindings()
+{
+    for (auto& bits : _keyBits) bits = 0;
+}
+
+void InputQueue::bind(int keyCode, uint16_t bits)
+{
+    // ͬһԶӦ
+    if ((unsigned)keyCode < (unsigned)KEY_TABLE_SIZE) _keyBits[keyCode] |= bits;
+}
+
+// ============================================================
+// ߣֻд _tail
+// ============================================================
+bool InputQueue::push(uint16_t bits, bool down, double time)
+{
+    bits &= InputBit::MASK;
+    if (!bits) return false;
+
+    uint32_t tail = _tail.load(std::memory_order_relaxed);
+    if (tail - _head.load(std::memory_order_acquire) >= (uint32_t)CAPACITY) {
+        _droppedCount++;
+        return false;
+    }
+    Event& ev = _ring[tail & (CAPACITY - 1)];
+    ev.time = time;
+    ev.bits = bits;
+    ev.down = down;
+    _tail.store(tail + 1, std::memory_order_release);
+    return true;
+}
+
+// ============================================================
+// ߣֻд _head
+// ============================================================
+bool InputQueue::beginStep(double time, uint16_t& outBits)
+{
+    // ڵĻ
+    for (uint16_t rest = _buffered; rest; rest &= rest - 1) {
+        uint16_t bit = rest & (uint16_t)-rest;
+        if (_expire[bitIndex(bit)] <= time) _buffered &= ~bit;
+    }
+
+    // һֹİأѾɿһҲҪ㰴
+    uint16_t pressed = 0;
+    uint32_t head = _head.load(std::memory_order_relaxed);
+    uint32_t tail = _tail.load(std::memory_order_acquire);
+    for (; head != tail; head++)
+    {
+        const Event& ev = _ring[head & (CAPACITY - 1)];
+        if (ev.down) {
+            uint16_t edge = ev.bits & ~_held;
+            pressed |= edge;
+            for (uint16_t rest = edge & _bufferable; rest; rest &= rest - 1) {
+                uint16_t bit = rest & (uint16_t)-rest;
+                _buffered |= bit;
+                _expire[bitIndex(bit)] = ev.time + _window[bitIndex(bit)];
+            }
+            _held |= ev.bits;
+        }
+        else {
+            _held &= ~ev.bits;
+        }
+    }
+    _head.store(head, std::memory_order_release);
+
+    outBits = _held | pressed | _buffered;
+    bool changed = outBits != _lastBits;
+    _lastBits = outBits;
+    return changed;
+}
+
+void InputQueue::consume(uint16_t bits)
+{
+    _buffered &= ~bits;
+}
+
+void InputQueue::setBufferWindow(uint16_t bit, float seconds)
+{
+    if (!bit) return;
+    _window[bitIndex(bit)] = seconds > 0.0f ? seconds : 0.0f;
+    if (seconds > 0.0f) _bufferable |= bit;
+    else _bufferable &= ~bit;
+    _buffered &= _bufferable;
+}
+
+void InputQueue::reset()
+{
+    _head.store(_tail.load(std::memory_order_acquire), std::memory_order_release);
+    _held = 0;
+    _buffered = 0;
+    _lastBits = 0;
+}
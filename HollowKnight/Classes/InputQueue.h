@@ -0,0 +1,83 @@
+#ifndef __INPUT_QUEUE_H__
+#define __INPUT_QUEUE_H__
+
+#include "SimConfig.h"
+#include "InputRecorder.h"
+#include <atomic>
+#include <cstdint>
+
+// ==========================================
+//  ( cocos)
+// -  -> λ һƽ飬¼һ±Уλɵ÷ؽ
+// - ¼ʱһ/ߵζУ
+//   ÿģ⿪ʼʱ (beginStep) ˳ȡ꣬һ֡ڰɿļҲһ
+// - Ծ//ʩ뻺壺º Config::Input::*_BUFFER һֱס
+//   ֱЧ (consume) ڣסŵļӰ
+// ʱ beginStep ʱ䶼ģʱ (ۼӵ dt)ǽʱӣ
+// ֻܳ֡ȡ dtͻ޹
+// beginStep һЧλ¼/ع¼Ҳһ
+// ==========================================
+class InputQueue
+{
+public:
+    static const int KEY_TABLE_SIZE = 256;                  //  cocos ȫ
+    static const uint16_t PAUSE_BIT = 1 << 15;              // ֻڼλã
+    static const int CAPACITY = Config::Input::QUEUE_CAPACITY;
+
+    InputQueue();
+
+    // ---------------- λ ----------------
+    void clearBindings();
+    void bind(int keyCode, uint16_t bits);
+    uint16_t bitsForKey(int keyCode) const
+    {
+        return (unsigned)keyCode < (unsigned)KEY_TABLE_SIZE ? _keyBits[keyCode] : 0;
+    }
+    // ÷¼ǰһλģ汾ؽ
+    uint32_t getBindingVersion() const { return _bindingVersion; }
+    void setBindingVersion(uint32_t version) { _bindingVersion = version; }
+
+    // ----------------  (ص) ----------------
+    // ʱ false
+    bool push(uint16_t bits, bool down, double time);
+
+    // ----------------  (ģⲽ) ----------------
+    // ȡУһЧλһͬʱ true
+    bool beginStep(double time, uint16_t& outBits);
+    // ѾЧĻ (סļһȻЧ)
+    void consume(uint16_t bits);
+    // ĳλĻʱ ()0 = 
+    void setBufferWindow(uint16_t bit, float seconds);
+    // նка״̬ ( / ص˵)
+    void reset();
+
+    uint16_t getHeldBits() const { return _held; }
+    int getDroppedCount() const { return _droppedCount; }
+
+private:
+    struct Event
+    {
+        double time;
+        uint16_t bits;
+        bool down;
+    };
+
+    static int bitIndex(uint16_t bit);
+
+    uint16_t _keyBits[KEY_TABLE_SIZE];
+    uint32_t _bindingVersion = 0;
+
+    Event _ring[CAPACITY];
+    std::atomic<uint32_t> _head{ 0 };   // д
+    std::atomic<uint32_t> _tail{ 0 };   // д
+
+    uint16_t _held = 0;                 // ǰס
+    uint16_t _buffered = 0;             //  (ûЧҲû)
+    uint16_t _bufferable = 0;           // Щλл
+    uint16_t _lastBits = 0;
+    float _window[16];
+    double _expire[16];
+    int _droppedCount = 0;
+};
+
+#endif // __INPUT_QUEUE_H__
@@ -0,0 +1,204 @@
+#include "InputRecorder.h"
+#include "config.h"
+#include "cocos2d.h"
+#include <algorithm>
+#include <cstring>
+
+InputRecorder* InputRecorder::s_instance = nullptr;
+
+namespace {
+    const char MAGIC[4] = { 'H', 'K', 'R', 'P' };
+    const size_t HEADER_BYTES = 4 + 2 + 2 + 8;
+
+    void putU16(std::string& out, uint16_t v)
+    {
+        out += (char)(v & 0xFF);
+        out += (char)(v >> 8);
+    }
+
+    void putU64(std::string& out, uint64_t v)
+    {
+        for (int i = 0; i < 8; i++) out += (char)((v >> (i * 8)) & 0xFF);
+    }
+
+    void putF32(std::string& out, float v)
+    {
+        uint32_t u;
+        memcpy(&u, &v, 4);
+        for (int i = 0; i < 4; i++) out += (char)((u >> (i * 8)) & 0xFF);
+    }
+
+    // ȡα꣬Խʱ ok Ϊ false
+    struct Reader
+    {
+        const std::string& data;
+        size_t pos;
+        bool ok;
+
+        uint64_t read(int bytes)
+        {
+            if (pos + bytes > data.size()) { ok = false; return 0; }
+            uint64_t v = 0;
+            for (int i = 0; i < bytes; i++) v |= (uint64_t)(unsigned char)data[pos + i] << (i * 8);
+            pos += bytes;
+            return v;
+        }
+    };
+}
+
+// ============================================================
+// 
+// ============================================================
+bool InputRecording::load(const std::string& path)
+{
+    FILE* file = fopen(path.c_str(), "rb");
+    if (!file) return false;
+
+    std::string data;
+    char buf[4096];
+    size_t n;
+    while ((n = fread(buf, 1, sizeof(buf), file)) > 0) data.append(buf, n);
+    fclose(file);
+    return decode(data);
+}
+
+bool InputRecording::decode(const std::string& data)
+{
+    frames.clear();
+    if (data.size() < HEADER_BYTES || memcmp(data.data(), MAGIC, 4) != 0) return false;
+
+    Reader r = { data, 4, true };
+    uint16_t version = (uint16_t)r.read(2);
+    if (version != VERSION) return false;
+    startLevel = (int)r.read(2);
+    seed = r.read(8);
+
+    float dt = 0.0f;
+    while (r.pos < data.size())
+    {
+        uint16_t word = (uint16_t)r.read(2);
+        if (word & FLAG_DT) {
+            uint32_t u = (uint32_t)r.read(4);
+            memcpy(&dt, &u, 4);
+        }
+        uint32_t count = 1;
+        if (word & FLAG_REPEAT) count += (uint32_t)r.read(2);
+        // ¼;ɱʱһܲ
+        if (!r.ok) break;
+
+        InputFrame frame = { (uint16_t)(word & InputBit::MASK), dt };
+        frames.insert(frames.end(), count, frame);
+    }
+    return true;
+}
+
+// ============================================================
+// 
+// ============================================================
+void InputRecorder::encodeHeader(std::string& out, uint64_t seed, int startLevel)
+{
+    out.append(MAGIC, 4);
+    putU16(out, InputRecording::VERSION);
+    putU16(out, (uint16_t)startLevel);
+    putU64(out, seed);
+}
+
+void InputRecorder::encodeRun(std::string& out, uint16_t bits, float dt, uint32_t count, float& lastDt)
+{
+    while (count > 0)
+    {
+        uint32_t chunk = std::min<uint32_t>(count, 0x10000);
+        uint16_t word = bits & InputBit::MASK;
+        if (dt != lastDt) word |= InputRecording::FLAG_DT;
+        if (chunk > 1) word |= InputRecording::FLAG_REPEAT;
+
+        putU16(out, word);
+        if (word & InputRecording::FLAG_DT) putF32(out, dt);
+        if (word & InputRecording::FLAG_REPEAT) putU16(out, (uint16_t)(chunk - 1));
+
+        lastDt = dt;
+        count -= chunk;
+    }
+}
+
+// ============================================================
+// ¼
+// ============================================================
+InputRecorder* InputRecorder::getInstance()
+{
+    if (!s_instance) {
+        s_instance = new InputRecorder();
+        s_instance->setEnabled(Config::Replay::RECORD_SESSIONS);
+    }
+    return s_instance;
+}
+
+void InputRecorder::beginSession(const void* owner, const std::string& path, uint64_t seed, int startLevel)
+{
+    endSession();
+    if (!_enabled) return;
+
+    std::string prevPath = path + "_prev";
+    remove(prevPath.c_str());
+    rename(path.c_str(), prevPath.c_str());
+
+    _file = fopen(path.c_str(), "wb");
+    if (!_file) {
+        CCLOG("InputRecorder: cannot open %s", path.c_str());
+        return;
+    }
+
+    _owner = owner;
+    _pending.clear();
+    _pending.reserve(4096);
+    encodeHeader(_pending, seed, startLevel);
+    _runCount = 0;
+    _lastDt = 0.0f;
+    _frames = 0;
+    _framesSinceFlush = 0;
+    flushFile();
+    CCLOG("InputRecorder: recording to %s (seed %llu)", path.c_str(), (unsigned long long)seed);
+}
+
+void InputRecorder::recordStep(const void* owner, uint16_t bits, float dt)
+{
+    if (!_file || owner != _owner) return;
+
+    if (_runCount > 0 && (bits != _runBits || dt != _runDt)) flushRun();
+    _runBits = bits;
+    _runDt = dt;
+    _runCount++;
+    _frames++;
+
+    if (++_framesSinceFlush >= Config::Replay::FLUSH_INTERVAL_FRAMES) {
+        flushRun();
+        flushFile();
+    }
+}
+
+void InputRecorder::endSession(const void* owner)
+{
+    if (!_file || (owner && owner != _owner)) return;
+    flushRun();
+    flushFile();
+    fclose(_file);
+    _file = nullptr;
+    _owner = nullptr;
+    CCLOG("InputRecorder: session closed, %d frames", _frames);
+}
+
+void InputRecorder::flushRun()
+{
+    if (_runCount == 0) return;
+    encodeRun(_pending, _runBits, _runDt, _runCount, _lastDt);
+    _runCount = 0;
+}
+
+void InputRecorder::flushFile()
+{
+    if (!_file || _pending.empty()) return;
+    fwrite(_pending.data(), 1, _pending.size(), _file);
+    fflush(_file);
+    _pending.clear();
+    _framesSinceFlush = 0;
+}
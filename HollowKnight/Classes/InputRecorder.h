@@ -0,0 +1,106 @@
+#ifndef __INPUT_RECORDER_H__
+#define __INPUT_RECORDER_H__
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+// ==========================================
+// ¼ / ط
+// ÿһ (HelloWorld һ) ¼Ự + ÿһģλ dt
+//  SimRandom ͷģʽ֡ (ScenarioRunner::runReplay)
+//
+// ļʽ (С)
+//   ͷ   "HKRP" | u16 汾 | u16 ʼؿ | u64 
+//   ֮¼ÿ
+//     u16   12 λλFLAG_DT λʱ f32  dtFLAG_REPEAT λʱ u16 ظ
+//   ͬ + ͬ dt ֡ϲһdt ֻڱ仯ʱд
+// ¼ƹж׷д̣̿/ʱҲ´󲿷ּ¼
+// ==========================================
+
+// λ (ļλӰط)
+namespace InputBit {
+    enum : uint16_t {
+        MOVE_LEFT  = 1 << 0,
+        MOVE_RIGHT = 1 << 1,
+        MOVE_UP    = 1 << 2,
+        MOVE_DOWN  = 1 << 3,
+        JUMP       = 1 << 4,
+        ATTACK     = 1 << 5,
+        FOCUS      = 1 << 6,
+        CAST_SPELL = 1 << 7,
+        DREAM_NAIL = 1 << 8,
+        MASK       = 0x0FFF
+    };
+}
+
+// һģ⣺һʼʱס + һ dt
+struct InputFrame
+{
+    uint16_t bits;
+    float dt;
+};
+
+struct InputRecording
+{
+    static const uint16_t VERSION = 1;
+    static const uint16_t FLAG_DT = 1 << 14;
+    static const uint16_t FLAG_REPEAT = 1 << 15;
+
+    uint64_t seed = 0;
+    int startLevel = 1;
+    std::vector<InputFrame> frames;
+
+    bool load(const std::string& path);
+    bool decode(const std::string& data);
+};
+
+class InputRecorder
+{
+public:
+    static InputRecorder* getInstance();
+
+    // ص beginSession ¼ (ط/عʱر)
+    void setEnabled(bool enabled) { _enabled = enabled; }
+    bool isEnabled() const { return _enabled; }
+
+    // µһֿʼ֮ǰ¼Ϊ *_prev һ
+    // owner Ƿ¼Ƶĳлʱ³ init ھɳ onExit
+    // ɳ recordStep/endSession Ӱµһ
+    void beginSession(const void* owner, const std::string& path, uint64_t seed, int startLevel);
+    // ÿģ⿪ʼʱһ
+    void recordStep(const void* owner, uint16_t bits, float dt);
+    // дʣ¼رļ (owner Ϊʱر)
+    void endSession(const void* owner = nullptr);
+
+    bool isRecording() const { return _file != nullptr; }
+    int getFrameCount() const { return _frames; }
+
+    //  (¼ƺͲԹ)
+    static void encodeHeader(std::string& out, uint64_t seed, int startLevel);
+    static void encodeRun(std::string& out, uint16_t bits, float dt, uint32_t count, float& lastDt);
+
+private:
+    InputRecorder() = default;
+    static InputRecorder* s_instance;
+
+    void flushRun();
+    void flushFile();
+
+    bool _enabled = true;
+    const void* _owner = nullptr;
+    FILE* _file = nullptr;
+    std::string _pending;   // ѱ롢ûд̵ļ¼
+
+    // ںϲһͬ
+    uint16_t _runBits = 0;
+    float _runDt = 0.0f;
+    uint32_t _runCount = 0;
+    float _lastDt = 0.0f;
+
+    int _frames = 0;
+    int _framesSinceFlush = 0;
+};
+
+#endif // __INPUT_RECORDER_H__
@@ -1,5 +1,7 @@
 #include "Jar.h"
 #include "DreamDialogue.h"
+#include "config.h"
+#include "Log.h"
 
 Jar* Jar::create(const std::string& jarImage, const Vec2& position)
 {
@@ -53,6 +55,7 @@ bool Jar::init(const std::string& jarImage, const Vec2& position)
     
     // 3. ýڵλ
     this->setPosition(position);
+    _homePosition = position;
     
     // 4. ׳渽Ŷ
     playGrubAttachAnimation();
@@ -79,7 +82,7 @@ void Jar::setupPuzzleJars(Node* parent, Vector<Jar*>& outList)
     // -----------------------------------------------------
     auto jar1 = Jar::create(imagePath, Vec2(1700.0f, jarY));
     if (jar1) {
-        jar1->setDreamThought("Save me...I hold the flame..."); // ֮
+        jar1->setDreamThought(Config::Dialogue::THOUGHT_JAR_1); // ֮
         jar1->setTag(990); // ԭе tag ߼߲Ҳ
 
         parent->addChild(jar1, zOrder);
@@ -91,7 +94,7 @@ void Jar::setupPuzzleJars(Node* parent, Vector<Jar*>& outList)
     // -----------------------------------------------------
     auto jar2 = Jar::create(imagePath, Vec2(2400.0f, jarY));
     if (jar2) {
-        jar2->setDreamThought("...The first one... holds the flame....");
+        jar2->setDreamThought(Config::Dialogue::THOUGHT_JAR_2);
         jar2->setTag(989);
 
         parent->addChild(jar2, zOrder);
@@ -103,7 +106,7 @@ void Jar::setupPuzzleJars(Node* parent, Vector<Jar*>& outList)
     // -----------------------------------------------------
     auto jar3 = Jar::create(imagePath, Vec2(3100.0f, jarY));
     if (jar3) {
-        jar3->setDreamThought("...The middle one... is empty..."); // ʾ
+        jar3->setDreamThought(Config::Dialogue::THOUGHT_JAR_3); // ʾ
 
         // ؼıǩ 888 HelloWorld Ⲣ
         jar3->setTag(888);
@@ -151,7 +154,7 @@ void Jar::onDreamNailHit()
     //  Ʈ
     std::string text = this->getDreamThought();
     if (!text.empty()) {
-        auto dialogue = DreamDialogue::create(text);
+        auto dialogue = DreamDialogue::acquire(text);
         if (dialogue) {
             dialogue->setPosition(this->getPosition() + Vec2(0, 60));
             this->getParent()->addChild(dialogue, 200);
@@ -159,7 +162,7 @@ void Jar::onDreamNailHit()
         }
     }
 
-    CCLOG("Jar Dream Logic Executed!");
+    HK_LOG_DEBUG(COMBAT, "Jar Dream Logic Executed!");
 }
 
 Rect Jar::getTopPlatformBox() const
@@ -198,7 +201,7 @@ void Jar::takeDamage()
 
     if (_health > 0)
     {
-        CCLOG("Jar hit! HP remaining: %d", _health);
+        HK_LOG_DEBUG(COMBAT, "Jar hit! HP remaining: %d", _health);
 
         // ҶЧ
         auto moveLeft = MoveBy::create(0.05f, Vec2(-5, 0));
@@ -271,11 +274,11 @@ void Jar::playGrubAttachAnimation()
         auto repeatForever = RepeatForever::create(animate);
         
         _grubSprite->runAction(repeatForever);
-        CCLOG("Grub attach animation started (looping)");
+        HK_LOG_TRACE(ANIM, "Grub attach animation started (looping)");
     }
     else
     {
-        CCLOG("Warning: Failed to load attach animation frames");
+        HK_LOG_WARN(ANIM, "Warning: Failed to load attach animation frames");
     }
 }
 
@@ -319,7 +322,7 @@ void Jar::playGrubFreeAnimation()
             nullptr
         ));
         
-        CCLOG("Grub free animation started (once)");
+        HK_LOG_TRACE(ANIM, "Grub free animation started (once)");
         
         // ӳٺƳڵ
         this->runAction(Sequence::create(
@@ -330,7 +333,7 @@ void Jar::playGrubFreeAnimation()
     }
     else
     {
-        CCLOG("Warning: Failed to load free animation frames");
+        HK_LOG_WARN(ANIM, "Warning: Failed to load free animation frames");
     }
 }
 
@@ -338,3 +341,25 @@ void Jar::onJarBroken()
 {
     // ЧЧ
 }
+
+// =========================================================
+//  
+// =========================================================
+void Jar::saveSnapshot(JarSnapshot& out) const
+{
+    out.tag = this->getTag();
+    out.health = _health;
+}
+
+void Jar::restoreSnapshot(const JarSnapshot& in)
+{
+    this->stopAllActions();
+    this->unscheduleAllCallbacks();
+    this->setPosition(_homePosition);
+    if (_jarSprite) {
+        _jarSprite->stopAllActions();
+        _jarSprite->setColor(Color3B::WHITE);
+    }
+    _isInvincible = false;
+    _health = in.health;
+}
@@ -2,6 +2,7 @@
 #define __JAR_H__
 #include "GameEntity.h" // 
 #include "cocos2d.h"
+#include "SimSnapshot.h"
 
 USING_NS_CC;
 
@@ -50,12 +51,17 @@ public:
 
     virtual bool isValidEntity() const override { return !_isDestroyed; }
 
+    // գֻûĹ (˵ɳֱƳ)
+    void saveSnapshot(JarSnapshot& out) const;
+    void restoreSnapshot(const JarSnapshot& in);
+
 private:
     Sprite* _jarSprite;      // Ӿ
     Sprite* _grubSprite;     // ׳澫
     bool _isDestroyed;       // Ƿѱݻ
     bool _isInvincible;
 	int _health;			   // ֵ
+    Vec2 _homePosition;      // ڷλ (ָʱλ)
     // 洢
     std::string _dreamThought;
 
@@ -0,0 +1,187 @@
+#include "JobSystem.h"
+
+namespace {
+    thread_local int s_threadIndex = 0;
+}
+
+JobSystem* JobSystem::getInstance()
+{
+    static JobSystem s_instance;
+    return &s_instance;
+}
+
+JobSystem::~JobSystem()
+{
+    stop();
+}
+
+int JobSystem::getThreadIndex()
+{
+    return s_threadIndex;
+}
+
+// ============================================================
+//  / ֹͣ
+// ============================================================
+void JobSystem::start(int workers)
+{
+    if (isRunning()) return;
+    if (workers <= 0) workers = (int)std::thread::hardware_concurrency() - 1;
+    if (workers <= 0) return; // ˣȫ߳
+
+    _queues.clear();
+    for (int i = 0; i <= workers; i++) _queues.emplace_back(new WorkQueue());
+
+    _running.store(true, std::memory_order_release);
+    for (int i = 1; i <= workers; i++) _threads.emplace_back(&JobSystem::workerLoop, this, i);
+}
+
+void JobSystem::stop()
+{
+    if (!isRunning()) return;
+    {
+        std::lock_guard<std::mutex> lock(_sleepMutex);
+        _running.store(false, std::memory_order_release);
+    }
+    _wake.notify_all();
+    for (auto& thread : _threads) thread.join();
+    _threads.clear();
+    _queues.clear();
+}
+
+// ============================================================
+// 
+// ============================================================
+void JobSystem::WorkQueue::store(int64_t index, const Job& job)
+{
+    Slot& slot = slots[index % Config::Jobs::QUEUE_CAPACITY];
+    slot.fn.store(job.fn, std::memory_order_relaxed);
+    slot.ctx.store(job.ctx, std::memory_order_relaxed);
+    slot.begin.store(job.begin, std::memory_order_relaxed);
+    slot.end.store(job.end, std::memory_order_relaxed);
+    slot.counter.store(job.counter, std::memory_order_relaxed);
+}
+
+void JobSystem::WorkQueue::load(int64_t index, Job& out) const
+{
+    const Slot& slot = slots[index % Config::Jobs::QUEUE_CAPACITY];
+    out.fn = slot.fn.load(std::memory_order_relaxed);
+    out.ctx = slot.ctx.load(std::memory_order_relaxed);
+    out.begin = slot.begin.load(std::memory_order_relaxed);
+    out.end = slot.end.load(std::memory_order_relaxed);
+    out.counter = slot.counter.load(std::memory_order_relaxed);
+}
+
+// ̵ֻ߳
+bool JobSystem::WorkQueue::push(const Job& job)
+{
+    int64_t b = bottom.load(std::memory_order_relaxed);
+    int64_t t = top.load(std::memory_order_acquire);
+    if (b - t >= Config::Jobs::QUEUE_CAPACITY) return false;
+    store(b, job);
+    bottom.store(b + 1, std::memory_order_release); // ͵̶߳ bottom ʱλѿɼ
+    return true;
+}
+
+// ̵ֻ߳ãȰ bottom һռסһٿûк͵߳ײ
+bool JobSystem::WorkQueue::pop(Job& out)
+{
+    int64_t b = bottom.load(std::memory_order_relaxed) - 1;
+    bottom.store(b, std::memory_order_seq_cst);
+    int64_t t = top.load(std::memory_order_seq_cst);
+    if (t > b) {
+        bottom.store(b + 1, std::memory_order_relaxed); // ǿյ
+        return false;
+    }
+    load(b, out);
+    if (t < b) return true; // ʣֹһ͵߳һ
+
+    // ֻʣһ͵߳ top
+    bool won = top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+    bottom.store(b + 1, std::memory_order_relaxed);
+    return won;
+}
+
+bool JobSystem::WorkQueue::steal(Job& out)
+{
+    int64_t t = top.load(std::memory_order_seq_cst);
+    int64_t b = bottom.load(std::memory_order_seq_cst);
+    if (t >= b) return false;
+
+    // ȶtop ûƽ֮ǰ̲߳Ḳһʧܶ
+    load(t, out);
+    return top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+}
+
+// ============================================================
+// Ͷ / ִ
+// ============================================================
+void JobSystem::execute(const Job& job)
+{
+    job.fn(job.ctx, job.begin, job.end);
+    if (job.counter) job.counter->pending.fetch_sub(1, std::memory_order_acq_rel);
+}
+
+void JobSystem::submit(const Job& job)
+{
+    if (job.counter) job.counter->pending.fetch_add(1, std::memory_order_relaxed);
+
+    int self = s_threadIndex;
+    if (!isRunning() || self >= (int)_queues.size() || !_queues[self]->push(job)) {
+        execute(job); // ûˣ͵ִ
+        return;
+    }
+    // ȷٿû˯ ( workerLoop ˳෴һܿԷ)
+    _queued.fetch_add(1, std::memory_order_seq_cst);
+    if (_sleepers.load(std::memory_order_seq_cst) > 0) {
+        // һ˯߳Ҫôû (ῴ)ҪôѾ wait  (յ֪ͨ)
+        { std::lock_guard<std::mutex> lock(_sleepMutex); }
+        _wake.notify_one();
+    }
+}
+
+bool JobSystem::tryRunOne(int self)
+{
+    const int count = (int)_queues.size();
+    Job job;
+
+    // ȡԼģٴһ߳̿ʼ͵
+    bool found = _queues[self]->pop(job);
+    for (int i = 1; !found && i < count; i++) {
+        if (_queues[(self + i) % count]->steal(job)) {
+            found = true;
+            _steals.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+    if (!found) return false;
+
+    _queued.fetch_sub(1, std::memory_order_relaxed);
+    execute(job);
+    return true;
+}
+
+void JobSystem::wait(JobCounter& counter)
+{
+    int self = s_threadIndex;
+    while (counter.pending.load(std::memory_order_acquire) > 0)
+    {
+        if (!isRunning() || !tryRunOne(self)) std::this_thread::yield();
+    }
+}
+
+void JobSystem::workerLoop(int index)
+{
+    s_threadIndex = index;
+    while (_running.load(std::memory_order_acquire))
+    {
+        if (tryRunOne(index)) continue;
+
+        // ûɾ˯ֱͶݻֹͣ
+        std::unique_lock<std::mutex> lock(_sleepMutex);
+        _sleepers.fetch_add(1, std::memory_order_seq_cst);
+        _wake.wait(lock, [this]() {
+            return _queued.load(std::memory_order_seq_cst) > 0 || !_running.load(std::memory_order_acquire);
+        });
+        _sleepers.fetch_sub(1, std::memory_order_relaxed);
+    }
+}
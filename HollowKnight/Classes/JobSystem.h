@@ -0,0 +1,130 @@
+#ifndef __JOB_SYSTEM_H__
+#define __JOB_SYSTEM_H__
+
+#include "SimConfig.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// ==========================================
+// ϵͳ (ȡ cocos)
+// - ÿ߳һ˫˶УԼβȡ (ȳ)˾ȥ˵ͷ͵
+// - ߳ 0 ̣߳ʱԼҲڸɻյ
+// - ûĹ߳˯ϣͶʱ˯֪ͨ
+// - Ƕṹ (ָ +  + )Ͷݺִжڴ
+// - parallelFor ֻʺϴ㣺ﲻܸĳͼ
+//   setPosition / removeFromParent ޸ļǽ SceneCommandBufferص߳ύ
+// û start  (ԡͷģʽ) ʱֱڵִ߳
+// ==========================================
+
+struct JobCounter
+{
+    std::atomic<int> pending{ 0 };
+};
+
+struct Job
+{
+    void (*fn)(void* ctx, int begin, int end);
+    void* ctx;
+    int begin;
+    int end;
+    JobCounter* counter;
+};
+
+class JobSystem
+{
+public:
+    static JobSystem* getInstance();
+
+    // workers <= 0 ʱӲ߳ - 1
+    void start(int workers = Config::Jobs::WORKER_COUNT);
+    void stop();
+    bool isRunning() const { return !_threads.empty(); }
+
+    // ɻ߳ (߳ + ߳)
+    int getThreadCount() const { return (int)_threads.size() + 1; }
+    // ǰ̱߳ţ߳ (Լϵͳ߳) Ϊ 0߳ 1..N
+    static int getThreadIndex();
+
+    //  [0, count)  grain п鲢ִ fn(begin, end)ȫɺŷ
+    template <typename F>
+    void parallelFor(int count, int grain, const F& fn)
+    {
+        if (count <= 0) return;
+        grain = std::max(grain, 1);
+        if (!isRunning() || count <= grain) {
+            fn(0, count);
+            return;
+        }
+
+        // ߳ 4 ̫鷴˷ڵ
+        grain = std::max(grain, (count + getThreadCount() * 4 - 1) / (getThreadCount() * 4));
+
+        JobCounter counter;
+        for (int begin = 0; begin < count; begin += grain) {
+            submit({ &invokeRange<F>, (void*)&fn, begin, std::min(begin + grain, count), &counter });
+        }
+        wait(counter);
+    }
+
+    // Ͷݵǰ̵߳Ķ ( counter һ)
+    void submit(const Job& job);
+    // ȵ counter 㣬ڼæִ
+    void wait(JobCounter& counter);
+
+    // ۼƱ͵ߵ (Ƿ)
+    size_t getStealCount() const { return _steals.load(std::memory_order_relaxed); }
+
+private:
+    JobSystem() = default;
+    ~JobSystem();
+
+    template <typename F>
+    static void invokeRange(void* ctx, int begin, int end) { (*(const F*)ctx)(begin, end); }
+
+    //  Chase-Lev ˫˶ ()ֻ߳ bottom  push/pop߳ top  CAS ͵
+    // λֶζ relaxed ԭݵĿɼ bottom / top ϵ֤ͬ
+    struct WorkQueue
+    {
+        struct Slot
+        {
+            std::atomic<void (*)(void*, int, int)> fn{ nullptr };
+            std::atomic<void*> ctx{ nullptr };
+            std::atomic<int> begin{ 0 };
+            std::atomic<int> end{ 0 };
+            std::atomic<JobCounter*> counter{ nullptr };
+        };
+
+        Slot slots[Config::Jobs::QUEUE_CAPACITY];
+        std::atomic<int64_t> top{ 0 };      // ͵һ
+        std::atomic<int64_t> bottom{ 0 };   // Լһ
+
+        bool push(const Job& job);
+        bool pop(Job& out);
+        bool steal(Job& out);
+
+    private:
+        void store(int64_t index, const Job& job);
+        void load(int64_t index, Job& out) const;
+    };
+
+    bool tryRunOne(int self);
+    static void execute(const Job& job);
+    void workerLoop(int index);
+
+    std::vector<std::unique_ptr<WorkQueue>> _queues; // ± = ̱߳
+    std::vector<std::thread> _threads;
+    std::atomic<bool> _running{ false };
+    std::atomic<int> _queued{ 0 };                   // ڶ (߳ҪҪ˯)
+    std::atomic<int> _sleepers{ 0 };                 //  _wake ˯Ĺ߳ (û˯Ͳ֪ͨ)
+    std::atomic<size_t> _steals{ 0 };
+    std::mutex _sleepMutex;
+    std::condition_variable _wake;
+};
+
+#endif // __JOB_SYSTEM_H__
@@ -1,5 +1,6 @@
 #include "KeyBindingScene.h"
 #include "HelloWorldScene.h"
+#include "FrameRateManager.h"
 #include "ui/UIButton.h"
 
 // ========================================
@@ -7,21 +8,24 @@
 // ========================================
 
 KeyBindingManager* KeyBindingManager::s_instance = nullptr;
+thread_local KeyBindingManager* KeyBindingManager::s_current = nullptr;
+std::atomic<uint32_t> KeyBindingManager::s_lastVersion(0);
 
 KeyBindingManager* KeyBindingManager::getInstance()
 {
+    if (s_current) return s_current;
     if (!s_instance)
     {
-        s_instance = new KeyBindingManager();
+        s_instance = new KeyBindingManager(true);
     }
     return s_instance;
 }
 
-KeyBindingManager::KeyBindingManager()
+KeyBindingManager::KeyBindingManager(bool loadSaved)
 {
     initDefaultKeys();
     // Զѱ
-    loadFromFile();
+    if (loadSaved) loadFromFile();
 }
 
 void KeyBindingManager::initDefaultKeys()
@@ -39,6 +43,7 @@ void KeyBindingManager::initDefaultKeys()
     _keyBindings[Action::DREAM_NAIL] = EventKeyboard::KeyCode::KEY_E;
     _keyBindings[Action::PAUSE] = EventKeyboard::KeyCode::KEY_SPACE;
     _keyBindings[Action::CONFIRM] = EventKeyboard::KeyCode::KEY_C;
+    bumpVersion();
 }
 
 EventKeyboard::KeyCode KeyBindingManager::getKeyForAction(Action action) const
@@ -54,6 +59,31 @@ EventKeyboard::KeyCode KeyBindingManager::getKeyForAction(Action action) const
 void KeyBindingManager::setKeyForAction(Action action, EventKeyboard::KeyCode key)
 {
     _keyBindings[action] = key;
+    bumpVersion();
+}
+
+void KeyBindingManager::fillKeyTable(InputQueue& queue) const
+{
+    if (queue.getBindingVersion() == _version) return;
+
+    static const struct { Action action; uint16_t bit; } table[] = {
+        { Action::MOVE_RIGHT, InputBit::MOVE_RIGHT },
+        { Action::MOVE_LEFT, InputBit::MOVE_LEFT },
+        { Action::MOVE_UP, InputBit::MOVE_UP },
+        { Action::MOVE_DOWN, InputBit::MOVE_DOWN },
+        { Action::JUMP, InputBit::JUMP },
+        { Action::ATTACK, InputBit::ATTACK },
+        { Action::FOCUS, InputBit::FOCUS },
+        { Action::CAST_SPELL, InputBit::CAST_SPELL },
+        { Action::DREAM_NAIL, InputBit::DREAM_NAIL },
+        { Action::PAUSE, InputQueue::PAUSE_BIT },
+    };
+
+    queue.clearBindings();
+    for (const auto& entry : table) {
+        queue.bind((int)getKeyForAction(entry.action), entry.bit);
+    }
+    queue.setBindingVersion(_version);
 }
 
 std::string KeyBindingManager::getKeyName(EventKeyboard::KeyCode key)
@@ -199,6 +229,7 @@ void KeyBindingManager::loadFromFile()
     
     if (hasCustomBindings)
     {
+        bumpVersion();
         CCLOG("Custom key bindings loaded successfully!");
     }
     else
@@ -220,7 +251,7 @@ void KeyBindingManager::resetToDefault()
 }
 
 // ========================================
-// KeyBindingScene ʵ
+// KeyBindingScene ʵ (ֻ KeyBindingLayer )
 // ========================================
 
 Scene* KeyBindingScene::createScene()
@@ -234,6 +265,40 @@ bool KeyBindingScene::init()
     {
         return false;
     }
+
+    _layer = KeyBindingLayer::create();
+    if (!_layer)
+    {
+        return false;
+    }
+    this->addChild(_layer);
+
+    return true;
+}
+
+void KeyBindingScene::onEnter()
+{
+    Scene::onEnter();
+
+    // ʼ˵ûϷģ⣬֡
+    FrameRateManager::getInstance()->enterIdle();
+}
+
+void KeyBindingScene::setPauseMode(bool isPause)
+{
+    if (_layer) _layer->setPauseMode(isPause);
+}
+
+// ========================================
+// KeyBindingLayer ʵ
+// ========================================
+
+bool KeyBindingLayer::init()
+{
+    if (!Layer::init())
+    {
+        return false;
+    }
     
     _currentSelection = 0;
     _isWaitingForKey = false;
@@ -261,14 +326,14 @@ bool KeyBindingScene::init()
     return true;
 }
 
-void KeyBindingScene::createUI()
+void KeyBindingLayer::createUI()
 {
     auto visibleSize = Director::getInstance()->getVisibleSize();
     Vec2 origin = Director::getInstance()->getVisibleOrigin();
     
     // ɫ - ģ¿նʿɫ
-    auto bgLayer = LayerColor::create(Color4B(15, 15, 25, 255));
-    this->addChild(bgLayer, -1);
+    _bgLayer = LayerColor::create(Color4B(15, 15, 25, 255));
+    this->addChild(_bgLayer, -1);
     
     createTitle();
     createActionList();
@@ -276,7 +341,7 @@ void KeyBindingScene::createUI()
     createInstructions();
 }
 
-void KeyBindingScene::createTitle()
+void KeyBindingLayer::createTitle()
 {
     auto visibleSize = Director::getInstance()->getVisibleSize();
     
@@ -294,7 +359,7 @@ void KeyBindingScene::createTitle()
     this->addChild(line1, 9);
 }
 
-void KeyBindingScene::createActionList()
+void KeyBindingLayer::createActionList()
 {
     auto visibleSize = Director::getInstance()->getVisibleSize();
     
@@ -354,7 +419,7 @@ void KeyBindingScene::createActionList()
     updateSelector();
 }
 
-void KeyBindingScene::createButtons()
+void KeyBindingLayer::createButtons()
 {
     auto visibleSize = Director::getInstance()->getVisibleSize();
     
@@ -389,7 +454,7 @@ void KeyBindingScene::createButtons()
     this->addChild(resetBg, 9);
 }
 
-void KeyBindingScene::createInstructions()
+void KeyBindingLayer::createInstructions()
 {
     auto visibleSize = Director::getInstance()->getVisibleSize();
 
@@ -416,7 +481,7 @@ void KeyBindingScene::createInstructions()
     this->addChild(_hintLabel2, 10);
 }
 
-void KeyBindingScene::updateKeyLabels()
+void KeyBindingLayer::updateKeyLabels()
 {
     auto kbm = KeyBindingManager::getInstance();
     
@@ -466,7 +531,7 @@ void KeyBindingScene::updateKeyLabels()
     }
 }
 
-void KeyBindingScene::updateSelector()
+void KeyBindingLayer::updateSelector()
 {
     // Ӱȫ
     if (_actionLabels.empty())
@@ -499,18 +564,21 @@ void KeyBindingScene::updateSelector()
     }
 }
 
-void KeyBindingScene::setupKeyboardListener()
+void KeyBindingLayer::setupKeyboardListener()
 {
     auto listener = EventListenerKeyboard::create();
     
-    listener->onKeyPressed = CC_CALLBACK_2(KeyBindingScene::onKeyPressed, this);
-    listener->onKeyReleased = CC_CALLBACK_2(KeyBindingScene::onKeyReleased, this);
+    listener->onKeyPressed = CC_CALLBACK_2(KeyBindingLayer::onKeyPressed, this);
+    listener->onKeyReleased = CC_CALLBACK_2(KeyBindingLayer::onKeyReleased, this);
     
     _eventDispatcher->addEventListenerWithSceneGraphPriority(listener, this);
 }
 
-void KeyBindingScene::onKeyPressed(EventKeyboard::KeyCode keyCode, Event* event)
+void KeyBindingLayer::onKeyPressed(EventKeyboard::KeyCode keyCode, Event* event)
 {   
+    // ˵вʱָ֡
+    FrameRateManager::getInstance()->onUserInput();
+
     // ڵȴ
     if (_isWaitingForKey)
     {
@@ -631,12 +699,12 @@ void KeyBindingScene::onKeyPressed(EventKeyboard::KeyCode keyCode, Event* event)
     CCLOG("================================");
 }
 
-void KeyBindingScene::onKeyReleased(EventKeyboard::KeyCode keyCode, Event* event)
+void KeyBindingLayer::onKeyReleased(EventKeyboard::KeyCode keyCode, Event* event)
 {
     // ݲ
 }
 
-void KeyBindingScene::moveSelectionUp()
+void KeyBindingLayer::moveSelectionUp()
 {
     if (_isWaitingForKey) return;
     
@@ -648,7 +716,7 @@ void KeyBindingScene::moveSelectionUp()
     updateSelector();
 }
 
-void KeyBindingScene::moveSelectionDown()
+void KeyBindingLayer::moveSelectionDown()
 {
     if (_isWaitingForKey) return;
     
@@ -660,7 +728,7 @@ void KeyBindingScene::moveSelectionDown()
     updateSelector();
 }
 
-void KeyBindingScene::confirmSelection()
+void KeyBindingLayer::confirmSelection()
 {
     CCLOG("========== CONFIRM SELECTION ==========");
     CCLOG("Current Selection: %d", _currentSelection);
@@ -715,19 +783,22 @@ void KeyBindingScene::confirmSelection()
           KeyBindingManager::getInstance()->getActionName(_selectedAction).c_str());
 }
 
-void KeyBindingScene::startGame()
+void KeyBindingLayer::startGame()
 {
     CCLOG("Starting game...");
     
     // 
     KeyBindingManager::getInstance()->saveToFile();
     
+    // 뵭ϷҪ֡
+    FrameRateManager::getInstance()->enterActive();
+
     // лϷʹõ뵭Ч
     auto scene = HelloWorld::createScene();
     Director::getInstance()->replaceScene(TransitionFade::create(1.2f, scene, Color3B::BLACK));
 }
 
-void KeyBindingScene::resetKeys()
+void KeyBindingLayer::resetKeys()
 {
     if (_isWaitingForKey) return;
     
@@ -754,12 +825,17 @@ void KeyBindingScene::resetKeys()
     CCLOG("Key bindings reset to default");
 }
 
-void KeyBindingScene::setPauseMode(bool isPause)
+void KeyBindingLayer::setPauseMode(bool isPause)
 {
     _isPauseMode = isPause;
 
     if (_isPauseMode)
     {
+        // 0. ͸¶涨Ϸ
+        if (_bgLayer) {
+            _bgLayer->setOpacity(200);
+        }
+
         // 1. ޸ı
         if (_titleLabel) {
             _titleLabel->setString("PAUSED");
@@ -775,11 +851,40 @@ void KeyBindingScene::setPauseMode(bool isPause)
     }
 }
 
-void KeyBindingScene::resumeGame()
+void KeyBindingLayer::setOnResume(const std::function<void()>& callback)
+{
+    _onResume = callback;
+}
+
+void KeyBindingLayer::refresh()
+{
+    // ʾʱصʼ״̬λڱ𴦱Ĺ
+    if (_isWaitingForKey && _currentSelection >= 0 && _currentSelection < (int)_keyLabels.size())
+    {
+        _keyLabels[_currentSelection]->stopAllActions();
+        _keyLabels[_currentSelection]->setColor(Color3B(240, 240, 255));
+        _keyLabels[_currentSelection]->setScale(1.0f);
+    }
+    _isWaitingForKey = false;
+    _currentSelection = 0;
+
+    updateKeyLabels();
+    updateSelector();
+}
+
+void KeyBindingLayer::resumeGame()
 {
     // 
     KeyBindingManager::getInstance()->saveToFile();
 
+    // ΪϷͣʱϷԼ
+    if (_onResume)
+    {
+        _onResume();
+        CCLOG("Resuming Game...");
+        return;
+    }
+
     // ǰָһ (HelloWorld)
     Director::getInstance()->popScene();
     CCLOG("Resuming Game...");
@@ -2,16 +2,38 @@
 #define __KEY_BINDING_SCENE_H__
 
 #include "cocos2d.h"
+#include "InputQueue.h"
+#include <atomic>
 #include <map>
 #include <string>
+#include <functional>
 
 USING_NS_CC;
 
 // λ󶨹
+// ع/Ự Scope ѱ̵߳ getInstance() ɻỰԼһݣҴļλ
 class KeyBindingManager
 {
 public:
     static KeyBindingManager* getInstance();
+
+    // loadSaved = falseֻĬϼλ浵 (ỰԼʵ)
+    explicit KeyBindingManager(bool loadSaved);
+    ~KeyBindingManager() = default;
+
+    // ڱ̵߳ getInstance()  bindings
+    class Scope
+    {
+    public:
+        explicit Scope(KeyBindingManager& bindings) : _previous(s_current) { s_current = &bindings; }
+        ~Scope() { s_current = _previous; }
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        KeyBindingManager* _previous;
+    };
     
     // ö
     enum class Action
@@ -49,33 +71,47 @@ public:
     // ΪĬϼλ
     void resetToDefault();
     
-private:
-    KeyBindingManager();
-    ~KeyBindingManager() = default;
+    // λÿһλһ°汾ţ˼λĵط (InputQueue) ݴжҪҪؽ
+    // 汾ȫֵʵ (Scope) Ҳ;ɱײ
+    uint32_t getVersion() const { return _version; }
+    // ѵǰλд queue   -> λ  (queue ǵİ汾͵ǰһʱʲô)
+    void fillKeyTable(InputQueue& queue) const;
     
+private:
     static KeyBindingManager* s_instance;
+    static thread_local KeyBindingManager* s_current;
+    static std::atomic<uint32_t> s_lastVersion;
     std::map<Action, EventKeyboard::KeyCode> _keyBindings;
+    uint32_t _version = 0;
     
     void initDefaultKeys();
+    void bumpVersion() { _version = s_lastVersion.fetch_add(1) + 1; }
 };
 
 // ==========================================
-// λó (ͣ˵)
+// λý (ͣ˵)
+// ʼ KeyBindingScene һ㣻ϷͣʱֱΪǲ
+//  HelloWorld ϣֻһΣ֮ʾ/
 // ==========================================
-class KeyBindingScene : public Scene
+class KeyBindingLayer : public Layer
 {
 public:
-    static Scene* createScene();
-
     virtual bool init() override;
 
-    CREATE_FUNC(KeyBindingScene);
+    CREATE_FUNC(KeyBindingLayer);
 
     // ǷΪͣģʽ
     void setPauseMode(bool isPause);
 
+    // ͣģʽ°ȷϼʱ ( popScene)
+    void setOnResume(const std::function<void()>& callback);
+
+    // ٴʾǰãˢ¼λ֡λ
+    void refresh();
+
 private:
     // UI Ԫ
+    LayerColor* _bgLayer = nullptr;
     Label* _titleLabel;
 
     std::vector<Label*> _actionLabels;
@@ -116,6 +152,29 @@ private:
     void startGame();
     void resetKeys();
     void resumeGame();
+
+    std::function<void()> _onResume;
 };
 
+// ==========================================
+// λó (Ϸʱĵһ)
+// ==========================================
+class KeyBindingScene : public Scene
+{
+public:
+    static Scene* createScene();
+
+    virtual bool init() override;
+
+    virtual void onEnter() override;
+
+    CREATE_FUNC(KeyBindingScene);
+
+    void setPauseMode(bool isPause);
+
+private:
+    KeyBindingLayer* _layer = nullptr;
+};
+
+
 #endif // __KEY_BINDING_SCENE_H__
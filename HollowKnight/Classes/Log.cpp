@@ -0,0 +1,290 @@
+#include "Log.h"
+#include "cocos2d.h"
+#include "config.h"
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <thread>
+
+std::atomic<uint32_t> Log::s_categoryMask(0xFFFFFFFFu);
+
+// ============================================================
+// λ (ߵߣн)
+// ÿλһţ == Ʊ ʾпд== Ʊ + 1 ʾдô
+// ============================================================
+namespace {
+    struct Cell
+    {
+        std::atomic<size_t> sequence;
+        LogRecord record;
+    };
+
+    std::unique_ptr<Cell[]> s_ring;
+    size_t s_mask = 0;
+    std::atomic<size_t> s_enqueuePos(0);
+    size_t s_dequeuePos = 0;                // ֻк̷̨߳
+
+    std::atomic<bool> s_running(false);
+    std::atomic<size_t> s_dropped(0);
+    std::thread s_writer;
+    FILE* s_file = nullptr;
+
+    const std::chrono::steady_clock::time_point s_startTime = std::chrono::steady_clock::now();
+
+    // WARN ͬʱԵֻ̨ļ
+    const LogLevel ECHO_LEVEL = LogLevel::Warn;
+
+    const char* levelName(LogLevel level)
+    {
+        static const char* names[] = { "TRACE", "DEBUG", "INFO", "WARN", "ERROR" };
+        return names[(int)level];
+    }
+
+    const char* categoryName(LogCat cat)
+    {
+        static const char* names[] = { "General", "Combat", "AI", "Anim", "Level", "Player", "UI", "Audio" };
+        return (int)cat < (int)LogCat::COUNT ? names[(int)cat] : "?";
+    }
+
+    long long nowUs()
+    {
+        return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - s_startTime).count();
+    }
+
+    void emit(const LogRecord& record, std::string& line)
+    {
+        line.clear();
+        Log::format(record, line);
+        if (s_file) {
+            fputs(line.c_str(), s_file);
+            fputc('\n', s_file);
+        }
+        if (!s_file || record.level >= ECHO_LEVEL) {
+            cocos2d::log("%s", line.c_str());
+        }
+    }
+
+    // ȡύļ¼ش
+    size_t drain(std::string& line)
+    {
+        size_t count = 0;
+        for (;;)
+        {
+            Cell& cell = s_ring[s_dequeuePos & s_mask];
+            size_t seq = cell.sequence.load(std::memory_order_acquire);
+            if (seq != s_dequeuePos + 1) break;
+
+            emit(cell.record, line);
+            cell.sequence.store(s_dequeuePos + s_mask + 1, std::memory_order_release);
+            s_dequeuePos++;
+            count++;
+        }
+        if (count > 0 && s_file) fflush(s_file);
+        return count;
+    }
+
+    void writerLoop()
+    {
+        std::string line;
+        line.reserve(512);
+        while (s_running.load(std::memory_order_acquire))
+        {
+            if (drain(line) == 0) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(Config::Log::DRAIN_INTERVAL_MS));
+            }
+        }
+        drain(line);
+    }
+}
+
+// ============================================================
+//  / ر
+// ============================================================
+void Log::init(const std::string& filePath)
+{
+    if (s_running.load()) return;
+
+    const size_t size = Config::Log::RING_SIZE;
+    s_ring.reset(new Cell[size]);
+    for (size_t i = 0; i < size; i++) s_ring[i].sequence.store(i, std::memory_order_relaxed);
+    s_mask = size - 1;
+    s_enqueuePos.store(0);
+    s_dequeuePos = 0;
+
+    s_file = fopen(filePath.c_str(), "w");
+    if (!s_file) {
+        cocos2d::log("Log: cannot open %s, logging to console only", filePath.c_str());
+    }
+
+    s_running.store(true, std::memory_order_release);
+    s_writer = std::thread(writerLoop);
+    cocos2d::log("Log: writing to %s", filePath.c_str());
+}
+
+void Log::shutdown()
+{
+    if (!s_running.load()) return;
+    s_running.store(false, std::memory_order_release);
+    if (s_writer.joinable()) s_writer.join();
+
+    size_t dropped = s_dropped.load();
+    if (s_file) {
+        if (dropped > 0) fprintf(s_file, "[Log] %zu records dropped (buffer full)\n", dropped);
+        fclose(s_file);
+        s_file = nullptr;
+    }
+}
+
+void Log::setCategoryEnabled(LogCat cat, bool enabled)
+{
+    uint32_t bit = 1u << (int)cat;
+    if (enabled) s_categoryMask.fetch_or(bit);
+    else s_categoryMask.fetch_and(~bit);
+}
+
+void Log::setAllCategoriesEnabled(bool enabled)
+{
+    s_categoryMask.store(enabled ? 0xFFFFFFFFu : 0u);
+}
+
+size_t Log::getDroppedCount()
+{
+    return s_dropped.load(std::memory_order_relaxed);
+}
+
+// ============================================================
+// 
+// ============================================================
+LogRecord* Log::beginRecord()
+{
+    if (!s_running.load(std::memory_order_acquire)) return nullptr;
+
+    size_t pos = s_enqueuePos.load(std::memory_order_relaxed);
+    for (;;)
+    {
+        Cell& cell = s_ring[pos & s_mask];
+        size_t seq = cell.sequence.load(std::memory_order_acquire);
+        intptr_t diff = (intptr_t)seq - (intptr_t)pos;
+        if (diff == 0) {
+            if (s_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                cell.record.ticket = pos;
+                cell.record.timeUs = nowUs();
+                return &cell.record;
+            }
+        }
+        else if (diff < 0) {
+            // ˣϷ߳
+            s_dropped.fetch_add(1, std::memory_order_relaxed);
+            return nullptr;
+        }
+        else {
+            pos = s_enqueuePos.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+void Log::commitRecord(LogRecord* record)
+{
+    s_ring[record->ticket & s_mask].sequence.store(record->ticket + 1, std::memory_order_release);
+}
+
+void Log::writeUnbuffered(LogRecord& record)
+{
+    // ̨߳˵ǻˣֱӶ (û init / ) ͬ
+    if (s_running.load(std::memory_order_relaxed)) return;
+
+    record.timeUs = nowUs();
+    std::string line;
+    Log::format(record, line);
+    cocos2d::log("%s", line.c_str());
+}
+
+void Log::pack(LogRecord& record, LogRecord::Arg& arg, const char* value)
+{
+    arg.type = LogRecord::ArgType::STRING;
+    arg.offset = record.stringBytes;
+    if (!value) value = "(null)";
+
+    // ŲµĲֽض
+    size_t room = LogRecord::STRING_BYTES - record.stringBytes;
+    if (room == 0) {
+        arg.offset = LogRecord::STRING_BYTES - 1;
+        return;
+    }
+    size_t len = std::min(strlen(value), room - 1);
+    memcpy(record.strings + record.stringBytes, value, len);
+    record.strings[record.stringBytes + len] = '\0';
+    record.stringBytes = (uint16_t)(record.stringBytes + len + 1);
+}
+
+// ============================================================
+// ʽ (̨߳)ת˵ snprintf
+// ͳһ long long ԭʽĳη (h/l/z...)
+// ============================================================
+void Log::format(const LogRecord& record, std::string& out)
+{
+    char head[64];
+    snprintf(head, sizeof(head), "[%9.3f][%-5s][%s] ", record.timeUs / 1000000.0, levelName(record.level), categoryName(record.category));
+    out += head;
+
+    const char* p = record.fmt;
+    int argIndex = 0;
+    char spec[32];
+    char buf[256];
+
+    while (*p)
+    {
+        if (*p != '%') { out += *p++; continue; }
+        if (p[1] == '%') { out += '%'; p += 2; continue; }
+
+        const char* start = p++;
+        while (*p && strchr("-+ #0", *p)) p++;
+        while (*p && (isdigit((unsigned char)*p) || *p == '.')) p++;
+        while (*p && strchr("hlLzjtq", *p)) p++;
+        char conv = *p;
+        if (!conv) { out.append(start); break; }
+        p++;
+
+        if (argIndex >= record.argCount) { out.append(start, p - start); continue; }
+        const LogRecord::Arg& arg = record.args[argIndex++];
+
+        // ȥη "%-5.2"
+        size_t n = 0;
+        for (const char* q = start; q < p - 1 && n < sizeof(spec) - 4; q++) {
+            if (!strchr("hlLzjtq", *q)) spec[n++] = *q;
+        }
+
+        switch (conv)
+        {
+        case 'd': case 'i':
+        case 'u': case 'x': case 'X': case 'o':
+            spec[n++] = 'l'; spec[n++] = 'l'; spec[n++] = conv; spec[n] = '\0';
+            if (arg.type == LogRecord::ArgType::DOUBLE) snprintf(buf, sizeof(buf), spec, (long long)arg.d);
+            else if (conv == 'd' || conv == 'i') snprintf(buf, sizeof(buf), spec, arg.i);
+            else snprintf(buf, sizeof(buf), spec, arg.u);
+            break;
+        case 'c':
+            spec[n++] = 'c'; spec[n] = '\0';
+            snprintf(buf, sizeof(buf), spec, (int)arg.i);
+            break;
+        case 'f': case 'F': case 'e': case 'E': case 'g': case 'G': case 'a': case 'A':
+            spec[n++] = conv; spec[n] = '\0';
+            snprintf(buf, sizeof(buf), spec, arg.type == LogRecord::ArgType::DOUBLE ? arg.d : (double)arg.i);
+            break;
+        case 's':
+            spec[n++] = 's'; spec[n] = '\0';
+            snprintf(buf, sizeof(buf), spec, arg.type == LogRecord::ArgType::STRING ? record.strings + arg.offset : "(?)");
+            break;
+        case 'p':
+            snprintf(buf, sizeof(buf), "%p", arg.p);
+            break;
+        default:
+            out.append(start, p - start);
+            continue;
+        }
+        out += buf;
+    }
+}
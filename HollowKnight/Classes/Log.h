@@ -0,0 +1,177 @@
+#ifndef __GAME_LOG_H__
+#define __GAME_LOG_H__
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+
+// ==========================================
+// ṹ־ (·ϵ CCLOG)
+// - ڼˣ HK_LOG_MIN_LEVEL ĵõ
+// - ڰ𿪹أصֻһη֧
+// - ӳٸʽֻ߳ѸʽָͲԭλ壬
+//   ɺ̸̨߳ʽд־ļ (WARN ͬʱԵ̨)
+// ÷HK_LOG_DEBUG(COMBAT, "Player hit Monster (Tag: %d)", tag);
+// ʽַ (ָֻ)ַᱻԴʱֵ
+// ==========================================
+
+// ȫдWindows ͷļ ERROR ֹ̻꣬ DEBUG
+enum class LogLevel : uint8_t
+{
+    Trace = 0,
+    Debug = 1,
+    Info = 2,
+    Warn = 3,
+    Error = 4
+};
+
+enum class LogCat : uint8_t
+{
+    GENERAL = 0,
+    COMBAT,     // Сײ
+    AI,         // /Boss ״̬л
+    ANIM,       // 벥
+    LEVEL,      // ͼءؿл
+    PLAYER,     // ״̬
+    UI,
+    AUDIO,
+    COUNT
+};
+
+// ͼ𣺵԰汣 DEBUG汣 INFOֻ WARN 
+#ifndef HK_LOG_MIN_LEVEL
+#if defined(HK_RELEASE_LITE)
+#define HK_LOG_MIN_LEVEL 3
+#elif defined(COCOS2D_DEBUG) && COCOS2D_DEBUG > 0
+#define HK_LOG_MIN_LEVEL 1
+#else
+#define HK_LOG_MIN_LEVEL 2
+#endif
+#endif
+
+// һ־ԭʼ (ڻλ)
+struct LogRecord
+{
+    static const int MAX_ARGS = 8;
+    static const int STRING_BYTES = 160;
+
+    enum class ArgType : uint8_t { INT, UINT, DOUBLE, STRING, POINTER };
+    struct Arg
+    {
+        ArgType type;
+        union
+        {
+            long long i;
+            unsigned long long u;
+            double d;
+            const void* p;
+            uint16_t offset;    // ַ strings ƫ
+        };
+    };
+
+    size_t ticket;          // ڻλ (ύʱ)
+    long long timeUs;
+    const char* fmt;
+    LogLevel level;
+    LogCat category;
+    uint8_t argCount;
+    uint16_t stringBytes;
+    Arg args[MAX_ARGS];
+    char strings[STRING_BYTES];
+};
+
+class Log
+{
+public:
+    // ̨д߳ (AppDelegate һ)δʱ˻Ϊ̨ͬ
+    static void init(const std::string& filePath);
+    // д껺ʣµ־ֹ̨ͣ߳
+    static void shutdown();
+
+    static bool isCategoryEnabled(LogCat cat)
+    {
+        return (s_categoryMask.load(std::memory_order_relaxed) >> (int)cat) & 1u;
+    }
+    static void setCategoryEnabled(LogCat cat, bool enabled);
+    static void setAllCategoriesEnabled(bool enabled);
+
+    // ʱ
+    static size_t getDroppedCount();
+
+    // һ¼ʽı (̨̺߳ͬģʽ)
+    static void format(const LogRecord& record, std::string& out);
+
+    template <typename... Args>
+    static void write(LogLevel level, LogCat cat, const char* fmt, const Args&... args)
+    {
+        LogRecord* record = beginRecord();
+        LogRecord local;
+        if (!record) record = &local; // δ򻺳
+
+        record->level = level;
+        record->category = cat;
+        record->fmt = fmt;
+        record->argCount = 0;
+        record->stringBytes = 0;
+        packArgs(*record, args...);
+
+        if (record == &local) writeUnbuffered(local);
+        else commitRecord(record);
+    }
+
+private:
+    static std::atomic<uint32_t> s_categoryMask;
+
+    static LogRecord* beginRecord();
+    static void commitRecord(LogRecord* record);
+    static void writeUnbuffered(LogRecord& record);
+
+    // ----  ----
+    static void packArgs(LogRecord&) {}
+    template <typename T, typename... Rest>
+    static void packArgs(LogRecord& record, const T& first, const Rest&... rest)
+    {
+        if (record.argCount < LogRecord::MAX_ARGS) {
+            pack(record, record.args[record.argCount++], first);
+        }
+        packArgs(record, rest...);
+    }
+
+    template <typename T>
+    static typename std::enable_if<std::is_integral<T>::value && std::is_signed<T>::value>::type
+        pack(LogRecord&, LogRecord::Arg& arg, T value) { arg.type = LogRecord::ArgType::INT; arg.i = value; }
+
+    template <typename T>
+    static typename std::enable_if<std::is_integral<T>::value && !std::is_signed<T>::value>::type
+        pack(LogRecord&, LogRecord::Arg& arg, T value) { arg.type = LogRecord::ArgType::UINT; arg.u = value; }
+
+    template <typename T>
+    static typename std::enable_if<std::is_enum<T>::value>::type
+        pack(LogRecord&, LogRecord::Arg& arg, T value) { arg.type = LogRecord::ArgType::INT; arg.i = (long long)value; }
+
+    template <typename T>
+    static typename std::enable_if<std::is_floating_point<T>::value>::type
+        pack(LogRecord&, LogRecord::Arg& arg, T value) { arg.type = LogRecord::ArgType::DOUBLE; arg.d = value; }
+
+    template <typename T>
+    static typename std::enable_if<std::is_pointer<T>::value && !std::is_same<typename std::decay<typename std::remove_pointer<T>::type>::type, char>::value>::type
+        pack(LogRecord&, LogRecord::Arg& arg, T value) { arg.type = LogRecord::ArgType::POINTER; arg.p = (const void*)value; }
+
+    static void pack(LogRecord& record, LogRecord::Arg& arg, const char* value);
+    static void pack(LogRecord& record, LogRecord::Arg& arg, const std::string& value) { pack(record, arg, value.c_str()); }
+};
+
+#define HK_LOG(level, cat, fmt, ...)                                                    \
+    do {                                                                                \
+        if ((int)(level) >= HK_LOG_MIN_LEVEL && Log::isCategoryEnabled(LogCat::cat))    \
+            Log::write(level, LogCat::cat, fmt, ##__VA_ARGS__);                         \
+    } while (0)
+
+#define HK_LOG_TRACE(cat, fmt, ...) HK_LOG(LogLevel::Trace, cat, fmt, ##__VA_ARGS__)
+#define HK_LOG_DEBUG(cat, fmt, ...) HK_LOG(LogLevel::Debug, cat, fmt, ##__VA_ARGS__)
+#define HK_LOG_INFO(cat, fmt, ...)  HK_LOG(LogLevel::Info, cat, fmt, ##__VA_ARGS__)
+#define HK_LOG_WARN(cat, fmt, ...)  HK_LOG(LogLevel::Warn, cat, fmt, ##__VA_ARGS__)
+#define HK_LOG_ERROR(cat, fmt, ...) HK_LOG(LogLevel::Error, cat, fmt, ##__VA_ARGS__)
+
+#endif // __GAME_LOG_H__
@@ -0,0 +1,155 @@
+#include "MusicPlayer.h"
+#include "audio/include/AudioEngine.h"
+#include "Log.h"
+#include <algorithm>
+
+USING_NS_CC;
+using namespace cocos2d::experimental;
+
+MusicPlayer* MusicPlayer::getInstance()
+{
+    static MusicPlayer s_instance;
+    return &s_instance;
+}
+
+// ============================================================
+//  / ֹͣ
+// ============================================================
+void MusicPlayer::play(const std::string& path, float fadeSeconds)
+{
+    Deck& current = _decks[_current];
+    if (current.audioId != AudioEngine::INVALID_AUDIO_ID && current.path == path) {
+        startFade(current, 1.0f, fadeSeconds); // ;лµ
+        return;
+    }
+
+    // һܻڵһףֱͣ
+    _current = 1 - _current;
+    Deck& next = _decks[_current];
+    if (next.audioId != AudioEngine::INVALID_AUDIO_ID) AudioEngine::stop(next.audioId);
+
+    next.path = path;
+    next.level = fadeSeconds > 0.0f ? 0.0f : 1.0f;
+    next.audioId = AudioEngine::play2d(path, true, next.level * _volume);
+    if (next.audioId == AudioEngine::INVALID_AUDIO_ID) {
+        HK_LOG_WARN(AUDIO, "MusicPlayer: cannot play %s", path);
+        next.path.clear();
+    }
+    else {
+        if (_paused) AudioEngine::pause(next.audioId);
+        startFade(next, 1.0f, fadeSeconds);
+        HK_LOG_INFO(AUDIO, "MusicPlayer: crossfade to %s (%.1fs)", path, fadeSeconds);
+    }
+
+    startFade(current, 0.0f, fadeSeconds);
+    ensureScheduled();
+}
+
+void MusicPlayer::stop(float fadeSeconds)
+{
+    startFade(_decks[_current], 0.0f, fadeSeconds);
+    ensureScheduled();
+}
+
+void MusicPlayer::prefetch(const std::string& path)
+{
+    if (path.empty() || path == getCurrentTrack()) return;
+    AudioEngine::preload(path, [path](bool ok) {
+        if (!ok) HK_LOG_WARN(AUDIO, "MusicPlayer: prefetch failed for %s", path);
+    });
+}
+
+// ============================================================
+//  (ص)
+// ============================================================
+void MusicPlayer::startFade(Deck& deck, float target, float seconds)
+{
+    if (deck.audioId == AudioEngine::INVALID_AUDIO_ID) return;
+    deck.target = target;
+    if (seconds <= 0.0f) {
+        deck.level = target;
+        deck.speed = 0.0f;
+    }
+    else {
+        deck.speed = 1.0f / seconds;
+    }
+    AudioEngine::setVolume(deck.audioId, deck.level * _volume);
+}
+
+void MusicPlayer::ensureScheduled()
+{
+    if (_scheduled) return;
+    _scheduled = true;
+    Director::getInstance()->getScheduler()->schedule([this](float dt) { tick(dt); }, this, 0.0f, false, "music_fade");
+}
+
+void MusicPlayer::tick(float dt)
+{
+    if (_paused) return;
+
+    bool fading = false;
+    for (auto& deck : _decks)
+    {
+        if (deck.audioId == AudioEngine::INVALID_AUDIO_ID) continue;
+        if (deck.level != deck.target) {
+            float step = deck.speed * dt;
+            deck.level = deck.level < deck.target ? std::min(deck.target, deck.level + step) : std::max(deck.target, deck.level - step);
+            AudioEngine::setVolume(deck.audioId, deck.level * _volume);
+        }
+        // ϣͣͷʽ߳
+        if (deck.level <= 0.0f && deck.target <= 0.0f) {
+            AudioEngine::stop(deck.audioId);
+            deck.audioId = AudioEngine::INVALID_AUDIO_ID;
+            deck.path.clear();
+        }
+        else if (deck.level != deck.target) {
+            fading = true;
+        }
+    }
+
+    // ûڵժصƽʱռÿ֡
+    if (!fading) {
+        Director::getInstance()->getScheduler()->unschedule("music_fade", this);
+        _scheduled = false;
+    }
+}
+
+// ============================================================
+// ͣ /  / ˳
+// ============================================================
+void MusicPlayer::pause()
+{
+    if (_paused) return;
+    _paused = true;
+    for (auto& deck : _decks) {
+        if (deck.audioId != AudioEngine::INVALID_AUDIO_ID) AudioEngine::pause(deck.audioId);
+    }
+}
+
+void MusicPlayer::resume()
+{
+    if (!_paused) return;
+    _paused = false;
+    for (auto& deck : _decks) {
+        if (deck.audioId != AudioEngine::INVALID_AUDIO_ID) AudioEngine::resume(deck.audioId);
+    }
+}
+
+void MusicPlayer::setVolume(float volume)
+{
+    _volume = clampf(volume, 0.0f, 1.0f);
+    for (auto& deck : _decks) {
+        if (deck.audioId != AudioEngine::INVALID_AUDIO_ID) AudioEngine::setVolume(deck.audioId, deck.level * _volume);
+    }
+}
+
+// Director Ѿ (һû)ﲻ Director
+void MusicPlayer::shutdown()
+{
+    _scheduled = false;
+    for (auto& deck : _decks) {
+        deck.audioId = AudioEngine::INVALID_AUDIO_ID;
+        deck.path.clear();
+    }
+    AudioEngine::end();
+}
@@ -0,0 +1,62 @@
+#ifndef __MUSIC_PLAYER_H__
+#define __MUSIC_PLAYER_H__
+
+#include "cocos2d.h"
+#include "config.h"
+#include <string>
+
+// ==========================================
+// ֲ ( experimental::AudioEngine )
+// -  AudioEngine ʽں̷ֿ̨߳룬̲߳׽
+// - ãʱɵĵµͬʱ (浭)Ӳ
+// - prefetch йغ֮ǰĿʼ̨/룬ʱֱӽ
+// 뵭Լ Director ϵĻصƽǰ
+// Ч AudioManager (ͬһ AudioEngine)ͣ/ܸķλ
+// ==========================================
+class MusicPlayer
+{
+public:
+    static MusicPlayer* getInstance();
+
+    // е path (ѭ)fadeSeconds ڽ浭Ѿڷʱʲô
+    void play(const std::string& path, float fadeSeconds = Config::Music::CROSSFADE_TIME);
+    void stop(float fadeSeconds = Config::Music::CROSSFADE_TIME);
+
+    // ǰں̨/ ()
+    void prefetch(const std::string& path);
+
+    void pause();
+    void resume();
+
+    void setVolume(float volume);
+    float getVolume() const { return _volume; }
+
+    const std::string& getCurrentTrack() const { return _decks[_current].path; }
+
+    // ˳ʱãͣر AudioEngine
+    void shutdown();
+
+private:
+    MusicPlayer() {}
+
+    struct Deck
+    {
+        int audioId = -1;           // AudioEngine  ID-1 ʾ
+        std::string path;
+        float level = 0.0f;         // 0..1 ĵ (ʵ)
+        float target = 0.0f;
+        float speed = 0.0f;         // ÿ仯
+    };
+
+    void tick(float dt);
+    void startFade(Deck& deck, float target, float seconds);
+    void ensureScheduled();
+
+    Deck _decks[2];
+    int _current = 0;
+    float _volume = Config::Music::VOLUME;
+    bool _paused = false;
+    bool _scheduled = false;
+};
+
+#endif // __MUSIC_PLAYER_H__
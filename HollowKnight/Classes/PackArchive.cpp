@@ -0,0 +1,163 @@
+#include "PackArchive.h"
+#include <algorithm>
+#include <cstring>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// ============================================================
+// ӳ / ر
+// ============================================================
+bool PackArchive::open(const std::string& path)
+{
+    close();
+
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE) return false;
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size) || size.QuadPart < (LONGLONG)sizeof(Header)) {
+        CloseHandle(file);
+        return false;
+    }
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    void* view = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+    if (!view) {
+        if (mapping) CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+    _file = file;
+    _mapping = mapping;
+    _base = (const uint8_t*)view;
+    _size = (size_t)size.QuadPart;
+#else
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size < (off_t)sizeof(Header)) {
+        ::close(fd);
+        return false;
+    }
+    void* view = mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd); // ӳ佨ļͲҪ
+    if (view == MAP_FAILED) return false;
+    _base = (const uint8_t*)view;
+    _size = (size_t)st.st_size;
+#endif
+
+    _header = (const Header*)_base;
+    _entries = (const Entry*)(_base + _header->entriesOffset);
+    _blobs = (const Blob*)(_base + _header->blobsOffset);
+    _names = (const char*)(_base + _header->namesOffset);
+
+    if (!validate()) {
+        close();
+        return false;
+    }
+    return true;
+}
+
+void PackArchive::close()
+{
+    if (_base) {
+#ifdef _WIN32
+        UnmapViewOfFile(_base);
+        CloseHandle((HANDLE)_mapping);
+        CloseHandle((HANDLE)_file);
+        _mapping = nullptr;
+        _file = nullptr;
+#else
+        munmap((void*)_base, _size);
+#endif
+    }
+    _base = nullptr;
+    _size = 0;
+    _header = nullptr;
+    _entries = nullptr;
+    _blobs = nullptr;
+    _names = nullptr;
+}
+
+// ֻṹǷԽ (/ضϵİֱӾܾ˻ɢļ)Уݹϣ
+bool PackArchive::validate() const
+{
+    const Header& h = *_header;
+    if (h.magic != MAGIC || h.version != VERSION) return false;
+
+    auto inside = [this](uint64_t offset, uint64_t bytes) {
+        return offset <= _size && bytes <= _size - offset;
+    };
+    if (!inside(h.entriesOffset, (uint64_t)h.entryCount * sizeof(Entry))) return false;
+    if (!inside(h.blobsOffset, (uint64_t)h.blobCount * sizeof(Blob))) return false;
+    if (!inside(h.namesOffset, h.namesSize)) return false;
+    if (h.entriesOffset % alignof(Entry) != 0 || h.blobsOffset % alignof(Blob) != 0) return false;
+
+    for (uint32_t i = 0; i < h.entryCount; i++) {
+        const Entry& e = _entries[i];
+        if (e.blob >= h.blobCount || (uint64_t)e.nameOffset + e.nameLength > h.namesSize) return false;
+    }
+    for (uint32_t i = 0; i < h.blobCount; i++) {
+        if (!inside(_blobs[i].offset, _blobs[i].size)) return false;
+    }
+    return true;
+}
+
+// ============================================================
+//  (ֻ֣ӳ̵߳)
+// ============================================================
+bool PackArchive::find(const char* name, size_t length, const uint8_t*& data, size_t& size) const
+{
+    if (!_base) return false;
+
+    auto compare = [this, name, length](const Entry& e) {
+        int c = memcmp(_names + e.nameOffset, name, std::min<size_t>(e.nameLength, length));
+        if (c != 0) return c;
+        return e.nameLength < length ? -1 : (e.nameLength > length ? 1 : 0);
+    };
+
+    uint32_t lo = 0, hi = _header->entryCount;
+    while (lo < hi)
+    {
+        uint32_t mid = lo + (hi - lo) / 2;
+        int c = compare(_entries[mid]);
+        if (c == 0) {
+            const Blob& blob = _blobs[_entries[mid].blob];
+            data = _base + blob.offset;
+            size = (size_t)blob.size;
+            return true;
+        }
+        if (c < 0) lo = mid + 1;
+        else hi = mid;
+    }
+    return false;
+}
+
+// ·ֽźã prefix ͷ·һΣһС prefix ľǺѡ
+bool PackArchive::hasPrefix(const char* prefix, size_t length) const
+{
+    if (!_base || length == 0) return false;
+
+    uint32_t lo = 0, hi = _header->entryCount;
+    while (lo < hi)
+    {
+        uint32_t mid = lo + (hi - lo) / 2;
+        const Entry& e = _entries[mid];
+        int c = memcmp(_names + e.nameOffset, prefix, std::min<size_t>(e.nameLength, length));
+        if (c < 0 || (c == 0 && e.nameLength < length)) lo = mid + 1;
+        else hi = mid;
+    }
+    if (lo == _header->entryCount) return false;
+    const Entry& e = _entries[lo];
+    return e.nameLength >= length && memcmp(_names + e.nameOffset, prefix, length) == 0;
+}
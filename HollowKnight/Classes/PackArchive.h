@@ -0,0 +1,100 @@
+#ifndef __PACK_ARCHIVE_H__
+#define __PACK_ARCHIVE_H__
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// ==========================================
+// Դ ( cocos)
+// tools/build_pack.py  Resources µԴһļʱڴӳ
+// - · (ֽ) źãֲңýϣҲڴ
+// - ͬļֻһ (ʱݹϣȥ)·ָͬһ
+// - ݿ鰴Ԥ嵥˳Уػ˳ҳѺ
+// ֱָָӳ close ֮ǰһֱЧ (㿽)
+//
+// ļ (С)
+//   Header | Entry[entryCount] | Blob[blobCount] | ·ַ | ݿ (16 ֽڶ)
+// ==========================================
+class PackArchive
+{
+public:
+    static const uint32_t MAGIC = 0x4B504B48;   // "HKPK"
+    static const uint32_t VERSION = 1;
+
+    struct Header
+    {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t entryCount;
+        uint32_t blobCount;
+        uint64_t entriesOffset;
+        uint64_t blobsOffset;
+        uint64_t namesOffset;
+        uint64_t namesSize;
+    };
+
+    // һ· ( name )
+    struct Entry
+    {
+        uint32_t nameOffset;    // ·ַƫƣβ 0
+        uint32_t nameLength;
+        uint32_t blob;          // ݿ
+        uint32_t reserved;
+    };
+
+    // һȥغ
+    struct Blob
+    {
+        uint64_t offset;        // ļͷ
+        uint64_t size;
+        uint64_t hash;          // ݹϣ (blake2b ǰ 8 ֽڣʱȥ)
+    };
+
+    PackArchive() = default;
+    ~PackArchive() { close(); }
+    PackArchive(const PackArchive&) = delete;
+    PackArchive& operator=(const PackArchive&) = delete;
+
+    // ӳ䲢Уͷ/ʧʱ false ұֹر״̬
+    bool open(const std::string& path);
+    void close();
+    bool isOpen() const { return _base != nullptr; }
+
+    // · ( "knight/idle/idle_1.png") ңҲ false
+    bool find(const char* name, size_t length, const uint8_t*& data, size_t& size) const;
+    bool find(const std::string& name, const uint8_t*& data, size_t& size) const
+    {
+        return find(name.data(), name.size(), data, size);
+    }
+    bool contains(const std::string& name) const
+    {
+        const uint8_t* data;
+        size_t size;
+        return find(name, data, size);
+    }
+
+    // û prefix ͷ· (Ŀ¼жãprefix β '/')
+    bool hasPrefix(const char* prefix, size_t length) const;
+
+    int getEntryCount() const { return _header ? (int)_header->entryCount : 0; }
+    int getBlobCount() const { return _header ? (int)_header->blobCount : 0; }
+    size_t getMappedBytes() const { return _size; }
+
+private:
+    bool validate() const;
+
+    const uint8_t* _base = nullptr;
+    size_t _size = 0;
+    const Header* _header = nullptr;
+    const Entry* _entries = nullptr;
+    const Blob* _blobs = nullptr;
+    const char* _names = nullptr;
+
+#ifdef _WIN32
+    void* _file = nullptr;      // HANDLE
+    void* _mapping = nullptr;   // HANDLE
+#endif
+};
+
+#endif // __PACK_ARCHIVE_H__
@@ -0,0 +1,103 @@
+#include "PackFileUtils.h"
+#include "Log.h"
+#include <cstring>
+
+USING_NS_CC;
+
+namespace {
+    PackFileUtils* s_pack = nullptr;
+}
+
+bool PackFileUtils::install(const std::string& packName)
+{
+    if (s_pack) return true;
+
+    auto current = FileUtils::getInstance();
+    if (!current->isFileExist(packName)) {
+        HK_LOG_INFO(GENERAL, "Pack: %s not found, reading loose files", packName);
+        return false;
+    }
+    std::string path = current->fullPathForFilename(packName);
+
+    auto utils = new (std::nothrow) PackFileUtils();
+    if (!utils || !utils->init() || !utils->_archive.open(path)) {
+        HK_LOG_WARN(GENERAL, "Pack: cannot open %s, reading loose files", path);
+        delete utils;
+        return false;
+    }
+
+    // ɵʵ setDelegate ͷţ֮ FileUtils::getInstance() ʵ
+    FileUtils::setDelegate(utils);
+    s_pack = utils;
+    HK_LOG_INFO(GENERAL, "Pack: mapped %s (%d files, %d blobs, %.1f MB)", path,
+                utils->_archive.getEntryCount(), utils->_archive.getBlobCount(),
+                utils->_archive.getMappedBytes() / (1024.0 * 1024.0));
+    return true;
+}
+
+PackFileUtils* PackFileUtils::getPack()
+{
+    return s_pack;
+}
+
+bool PackFileUtils::toPackName(const std::string& fullPath, const char*& name, size_t& length) const
+{
+    const std::string& root = _defaultResRootPath;
+    if (root.empty() || fullPath.size() <= root.size() || fullPath.compare(0, root.size(), root) != 0) return false;
+    name = fullPath.c_str() + root.size();
+    length = fullPath.size() - root.size();
+    return true;
+}
+
+bool PackFileUtils::findInPack(const std::string& fullPath, const uint8_t*& data, size_t& size) const
+{
+    const char* name;
+    size_t length;
+    return toPackName(fullPath, name, length) && _archive.find(name, length, data, size);
+}
+
+bool PackFileUtils::getView(const std::string& filename, const uint8_t*& data, size_t& size) const
+{
+    if (filename.empty()) return false;
+    // Ԥ̴߳Ѿ·ȥ fullPathForFilename Ļ
+    return findInPack(isAbsolutePath(filename) ? filename : fullPathForFilename(filename), data, size);
+}
+
+// fullPathForFilename ·ƴ·о
+bool PackFileUtils::isFileExistInternal(const std::string& filePath) const
+{
+    const uint8_t* data;
+    size_t size;
+    if (findInPack(filePath, data, size)) return true;
+    return PlatformFileUtils::isFileExistInternal(filePath);
+}
+
+// ֻļĳ·ļ͵Ŀ¼ (Ŀ¼ڴѾ)
+bool PackFileUtils::isDirectoryExistInternal(const std::string& dirPath) const
+{
+    const char* name;
+    size_t length;
+    if (toPackName(dirPath, name, length)) {
+        if (name[length - 1] == '/') {
+            if (_archive.hasPrefix(name, length)) return true;
+        }
+        else {
+            std::string prefix(name, length);
+            prefix += '/';
+            if (_archive.hasPrefix(prefix.c_str(), prefix.size())) return true;
+        }
+    }
+    return PlatformFileUtils::isDirectoryExistInternal(dirPath);
+}
+
+FileUtils::Status PackFileUtils::getContents(const std::string& filename, ResizableBuffer* buffer) const
+{
+    const uint8_t* data;
+    size_t size;
+    if (!getView(filename, data, size)) return PlatformFileUtils::getContents(filename, buffer);
+
+    // ǵ÷ (Data / std::string)ӳܽȥ뿽һ
+    buffer->resize(size);
+    if (size > 0) memcpy(buffer->buffer(), data, size);
+    return Status::OK;
+}
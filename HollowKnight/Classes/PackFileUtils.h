@@ -0,0 +1,58 @@
+#ifndef __PACK_FILE_UTILS_H__
+#define __PACK_FILE_UTILS_H__
+
+#include "cocos2d.h"
+#include "PackArchive.h"
+
+#if (CC_TARGET_PLATFORM == CC_PLATFORM_WIN32)
+#include "platform/win32/CCFileUtils-win32.h"
+typedef cocos2d::FileUtilsWin32 PlatformFileUtils;
+#elif (CC_TARGET_PLATFORM == CC_PLATFORM_LINUX)
+#include "platform/linux/CCFileUtils-linux.h"
+typedef cocos2d::FileUtilsLinux PlatformFileUtils;
+#elif (CC_TARGET_PLATFORM == CC_PLATFORM_MAC || CC_TARGET_PLATFORM == CC_PLATFORM_IOS)
+#include "platform/apple/CCFileUtils-apple.h"
+typedef cocos2d::FileUtilsApple PlatformFileUtils;
+#elif (CC_TARGET_PLATFORM == CC_PLATFORM_ANDROID)
+#include "platform/android/CCFileUtils-android.h"
+typedef cocos2d::FileUtilsAndroid PlatformFileUtils;
+#endif
+
+// ==========================================
+// Դļ FileUtils (滻ƽ̨Ĭʵ)
+// - ԴĿ¼µ·Ȳ (PackArchive)ûе (ƵдĿ¼) վߴ
+// - ·дɢļʱһTextureCache ļ·/ֱʵλӰ
+// - 㿽 getViewֱӳָ (Ԥؽ)
+// - getContents Ǹ cocos ÷ĶףData / ResizableBuffer һԼڴ棬ֻܿһ
+// ڻʱ install 滻Ϸճɢļ
+// ==========================================
+class PackFileUtils : public PlatformFileUtils
+{
+public:
+    // κԴȡ֮ǰ (AppDelegate ͷ)
+    static bool install(const std::string& packName);
+
+    // Ѱװʱʵ nullptr
+    static PackFileUtils* getPack();
+
+    // 㿽ңfullPath  fullPathForFilename Ľָڳ˳ǰһֱЧ
+    bool findInPack(const std::string& fullPath, const uint8_t*& data, size_t& size) const;
+    // ͬϣfilename · (·)ڰﷵ false÷Լ
+    bool getView(const std::string& filename, const uint8_t*& data, size_t& size) const;
+
+    const PackArchive& getArchive() const { return _archive; }
+
+    virtual bool isFileExistInternal(const std::string& filePath) const override;
+    virtual bool isDirectoryExistInternal(const std::string& dirPath) const override;
+    virtual Status getContents(const std::string& filename, cocos2d::ResizableBuffer* buffer) const override;
+
+private:
+    PackFileUtils() {}
+
+    // ·ȥԴĿ¼ǰ׺ ()ڸĿ¼ʱ false
+    bool toPackName(const std::string& fullPath, const char*& name, size_t& length) const;
+
+    PackArchive _archive;
+};
+
+#endif // __PACK_FILE_UTILS_H__
@@ -0,0 +1,31 @@
+#include "PatrolAI.h"
+
+void PatrolAI::setRange(PatrolState& state, float leftBound, float rightBound)
+{
+    state.leftBound = leftBound;
+    state.rightBound = rightBound;
+}
+
+bool PatrolAI::checkTurn(PatrolState& state, float x)
+{
+    if (state.movingRight && x >= state.rightBound)
+    {
+        state.movingRight = false;
+        return true;
+    }
+    if (!state.movingRight && x <= state.leftBound)
+    {
+        state.movingRight = true;
+        return true;
+    }
+    return false;
+}
+
+float PatrolAI::step(PatrolState& state, float x, float dt, bool* turned)
+{
+    x += state.direction() * state.speed * dt;
+
+    bool didTurn = checkTurn(state, x);
+    if (turned) *turned = didTurn;
+    return x;
+}
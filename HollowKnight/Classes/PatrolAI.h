@@ -0,0 +1,31 @@
+#ifndef __PATROL_AI_H__
+#define __PATROL_AI_H__
+
+// ==========================================
+// Ѳ AI (ͷģ cocos)
+// Enemy / Zombie ãֻͱ߽жλ/ٶɵ÷
+// ==========================================
+struct PatrolState
+{
+    float leftBound = 0.0f;
+    float rightBound = 0.0f;
+    float speed = 0.0f;
+    bool movingRight = true;
+
+    // ǰѲ߷+1 ң-1 
+    int direction() const { return movingRight ? 1 : -1; }
+};
+
+class PatrolAI
+{
+public:
+    static void setRange(PatrolState& state, float leftBound, float rightBound);
+
+    // ߽ͷ true ʾ֡ͷ
+    static bool checkTurn(PatrolState& state, float x);
+
+    // ֱƶѲ (Enemy ÷)ƶж߽
+    static float step(PatrolState& state, float x, float dt, bool* turned = nullptr);
+};
+
+#endif // __PATROL_AI_H__
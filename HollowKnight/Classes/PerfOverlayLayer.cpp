@@ -0,0 +1,228 @@
+#include "PerfOverlayLayer.h"
+#include "DreamDialogue.h"
+#include "AllocTracker.h"
+#include "TextureResidency.h"
+#include "config.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+USING_NS_CC;
+
+bool PerfOverlayLayer::init()
+{
+    if (!Layer::init()) return false;
+
+    auto visibleSize = Director::getInstance()->getVisibleSize();
+    auto origin = Director::getInstance()->getVisibleOrigin();
+
+    // Ͻǣߣ
+    float left = origin.x + visibleSize.width - Config::PerfOverlay::MARGIN - Config::PerfOverlay::GRAPH_WIDTH;
+    float top = origin.y + visibleSize.height - Config::PerfOverlay::MARGIN;
+
+    _draw = DrawNode::create();
+    _draw->setPosition(left, top - Config::PerfOverlay::GRAPH_HEIGHT);
+    this->addChild(_draw);
+
+    _text = Label::createWithTTF("", Config::PerfOverlay::FONT, Config::PerfOverlay::FONT_SIZE);
+    _text->setAnchorPoint(Vec2(0, 1));
+    _text->setPosition(left, top - Config::PerfOverlay::GRAPH_HEIGHT - 8);
+    _text->setAlignment(TextHAlignment::LEFT);
+    this->addChild(_text);
+
+    _frameMs.assign(Config::PerfOverlay::GRAPH_SAMPLES, 0.0f);
+    _textBuffer.reserve(1024);
+
+    this->setVisible(false);
+    return true;
+}
+
+void PerfOverlayLayer::onExit()
+{
+    if (_shown) Profiler::getInstance()->setLiveStatsEnabled(false);
+    Layer::onExit();
+}
+
+// ============================================================
+// ʾ / 
+// ============================================================
+void PerfOverlayLayer::toggle()
+{
+    setShown(!_shown);
+}
+
+void PerfOverlayLayer::setShown(bool shown)
+{
+    if (_shown == shown) return;
+    _shown = shown;
+    this->setVisible(shown);
+
+    // ֻʱʱŻʱ
+    Profiler::getInstance()->setLiveStatsEnabled(shown);
+
+    if (shown)
+    {
+        std::fill(_frameMs.begin(), _frameMs.end(), 0.0f);
+        _frameHead = 0;
+        _lastFrameTime = std::chrono::steady_clock::now();
+        _refreshTimer = 0.0f;
+        _textureTimer = Config::PerfOverlay::TEXTURE_INFO_INTERVAL; // 򿪺ͳһ
+        _windowFrames = 0;
+        _windowStartAllocs = AllocTracker::getTotals();
+        this->scheduleUpdate();
+    }
+    else
+    {
+        this->unscheduleUpdate();
+    }
+}
+
+// ============================================================
+// ÿ֡¼֡ʱ䲢ػߣְˢ
+// ============================================================
+void PerfOverlayLayer::update(float dt)
+{
+    auto now = std::chrono::steady_clock::now();
+    pushFrameTime(std::chrono::duration<float, std::milli>(now - _lastFrameTime).count());
+    _lastFrameTime = now;
+    _windowFrames++;
+
+    redrawGraph();
+
+    _textureTimer += dt;
+    if (_textureTimer >= Config::PerfOverlay::TEXTURE_INFO_INTERVAL) {
+        _textureTimer = 0.0f;
+        refreshTextureMemory();
+    }
+
+    _refreshTimer += dt;
+    if (_refreshTimer >= Config::PerfOverlay::REFRESH_INTERVAL) {
+        _refreshTimer = 0.0f;
+        refreshText();
+    }
+}
+
+void PerfOverlayLayer::pushFrameTime(float ms)
+{
+    _frameMs[_frameHead] = ms;
+    _frameHead = (_frameHead + 1) % (int)_frameMs.size();
+}
+
+void PerfOverlayLayer::redrawGraph()
+{
+    const float w = Config::PerfOverlay::GRAPH_WIDTH;
+    const float h = Config::PerfOverlay::GRAPH_HEIGHT;
+    const float maxMs = Config::PerfOverlay::GRAPH_MAX_MS;
+    const float budgetMs = 1000.0f / Config::Power::ACTIVE_FPS;
+    const int count = (int)_frameMs.size();
+
+    _draw->clear();
+    _draw->drawSolidRect(Vec2(0, 0), Vec2(w, h), Color4F(0, 0, 0, 0.6f));
+
+    // ֡Ԥ
+    float budgetY = std::min(budgetMs / maxMs, 1.0f) * h;
+    _draw->drawLine(Vec2(0, budgetY), Vec2(w, budgetY), Color4F(0.3f, 0.6f, 1.0f, 0.8f));
+
+    // ɵ£Ԥ֡ɺɫ
+    float step = w / std::max(1, count - 1);
+    Vec2 prev;
+    for (int i = 0; i < count; i++)
+    {
+        float ms = _frameMs[(_frameHead + i) % count];
+        Vec2 point(i * step, std::min(ms / maxMs, 1.0f) * h);
+        if (i > 0) {
+            Color4F color = ms > budgetMs ? Color4F(1.0f, 0.3f, 0.3f, 1.0f) : Color4F(0.3f, 1.0f, 0.3f, 1.0f);
+            _draw->drawLine(prev, point, color);
+        }
+        prev = point;
+    }
+}
+
+// ============================================================
+// ˢ (Ĭÿ 0.25 )
+// ============================================================
+void PerfOverlayLayer::refreshText()
+{
+    int frames = std::max(1, _windowFrames);
+
+    float sum = 0.0f;
+    float worst = 0.0f;
+    for (float ms : _frameMs) {
+        sum += ms;
+        worst = std::max(worst, ms);
+    }
+    float avg = sum / _frameMs.size();
+
+    PerfCounters counters;
+    if (_counterProvider) _counterProvider(counters);
+
+    AllocTracker::Counters allocs = AllocTracker::getTotals();
+
+    char line[128];
+    _textBuffer.clear();
+
+    snprintf(line, sizeof(line), "frame  avg %.2f ms  max %.2f ms  (%.0f fps)\n", avg, worst, avg > 0 ? 1000.0f / avg : 0.0f);
+    _textBuffer += line;
+
+    // ֶεÿ֡ƽʱ ( HK_PROFILE_ZONE / HK_PROFILE_NEXT)
+    Profiler::getInstance()->takeLiveStats(_liveStats);
+    for (const auto& stat : _liveStats)
+    {
+        if (stat.calls == 0) continue;
+        snprintf(line, sizeof(line), "  %-26s %6.3f ms\n", stat.name, stat.totalUs / 1000.0f / frames);
+        _textBuffer += line;
+    }
+
+    snprintf(line, sizeof(line), "entities %d  enemies %d  projectiles %d\n",
+        counters.entities, counters.enemies, counters.projectiles);
+    _textBuffer += line;
+
+    snprintf(line, sizeof(line), "dialogue pool %d/%d idle\n",
+        DreamDialogue::getPooledCount(), Config::Dialogue::POOL_SIZE);
+    _textBuffer += line;
+
+    if (AllocTracker::isEnabled()) {
+        snprintf(line, sizeof(line), "allocs/frame %.1f  (%.1f KB)\n",
+            (float)(allocs.count - _windowStartAllocs.count) / frames,
+            (allocs.bytes - _windowStartAllocs.bytes) / 1024.0f / frames);
+        _textBuffer += line;
+
+        // һ֡ļʱ
+        AllocTracker::ZoneStat zones[3];
+        int zoneCount = AllocTracker::getLastFrameZones(zones, 3);
+        for (int i = 0; i < zoneCount; i++) {
+            snprintf(line, sizeof(line), "  %-26s %4zu allocs\n", zones[i].name, zones[i].count);
+            _textBuffer += line;
+        }
+    }
+    else {
+        _textBuffer += "allocs/frame n/a (build with HK_TRACK_ALLOCS)\n";
+    }
+    _textBuffer += _textureInfo;
+
+    _text->setString(_textBuffer);
+
+    _windowFrames = 0;
+    _windowStartAllocs = allocs;
+}
+
+void PerfOverlayLayer::refreshTextureMemory()
+{
+    // getCachedTextureInfo һǻܣ"TextureCache dumpDebugInfo: N textures, for K KB (M MB)"
+    std::string info = Director::getInstance()->getTextureCache()->getCachedTextureInfo();
+    const char* summary = std::strstr(info.c_str(), "TextureCache dumpDebugInfo:");
+
+    int textures = 0;
+    unsigned int kb = 0;
+    if (summary && std::sscanf(summary, "TextureCache dumpDebugInfo: %d textures, for %u KB", &textures, &kb) == 2) {
+        _textureInfo = StringUtils::format("textures %d  %.1f MB\n", textures, kb / 1024.0f);
+    }
+    else {
+        _textureInfo = "textures ?\n";
+    }
+
+    // פͳ (ʱ)
+    auto residency = TextureResidency::getInstance();
+    _textureInfo += StringUtils::format("resident %.1f / %.0f MB  evicted %d\n",
+        residency->getResidentBytes() / (1024.0f * 1024.0f), residency->getBudgetBytes() / (1024.0f * 1024.0f), residency->getEvictedCount());
+}
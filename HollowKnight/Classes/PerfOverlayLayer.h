@@ -0,0 +1,70 @@
+#ifndef __PERF_OVERLAY_LAYER_H__
+#define __PERF_OVERLAY_LAYER_H__
+
+#include "cocos2d.h"
+#include "Profiler.h"
+#include "AllocTracker.h"
+#include <chrono>
+#include <functional>
+#include <string>
+#include <vector>
+
+// ==========================================
+//  ( HUDLayer йڳϣĬ)
+// ʾ֡ʱߡֶεģʱʵ/Ļڴ桢
+//       ռáÿ֡ڴ
+// ʱ update Profiler ʵʱͳƣûп
+// ͼһ DrawNode ﻭһ Label 
+// ==========================================
+
+// ɳˢʱдļ
+struct PerfCounters
+{
+    int entities = 0;       // Ϸӽڵ
+    int enemies = 0;
+    int projectiles = 0;    // ǻ + Boss  + 
+};
+
+class PerfOverlayLayer : public cocos2d::Layer
+{
+public:
+    CREATE_FUNC(PerfOverlayLayer);
+    virtual bool init() override;
+    virtual void onExit() override;
+    virtual void update(float dt) override;
+
+    void toggle();
+    void setShown(bool shown);
+    bool isShown() const { return _shown; }
+
+    void setCounterProvider(const std::function<void(PerfCounters&)>& provider) { _counterProvider = provider; }
+
+private:
+    void pushFrameTime(float ms);
+    void redrawGraph();
+    void refreshText();
+    void refreshTextureMemory();
+
+    cocos2d::DrawNode* _draw = nullptr;
+    cocos2d::Label* _text = nullptr;
+    bool _shown = false;
+
+    std::function<void(PerfCounters&)> _counterProvider;
+
+    // ֡ʱ价λ ()
+    std::vector<float> _frameMs;
+    int _frameHead = 0;
+    std::chrono::steady_clock::time_point _lastFrameTime;
+
+    // ǰˢ´ڵۼ
+    float _refreshTimer = 0.0f;
+    float _textureTimer = 0.0f;
+    int _windowFrames = 0;
+    AllocTracker::Counters _windowStartAllocs = { 0, 0 };
+
+    std::vector<Profiler::LiveStat> _liveStats;
+    std::string _textureInfo;
+    std::string _textBuffer;
+};
+
+#endif // __PERF_OVERLAY_LAYER_H__
@@ -1,9 +1,12 @@
 #include "PlayerAnimator.h"
-#include "SimpleAudioEngine.h"
+#include "AudioManager.h"
 #include "Config.h" // Ҫȡ·
+#include "Profiler.h"
+#include "Log.h"
+#include <algorithm>
+#include <chrono>
 
 USING_NS_CC;
-using namespace CocosDenshion;
 
 PlayerAnimator::PlayerAnimator() : _owner(nullptr), _slashEffectSprite(nullptr), _focusEffectSprite(nullptr)
 {
@@ -13,13 +16,68 @@ PlayerAnimator::~PlayerAnimator()
 {
 }
 
+// ============================================================
+// Ƭα֡֡·ʽ֡ÿ֡ʱؼǷѭ
+// δʱʾĸƬεĵһ֡
+// ============================================================
+struct PlayerAnimator::ClipDef
+{
+    const char* name;
+    const char* format;
+    int count;
+    float delay;
+    ClipTier tier;
+    bool loop;
+    const char* fallback;
+};
+
+namespace {
+    typedef PlayerAnimator::ClipTier Tier;
+
+    const PlayerAnimator::ClipDef CLIPS[] = {
+        // COREƶ
+        { "idle", Config::Path::PLAYER_IDLE, 9, 0.15f, Tier::CORE, true, nullptr },
+        { "run", Config::Path::PLAYER_RUN, 13, 0.15f, Tier::CORE, true, "idle" },
+        { "jump", Config::Path::PLAYER_JUMP, 6, 0.15f, Tier::CORE, true, "idle" },
+        { "fall", Config::Path::PLAYER_FALL, 6, 0.15f, Tier::CORE, true, "idle" },
+
+        // COMBATµʹȺ (ȹ/ʩ)
+        { "slash", Config::Path::PLAYER_SLASH, 6, 0.04f, Tier::COMBAT, false, "idle" },
+        { "slash_effect", Config::Path::PLAYER_SLASH_EFFECT, 6, 0.04f, Tier::COMBAT, false, nullptr },
+        { "slash_up", Config::Path::PLAYER_UPSLASH, 6, 0.04f, Tier::COMBAT, false, "idle" },
+        { "slash_up_effect", Config::Path::PLAYER_UP_SLASH_EFFECT, 6, 0.04f, Tier::COMBAT, false, nullptr },
+        { "slash_down", Config::Path::PLAYER_DOWNSLASH, 6, 0.04f, Tier::COMBAT, false, "fall" },
+        { "slash_down_effect", Config::Path::PLAYER_DOWN_SLASH_EFFECT, 6, 0.04f, Tier::COMBAT, false, nullptr },
+        { "damage", Config::Path::PLAYER_DAMAGED, 8, 0.06f, Tier::COMBAT, false, "idle" },
+        { "lookup", Config::Path::PLAYER_LOOKUP, 6, 0.1f, Tier::COMBAT, false, "idle" },
+        { "lookdown", Config::Path::PLAYER_LOOKDOWN, 6, 0.1f, Tier::COMBAT, false, "idle" },
+        { "cast_antic", Config::Path::PLAYER_CAST_ANTIC, 3, 0.05f, Tier::COMBAT, false, "idle" },
+        { "cast_release", Config::Path::PLAYER_CAST_RELEASE, 6, 0.06f, Tier::COMBAT, false, "idle" },
+        { "focus_loop", Config::Path::PLAYER_FOCUS_LOOP, 7, 0.08f, Tier::COMBAT, true, "idle" },
+        { "focus_get", Config::Path::PLAYER_FOCUS_GET, 11, 0.06f, Tier::COMBAT, false, "idle" },
+        { "focus_end", Config::Path::PLAYER_FOCUS_LOOP, 3, 0.08f, Tier::COMBAT, false, "idle" },
+        { "effect_focus_loop", Config::Path::EFFECT_FOCUS_LOOP, 13, 0.06f, Tier::COMBAT, true, nullptr },
+        { "effect_focus_end", Config::Path::EFFECT_FOCUS_END, 2, 0.08f, Tier::COMBAT, false, nullptr },
+
+        // RAREһõż
+        { "death", Config::Path::PLAYER_DEATH, 20, 0.08f, Tier::RARE, false, "damage" },
+        { "dream_nail_charge", Config::Path::DREAM_NAIL_CHARGE, 7, 0.1f, Tier::RARE, true, "idle" },
+        { "dream_nail_slash", Config::Path::DREAM_NAIL_SLASH, 15, 0.04f, Tier::RARE, false, "slash" },
+    };
+}
+
 void PlayerAnimator::init(Sprite* owner)
 {
     _owner = owner;
 
-    // 1. жԴ
-    loadAllAnimations();
-
+    // 1. ͬƶŽ̨ (RARE ȵһβ˵)
+    {
+        HK_PROFILE_ZONE("PlayerAnimator::loadCoreClips");
+        for (const auto& def : CLIPS) {
+            if (def.tier == ClipTier::CORE) loadClipNow(def);
+            else if (def.tier == ClipTier::COMBAT) _loadQueue.push_back(&def);
+        }
+    }
 
     // 2. ʼЧ
     _slashEffectSprite = Sprite::create();
@@ -34,86 +92,122 @@ void PlayerAnimator::init(Sprite* owner)
     _owner->addChild(_focusEffectSprite, 10);
 }
 
-void PlayerAnimator::loadAnim(const std::string& name, const std::string& format, int count, float delay)
+const PlayerAnimator::ClipDef* PlayerAnimator::findClip(const std::string& name)
 {
+    for (const auto& def : CLIPS) {
+        if (name == def.name) return &def;
+    }
+    return nullptr;
+}
+
+void PlayerAnimator::loadClipNow(const ClipDef& def)
+{
+    auto cache = Director::getInstance()->getTextureCache();
     Vector<SpriteFrame*> frames;
-    for (int i = 1; i <= count; i++) {
-        std::string path = StringUtils::format(format.c_str(), i);
-        auto sprite = Sprite::create(path);
-        if (sprite) frames.pushBack(sprite->getSpriteFrame());
+    for (int i = 1; i <= def.count; i++) {
+        auto texture = cache->addImage(StringUtils::format(def.format, i));
+        if (texture) frames.pushBack(SpriteFrame::createWithTexture(texture, Rect(Vec2::ZERO, texture->getContentSize())));
     }
     if (!frames.empty()) {
-        auto anim = Animation::createWithSpriteFrames(frames, delay);
-        _animations.insert(name, anim);
+        _animations.insert(def.name, Animation::createWithSpriteFrames(frames, def.delay));
     }
 }
 
-void PlayerAnimator::loadAllAnimations()
+// ============================================================
+// ̨
+// ============================================================
+void PlayerAnimator::requestClip(const ClipDef& def)
+{
+    if (_loading == &def) return;
+    auto it = std::find(_loadQueue.begin(), _loadQueue.end(), &def);
+    if (it != _loadQueue.end()) _loadQueue.erase(it);
+    _loadQueue.insert(_loadQueue.begin(), &def);
+}
+
+Animation* PlayerAnimator::getClip(const std::string& name)
 {
-    loadAnim("idle", Config::Path::PLAYER_IDLE, 9, 0.15f);
-    loadAnim("run", Config::Path::PLAYER_RUN, 13, 0.15f);
-    loadAnim("jump", Config::Path::PLAYER_JUMP, 6, 0.15f);
-    loadAnim("fall", Config::Path::PLAYER_FALL, 6, 0.15f);
-    loadAnim("slash", Config::Path::PLAYER_SLASH, 6, 0.04f);
-    loadAnim("damage", Config::Path::PLAYER_DAMAGED, 8, 0.06f);
-    loadAnim("lookup", Config::Path::PLAYER_LOOKUP, 6, 0.1f);
-    loadAnim("lookdown", Config::Path::PLAYER_LOOKDOWN, 6, 0.1f);
-    loadAnim("slash_up", Config::Path::PLAYER_UPSLASH, 6, 0.04f);
-    loadAnim("slash_down", Config::Path::PLAYER_DOWNSLASH, 6, 0.04f);
-    loadAnim("death", Config::Path::PLAYER_DEATH, 20, 0.08f);
+    auto anim = _animations.at(name);
+    if (anim) return anim;
 
-    // 
-    loadAnim("focus_loop", Config::Path::PLAYER_FOCUS_LOOP, 7, 0.08f);
-    loadAnim("focus_get", Config::Path::PLAYER_FOCUS_GET, 11, 0.06f);
-    loadAnim("focus_end", Config::Path::PLAYER_FOCUS_LOOP, 3, 0.08f);
+    const ClipDef* def = findClip(name);
+    if (def) requestClip(*def);
+    return nullptr;
+}
 
-    // Ч
-    loadAnim("slash_effect", Config::Path::PLAYER_SLASH_EFFECT, 6, 0.04f);
-    loadAnim("slash_up_effect", Config::Path::PLAYER_UP_SLASH_EFFECT, 6, 0.04f);
-    loadAnim("slash_down_effect", Config::Path::PLAYER_DOWN_SLASH_EFFECT, 6, 0.04f);
+bool PlayerAnimator::stepLoad()
+{
+    if (!_loading)
+    {
+        while (!_loadQueue.empty() && isClipLoaded(_loadQueue.front()->name)) _loadQueue.erase(_loadQueue.begin());
+        if (_loadQueue.empty()) return false;
+
+        _loading = _loadQueue.front();
+        _loadQueue.erase(_loadQueue.begin());
+        _loadingFrame = 1;
+        _asyncRequested = false;
+        _loadingFrames.clear();
+    }
 
-    // Ч
-    loadAnim("effect_focus_loop", Config::Path::EFFECT_FOCUS_LOOP, 13, 0.06f);
-    loadAnim("effect_focus_end", Config::Path::EFFECT_FOCUS_END, 2, 0.08f);
+    auto cache = Director::getInstance()->getTextureCache();
+    std::string path = StringUtils::format(_loading->format, _loadingFrame);
+    auto texture = cache->getTextureForKey(path);
 
-    //ʩζ
-    loadAnim("cast_antic", Config::Path::PLAYER_CAST_ANTIC, 3, 0.05f);
-    loadAnim("cast_release", Config::Path::PLAYER_CAST_RELEASE, 6, 0.06f);
+    if (!texture)
+    {
+        if (FileUtils::getInstance()->fullPathForFilename(path).empty()) {
+            // ļڣǰһһ֡
+            HK_LOG_WARN(ANIM, "Animation '%s': missing frame %s", _loading->name, path.c_str());
+        }
+        else {
+            // ڻ (ûԤ)ʣµ֡һԽ̶̨߳
+            // һ֡ȣ֮ÿ֡һ
+            if (!_asyncRequested) {
+                for (int i = _loadingFrame; i <= _loading->count; i++) {
+                    cache->addImageAsync(StringUtils::format(_loading->format, i), [](Texture2D*) {});
+                }
+                _asyncRequested = true;
+            }
+            return false;
+        }
+    }
+    else
+    {
+        _loadingFrames.pushBack(SpriteFrame::createWithTexture(texture, Rect(Vec2::ZERO, texture->getContentSize())));
+    }
 
-	// ֮      
-    loadAnim("dream_nail_charge", Config::Path::DREAM_NAIL_CHARGE, 7, 0.1f);
-    loadAnim("dream_nail_slash", Config::Path::DREAM_NAIL_SLASH, 15, 0.04f);
+    if (++_loadingFrame > _loading->count) finishClip();
+    return true;
 }
 
-void PlayerAnimator::preloadSounds()
+void PlayerAnimator::finishClip()
 {
-    auto audio = SimpleAudioEngine::getInstance();
-
-    // 1. 
-    audio->preloadBackgroundMusic(Config::Audio::BGM_DIRTMOUTH);
+    const ClipDef* def = _loading;
+    _loading = nullptr;
 
-    // 2. Ч
-    audio->preloadEffect(Config::Audio::HERO_JUMP);
-    audio->preloadEffect(Config::Audio::HERO_LAND_SOFT);
-    audio->preloadEffect(Config::Audio::HERO_LAND_HARD);
-    audio->preloadEffect(Config::Audio::HERO_RUN);
-    audio->preloadEffect(Config::Audio::HERO_UNSHEATH);
-
-    // 3. սЧ
-    audio->preloadEffect(Config::Audio::HERO_DAMAGE);
-    audio->preloadEffect(Config::Audio::HERO_DEATH);
+    if (!_loadingFrames.empty()) {
+        _animations.insert(def->name, Animation::createWithSpriteFrames(_loadingFrames, def->delay));
+    }
+    _loadingFrames.clear();
+    HK_LOG_DEBUG(ANIM, "Animation '%s' loaded (%d pending)", def->name, getPendingClipCount());
 
-    // 4. Ч
-    audio->preloadEffect(Config::Audio::SWORD_1);
-    audio->preloadEffect(Config::Audio::SWORD_2);
-    audio->preloadEffect(Config::Audio::SWORD_3);
+    // ʾ֡Ķڿ
+    if (_pendingAnim == def->name) {
+        playAnimation(def->name);
+    }
+}
 
-    // 5. Ч
-    audio->preloadEffect(Config::Audio::FOCUS_CHARGE);
-    audio->preloadEffect(Config::Audio::FOCUS_HEAL);
+void PlayerAnimator::pumpLoads(float budgetMs)
+{
+    if (!_loading && _loadQueue.empty()) return;
 
-    CCLOG("[PlayerAnimator] Audio Assets Preloaded Successfully from Config!");
+    HK_PROFILE_ZONE("PlayerAnimator::pumpLoads");
+    auto start = std::chrono::steady_clock::now();
+    while (stepLoad())
+    {
+        if (std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count() >= budgetMs) break;
+    }
 }
+
 void PlayerAnimator::playAnimation(const std::string& animName)
 {
     if (!_owner) return;
@@ -121,18 +215,27 @@ void PlayerAnimator::playAnimation(const std::string& animName)
     // ֹ֮ͣǰĶ (Tag 101)
     _owner->stopActionByTag(101);
 
-    if (_animations.find(animName) == _animations.end()) {
-        CCLOG("Error: Animation '%s' not found!", animName.c_str());
+    const ClipDef* def = findClip(animName);
+    if (!def) {
+        HK_LOG_WARN(ANIM, "Error: Animation '%s' not found!", animName.c_str());
         return;
     }
 
-    auto anim = _animations.at(animName);
-    Action* action = nullptr;
+    auto anim = getClip(animName);
+    if (!anim) {
+        // ûغ (Ѿŵ)ȶƬεĵһ֡ɺ finishClip Ų
+        _pendingAnim = animName;
+        auto fallback = def->fallback ? _animations.at(def->fallback) : nullptr;
+        if (fallback && !fallback->getFrames().empty()) {
+            _owner->setSpriteFrame(fallback->getFrames().front()->getSpriteFrame());
+        }
+        return;
+    }
+    _pendingAnim.clear();
 
     // жѭŻǵβ
-    if (animName == "idle" || animName == "run" || 
-        animName == "focus_loop"||animName=="jump"||
-        animName=="fall" || animName == "dream_nail_charge")
+    Action* action = nullptr;
+    if (def->loop)
     {
         action = RepeatForever::create(Animate::create(anim));
     }
@@ -176,8 +279,12 @@ void PlayerAnimator::playAttackEffect(int dir, bool facingRight)
 
     _slashEffectSprite->setPosition(center + offset);
 
-    auto anim = _animations.at(animName);
-    if (anim) {
+    // ⻹ûغþһʾ
+    auto anim = getClip(animName);
+    if (!anim) {
+        _slashEffectSprite->setVisible(false);
+    }
+    else {
         auto seq = Sequence::create(
             Animate::create(anim),
             CallFunc::create([this]() { _slashEffectSprite->setVisible(false); }),
@@ -193,8 +300,9 @@ void PlayerAnimator::startFocusEffect()
     _focusEffectSprite->setVisible(true);
     _focusEffectSprite->stopAllActions();
 
-    auto anim = _animations.at("effect_focus_loop");
+    auto anim = getClip("effect_focus_loop");
     if (anim) _focusEffectSprite->runAction(RepeatForever::create(Animate::create(anim)));
+    else _focusEffectSprite->setVisible(false);
 }
 
 void PlayerAnimator::stopFocusEffect()
@@ -210,8 +318,11 @@ void PlayerAnimator::playFocusEndEffect()
     _focusEffectSprite->setVisible(true);
     _focusEffectSprite->stopAllActions();
 
-    auto anim = _animations.at("effect_focus_end");
-    if (anim) {
+    auto anim = getClip("effect_focus_end");
+    if (!anim) {
+        _focusEffectSprite->setVisible(false);
+    }
+    else {
         auto seq = Sequence::create(
             Animate::create(anim),
             CallFunc::create([this]() { _focusEffectSprite->setVisible(false); }),
@@ -219,4 +330,35 @@ void PlayerAnimator::playFocusEndEffect()
         );
         _focusEffectSprite->runAction(seq);
     }
-}
\ No newline at end of file
+}
+
+// ============================================================
+// ѭЧ
+// ============================================================
+void PlayerAnimator::startRunSound()
+{
+    stopRunSound();
+    _runSoundID = AudioManager::getInstance()->playLoop(Config::Audio::HERO_RUN);
+}
+
+void PlayerAnimator::stopRunSound()
+{
+    if (_runSoundID != 0) {
+        AudioManager::getInstance()->stop(_runSoundID);
+        _runSoundID = 0;
+    }
+}
+
+void PlayerAnimator::startFocusSound()
+{
+    stopFocusSound();
+    _focusSoundID = AudioManager::getInstance()->playLoop(Config::Audio::FOCUS_CHARGE);
+}
+
+void PlayerAnimator::stopFocusSound()
+{
+    if (_focusSoundID != 0) {
+        AudioManager::getInstance()->stop(_focusSoundID);
+        _focusSoundID = 0;
+    }
+}
@@ -4,6 +4,11 @@
 #include "HelloWorldScene.h"
 #include "Fireball.h" 
 #include "HitEffect.h" // 引入受击特效
+#include "SimCocos.h"
+#include "SimSnapshot.h"
+#include "Log.h"
+#include "AllocTracker.h"
+#include "InputQueue.h"
 
 USING_NS_CC;
 
@@ -39,9 +44,9 @@ Player* Player::create(const std::string& filename)
 bool Player::init()
 {
     // 1. 加载初始纹理
-    if (!this->initWithFile("Knight/idle/idle_1.png"))
+    if (!this->initWithFile("knight/idle/idle_1.png"))
     {
-        CCLOG("Error: Failed to load 'Knight/idle/idle_1.png'");
+        CCLOG("Error: Failed to load 'knight/idle/idle_1.png'");
         return false;
     }
 
@@ -57,6 +62,7 @@ bool Player::init()
     _bodySize = Size(bodyW, bodyH);
     _bodyOffset = Vec2(0, bottomGap);
     _localBodyRect = Rect(-bodyW * 0.5f, bottomGap, bodyW, bodyH);
+    _body.localBox = SimCocos::toSim(_localBodyRect);
 
     // 4. 初始化变量
     // ==========================================
@@ -75,25 +81,26 @@ bool Player::init()
         };
 
     // 其他变量初始化
-    _velocity = Vec2::ZERO;
+    _body.velocity = SimVec2();
     _isInvincible = false;
     _isFacingRight = false;
-    _isOnGround = false;
+    _body.onGround = false;
     _attackCooldownTimer = 0.0f;
     _hasFireballSkill = false; // 初始不会
 
     // 初始化安全位置
-    _lastSafePosition = this->getPosition();
-    if (_lastSafePosition.equals(Vec2::ZERO)) {
-        _lastSafePosition = Vec2(100, 500);
+    _body.position = SimCocos::toSim(this->getPosition());
+    _body.lastSafePosition = _body.position;
+    if (_body.lastSafePosition.isZero()) {
+        _body.lastSafePosition = SimVec2(100, 500);
     }
 
     // 输入标记
     _inputDirectionX = 0;
     _inputDirectionY = 0;
     _isAttackPressed = false;
-    _jumpTimer = 0.0f;
-    _isJumpingAction = false;
+    _body.jumpTimer = 0.0f;
+    _body.jumping = false;
     _isJumpPressed = false;
     _isFocusInputPressed = false;
     _jumpInputReleased = true; 
@@ -128,6 +135,15 @@ void Player::update(float dt, const std::vector<cocos2d::Rect>& platforms)
         _attackCooldownTimer -= dt;
     }
 
+    // 受击无敌倒计时
+    if (_invincibleTimer > 0) {
+        _invincibleTimer -= dt;
+        if (_invincibleTimer <= 0) {
+            _isInvincible = false;
+            setInvincibleBlink(false);
+        }
+    }
+
     // B. 跳跃键重置检测
     // 只有当玩家【松开】跳跃键时，才允许下一次跳跃
     if (!_isJumpPressed) {
@@ -145,12 +161,14 @@ void Player::update(float dt, const std::vector<cocos2d::Rect>& platforms)
         _state->update(this, dt);
     }
 
-    // 【物理层】执行位移和碰撞
-    updateMovementX(dt);
-    updateCollisionX(platforms);
-
-    updateMovementY(dt);
-    updateCollisionY(platforms);
+    // 【物理层】执行位移和碰撞 (无头核心 PlayerPhysics)
+    // 状态机里可能直接 setPosition，所以在步进前才同步坐标
+    SimCocos::toSim(platforms, _simPlatforms);
+    _body.position = SimCocos::toSim(this->getPosition());
+    if (PlayerPhysics::step(_body, dt, _simPlatforms)) {
+        HK_LOG_WARN(PLAYER, "[Player] BUG DETECTED: Fell out of map! Teleporting to safety.");
+    }
+    this->setPosition(SimCocos::toCocos(_body.position));
 }
 
 // =================================================================
@@ -159,6 +177,8 @@ void Player::update(float dt, const std::vector<cocos2d::Rect>& platforms)
 
 void Player::changeState(PlayerState* newState)
 {
+    // 进出状态会切动画、播特效 (状态对象本身走 PlayerState 的定长池)
+    HK_ALLOW_ALLOC_SCOPE("Player::changeState");
     if (_state)
     {
         _state->exit(this);
@@ -180,7 +200,7 @@ void Player::changeState(PlayerState* newState)
 void Player::moveInDirection(int dir)
 {
     // 使用 Config::Player::MOVE_SPEED
-    _velocity.x = dir * Config::Player::MOVE_SPEED;
+    _body.velocity.x = dir * Config::Player::MOVE_SPEED;
 
     // 处理翻转
     if (dir != 0)
@@ -196,37 +216,29 @@ void Player::moveInDirection(int dir)
 
 float Player::getVelocityX()
 {
-    return _velocity.x;
+    return _body.velocity.x;
 }
 
 
 void Player::setVelocityX(float x)
 {
-    _velocity.x = x;
+    _body.velocity.x = x;
 }
 
 void Player::setVelocityY(float y)
 {
-    _velocity.y = y;
+    _body.velocity.y = y;
 }
 
 void Player::startJump()
 {
-    _isOnGround = false;
-    _isJumpingAction = true;
-    _jumpTimer = 0.0f;
-    _velocity.y = Config::Player::JUMP_FORCE_BASE;
+    PlayerPhysics::startJump(_body);
 }
 
 void Player::stopJump()
 {
-    _isJumpingAction = false;
-
     // 截断跳跃 - 手感优化
-    if (_velocity.y > 0)
-    {
-        _velocity.y *= 0.5f;
-    }
+    PlayerPhysics::stopJump(_body);
 }
 
 void Player::attack()
@@ -235,6 +247,11 @@ void Player::attack()
     _animator->playAttackEffect(_currentAttackDir, _isFacingRight);
 }
 
+void Player::pumpAnimationLoads()
+{
+    _animator->pumpLoads(Config::Anim::LOAD_BUDGET_MS);
+}
+
 void Player::startFocusEffect()
 {
     _animator->startFocusEffect();
@@ -250,6 +267,26 @@ void Player::playFocusEndEffect()
     _animator->playFocusEndEffect();
 }
 
+void Player::startRunSound()
+{
+    _animator->startRunSound();
+}
+
+void Player::stopRunSound()
+{
+    _animator->stopRunSound();
+}
+
+void Player::startFocusSound()
+{
+    _animator->startFocusSound();
+}
+
+void Player::stopFocusSound()
+{
+    _animator->stopFocusSound();
+}
+
 void Player::takeDamage(int damage, const cocos2d::Vec2& attackerPos, const std::vector<cocos2d::Rect>& platforms)
 {
     // 1. 状态检查
@@ -257,7 +294,7 @@ void Player::takeDamage(int damage, const cocos2d::Vec2& attackerPos, const std:
 
     // 2. 扣血
     _stats->takeDamage(damage);
-    CCLOG("Player took damage! Health: %d", _stats->getHealth());
+    HK_LOG_DEBUG(COMBAT, "Player took damage! Health: %d", _stats->getHealth());
 
     // 3. 受击特效（适配主角大小，居中）
     float fxSize = std::max(this->getContentSize().width, this->getContentSize().height) * 0.8f;
@@ -267,18 +304,25 @@ void Player::takeDamage(int damage, const cocos2d::Vec2& attackerPos, const std:
     float knockbackSpeed = 400.0f;
     float direction = (this->getPositionX() < attackerPos.x) ? -1.0f : 1.0f;
 
-    // 5. UI 更新
-    if (_onHealthChanged) {
-        _onHealthChanged(this->getHealth(), this->getMaxHealth());
-    }
+    // 5. UI 更新由 _stats->takeDamage 的回调负责，这里不再重复通知
 
-    _velocity.x = direction * knockbackSpeed;
-    _velocity.y = 300.0f; // 给一个小跳，防止在地面摩擦力过大
+    _body.velocity.x = direction * knockbackSpeed;
+    _body.velocity.y = 300.0f; // 给一个小跳，防止在地面摩擦力过大
 
     // 6. 切换状态和无敌
     changeState(new StateDamaged());
 
     _isInvincible = true;
+    _invincibleTimer = 1.0f;
+    setInvincibleBlink(true);
+}
+
+void Player::setInvincibleBlink(bool on)
+{
+    this->stopActionByTag(999);
+    this->setOpacity(255);
+    if (!on) return;
+
     auto blink = RepeatForever::create(Sequence::create(
         FadeTo::create(0.1f, 100),
         FadeTo::create(0.1f, 255),
@@ -286,12 +330,6 @@ void Player::takeDamage(int damage, const cocos2d::Vec2& attackerPos, const std:
     ));
     blink->setTag(999);
     this->runAction(blink);
-
-    this->scheduleOnce([this](float dt) {
-        _isInvincible = false;
-        this->stopActionByTag(999);
-        this->setOpacity(255);
-        }, 1.0f, "invincible_end");
 }
 
 void Player::executeHeal()
@@ -302,10 +340,8 @@ void Player::executeHeal()
 
 void Player::pogoJump()
 {
-    _velocity.y = 0;
     // 给一个向上的瞬时速度 (类似跳跃)
-    _velocity.y = Config::Player::JUMP_FORCE_BASE * 1.2f;
-    _isOnGround = false;
+    PlayerPhysics::pogoJump(_body);
 }
 
 // 实现消耗灵魂
@@ -331,6 +367,7 @@ bool Player::canCastSpell()
 
 void Player::executeSpell()
 {
+    HK_ALLOW_ALLOC_SCOPE("Player::executeSpell");
     // 1. 扣蓝
     consumeSoul(Config::Skill::FIREBALL_COST);
 
@@ -382,141 +419,44 @@ void Player::setDreamNailInput(bool pressed){   _isDreamNailPressed = pressed; }
 //  7. 物理引擎 (使用 Config)
 // =================================================================
 
+// 以下四个函数保留给单独调用的场合 (测试/调试)，
+// 正常每帧由 update 直接调用 PlayerPhysics::step
 void Player::updateMovementX(float dt)
 {
-    float dx = _velocity.x * dt;
-    this->setPositionX(this->getPositionX() + dx);
+    _body.position = SimCocos::toSim(this->getPosition());
+    PlayerPhysics::integrateX(_body, dt);
+    this->setPosition(SimCocos::toCocos(_body.position));
 }
 
 void Player::updateMovementY(float dt)
 {
-    // 长按跳跃增高
-    if (_isJumpingAction)
-    {
-        _jumpTimer += dt;
-        // 使用 Config::Player::MAX_JUMP_TIME
-        if (_jumpTimer < Config::Player::MAX_JUMP_TIME) {
-            // 使用 Config::Player::JUMP_ACCEL
-            _velocity.y += Config::Player::JUMP_ACCEL * dt;
-        }
-        else {
-            _isJumpingAction = false;
-        }
-    }
-
-    // 重力: 使用 Config::Player::GRAVITY
-    _velocity.y -= Config::Player::GRAVITY * dt;
-
-    // 终端速度: 使用 Config::Player::MAX_FALL_SPEED
-    if (_velocity.y < Config::Player::MAX_FALL_SPEED)
-        _velocity.y = Config::Player::MAX_FALL_SPEED;
-
-    float dy = _velocity.y * dt;
-    this->setPositionY(this->getPositionY() + dy);
-
-    // ============================================================
-    // 防Bug检测：如果掉出地图，拉回
-    // ============================================================
-    if (this->getPositionY() < -50.0f)
-    {
-        CCLOG("[Player] BUG DETECTED: Fell out of map! Teleporting to safety.");
-
-        // 1. 瞬移回上一次的安全地板 (稍微抬高 50 像素，防止再次卡进地里)
-        // 如果 _lastSafePosition 还没初始化(0,0)，就用当前 X 坐标 + 高度兜底
-        if (_lastSafePosition.equals(Vec2::ZERO)) {
-            this->setPosition(this->getPositionX(), 1000.0f);
-        }
-        else {
-            this->setPosition(_lastSafePosition + Vec2(0, 50.0f));
-        }
-
-        // 2. 彻底锁死速度 (防止带着下坠速度再次掉下去)
-        _velocity = Vec2::ZERO;
-
-        // 3. 如果在跳跃状态，强制停止，防止逻辑混乱
-        _isJumpingAction = false;
+    _body.position = SimCocos::toSim(this->getPosition());
+    if (PlayerPhysics::integrateY(_body, dt)) {
+        HK_LOG_WARN(PLAYER, "[Player] BUG DETECTED: Fell out of map! Teleporting to safety.");
     }
+    this->setPosition(SimCocos::toCocos(_body.position));
 }
 
 void Player::updateCollisionX(const std::vector<cocos2d::Rect>& platforms)
 {
-    Rect playerRect = getCollisionBox();
-    for (const auto& wall : platforms)
-    {
-        if (playerRect.intersectsRect(wall))
-        {
-            float overlapY = std::min(playerRect.getMaxY(), wall.getMaxY()) -
-                std::max(playerRect.getMinY(), wall.getMinY());
-
-            if (overlapY > playerRect.size.height * 0.5f)
-            {
-                if (_velocity.x > 0)
-                {
-                    this->setPositionX(wall.getMinX() - _bodySize.width * 0.5f - _bodyOffset.x - 0.1f);
-                    _velocity.x = 0;
-                }
-                else if (_velocity.x < 0)
-                {
-                    this->setPositionX(wall.getMaxX() + _bodySize.width * 0.5f - _bodyOffset.x + 0.1f);
-                    _velocity.x = 0;
-                }
-            }
-        }
-    }
+    SimCocos::toSim(platforms, _simPlatforms);
+    _body.position = SimCocos::toSim(this->getPosition());
+    PlayerPhysics::collideX(_body, _simPlatforms);
+    this->setPosition(SimCocos::toCocos(_body.position));
 }
 
 void Player::updateCollisionY(const std::vector<cocos2d::Rect>& platforms)
 {
-    _isOnGround = false;
-    Rect playerRect = getCollisionBox();
-
-    for (const auto& platform : platforms)
-    {
-        if (playerRect.intersectsRect(platform))
-        {
-            float overlapX = std::min(playerRect.getMaxX(), platform.getMaxX()) -
-                std::max(playerRect.getMinX(), platform.getMinX());
-
-            if (overlapX > playerRect.size.width * 0.1f)
-            {
-                if (_velocity.y <= 0)
-                {
-                    float tolerance = 40.0f;
-                    float overlapY = platform.getMaxY() - playerRect.getMinY();
-
-                    if (overlapY > -0.1f && overlapY <= tolerance)
-                    {
-                        this->setPositionY(platform.getMaxY() - _bodyOffset.y - 1.0f);
-                        _velocity.y = 0;
-                        _isOnGround = true;
-
-                        // ==========================================
-                        // 记录安全坐标
-                        // ==========================================
-                        _lastSafePosition = this->getPosition();
-                    }
-                }
-                else if (_velocity.y > 0)
-                {
-                    float tolerance = 20.0f;
-                    float overlapY = playerRect.getMaxY() - platform.getMinY();
-                    if (overlapY > 0 && overlapY <= tolerance)
-                    {
-                        this->setPositionY(platform.getMinY() - _bodySize.height - _bodyOffset.y);
-                        _velocity.y = 0;
-                    }
-                }
-            }
-        }
-    }
+    SimCocos::toSim(platforms, _simPlatforms);
+    _body.position = SimCocos::toSim(this->getPosition());
+    PlayerPhysics::collideY(_body, _simPlatforms);
+    this->setPosition(SimCocos::toCocos(_body.position));
 }
 
-// =================================================================
-//  8. 辅助函数
-// =================================================================
 void Player::startAttackCooldown()
 {
     _attackCooldownTimer = 0.25f+6*Config::Player::ATTACK_COOLDOWN;
+    if (_inputQueue) _inputQueue->consume(InputBit::ATTACK);
 }
 
 bool Player::isAttackReady() const
@@ -533,6 +473,7 @@ void Player::consumeJumpInput()
 {
     // 锁死跳跃，直到下次松开按键
     _jumpInputReleased = false;
+    if (_inputQueue) _inputQueue->consume(InputBit::JUMP);
 }
 
 bool Player::isCastReady() const
@@ -543,6 +484,7 @@ bool Player::isCastReady() const
 void Player::consumeCastInput()
 {
     _castInputReleased = false; // 锁死，直到下次松手
+    if (_inputQueue) _inputQueue->consume(InputBit::CAST_SPELL);
 }
 
 cocos2d::Rect Player::getCollisionBox() const
@@ -676,27 +618,23 @@ void Player::gainSoulOnKill()
 }
 
 // 3. 修复 UI 回调绑定
+// Stats 的回调已在 init 里转发到 _onHealthChanged / _onSoulChanged，
+// 这里只保存到 Player 自身，避免同一次变化通知两遍
 void Player::setOnHealthChanged(const std::function<void(int, int)>& callback)
 {
-    _onHealthChanged = callback; // 保存到 Player 自身
-    if (_stats) {
-        _stats->onHealthChanged = callback; // 同时设置给 Stats 组件
-    }
+    _onHealthChanged = callback;
 }
 
 void Player::setOnSoulChanged(const std::function<void(int)>& callback)
 {
     _onSoulChanged = callback;
-    if (_stats) {
-        _stats->onSoulChanged = callback;
-    }
 }
 
 // 新增：施法后刷新地面判定和安全坐标
 void Player::recordSafePositionIfOnGround()
 {
     // 只有在地面且碰撞箱与地面有重叠时才记录安全点
-    if (_isOnGround) {
+    if (_body.onGround) {
         // 检查当前位置下方是否有地面
         float checkY = this->getPositionY() - 2.0f;
         cocos2d::Rect checkBox = this->getCollisionBox();
@@ -709,7 +647,84 @@ void Player::recordSafePositionIfOnGround()
             }
         }
         if (hasGround) {
-            _lastSafePosition = this->getPosition();
+            _body.lastSafePosition = SimCocos::toSim(this->getPosition());
         }
     }
-}
\ No newline at end of file
+}
+
+// =================================================================
+//  8. 快照 (Snapshot)
+// =================================================================
+void Player::saveSnapshot(PlayerSnapshot& out) const
+{
+    out.body = _body;
+    out.body.position = SimCocos::toSim(this->getPosition()); // 状态机可能在步进之后直接改过坐标
+    out.facingRight = _isFacingRight;
+    out.attackCooldown = _attackCooldownTimer;
+    out.invincibleTimer = _isInvincible ? _invincibleTimer : 0.0f;
+
+    out.health = _stats->getHealth();
+    out.soul = _stats->getSoul();
+    out.hasFireballSkill = _hasFireballSkill;
+
+    out.attackDir = _currentAttackDir;
+    out.jumpInputReleased = _jumpInputReleased;
+    out.castInputReleased = _castInputReleased;
+    out.dreamNailActive = _isDreamNailActive;
+
+    PlayerStateData data;
+    if (_state) _state->saveData(data);
+    out.stateId = (uint8_t)(_state ? _state->getId() : PlayerStateId::IDLE);
+    out.stateTimer = data.timer;
+    out.stateDuration = data.duration;
+    out.stateFlagA = data.flagA;
+    out.stateFlagB = data.flagB;
+}
+
+void Player::restoreSnapshot(const PlayerSnapshot& in)
+{
+    // 1. 旧状态正常退出 (停循环音效、关凝聚特效)，再清掉进行中的动作
+    if (_state)
+    {
+        _state->exit(this);
+        delete _state;
+        _state = nullptr;
+    }
+    this->stopAllActions();
+    this->unscheduleAllCallbacks();
+    _animator->stopFocusEffect();
+
+    // 2. 物理和标记
+    _body = in.body;
+    this->setPosition(SimCocos::toCocos(_body.position));
+    _isFacingRight = in.facingRight;
+    this->setFlippedX(_isFacingRight);
+    _attackCooldownTimer = in.attackCooldown;
+    _invincibleTimer = in.invincibleTimer;
+    _isInvincible = _invincibleTimer > 0;
+    setInvincibleBlink(_isInvincible);
+
+    _stats->restore(in.health, in.soul);
+    _hasFireballSkill = in.hasFireballSkill;
+
+    _currentAttackDir = in.attackDir;
+    _jumpInputReleased = in.jumpInputReleased;
+    _castInputReleased = in.castInputReleased;
+    _isDreamNailActive = in.dreamNailActive;
+
+    // 3. 状态机
+    // 死亡和凝聚收尾都靠延时动作切走，动作不在快照里，直接从待机继续
+    PlayerStateId id = (PlayerStateId)in.stateId;
+    if (id == PlayerStateId::DEAD || (id == PlayerStateId::FOCUS && in.stateFlagB)) {
+        id = PlayerStateId::IDLE;
+    }
+
+    PlayerStateData data;
+    data.timer = in.stateTimer;
+    data.duration = in.stateDuration;
+    data.flagA = in.stateFlagA;
+    data.flagB = in.stateFlagB;
+
+    _state = PlayerState::createById(id);
+    _state->restore(this, data);
+}
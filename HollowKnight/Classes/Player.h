@@ -8,9 +8,12 @@
 // ͷļ
 #include "PlayerStats.h"
 #include "PlayerAnimator.h"
+#include "PlayerPhysics.h" // ͷ
 
 // ؼǰ״̬࣬ѭ
 class PlayerState;
+struct PlayerSnapshot;
+class InputQueue;
 
 class Player : public cocos2d::Sprite
 {
@@ -55,12 +58,20 @@ public:
 
     // ͨýӿ
     void playAnimation(const std::string& animName);
+    // ƽƬεĺ̨ (ÿ֡һΣʱ)
+    void pumpAnimationLoads();
 
     // Чӿ (ίи Animator)
     void startFocusEffect();
     void stopFocusEffect();
     void playFocusEndEffect();
 
+    // ѭЧ (ίи Animator)
+    void startRunSound();
+    void stopRunSound();
+    void startFocusSound();
+    void stopFocusSound();
+
     // ==========================================
     // 3. սֵӿ (Combat & Stats)
     // ==========================================
@@ -121,6 +132,9 @@ public:
     void setDreamNailInput(bool pressed);
     bool isDreamNailPressed() const { return _isDreamNailPressed; }
 
+    // ԴԾ//ʩЧʱ֪ͨ뻺 (¼طʱΪ)
+    void setInputQueue(InputQueue* queue) { _inputQueue = queue; }
+
     bool isDreamNailActive() const { return _isDreamNailActive; }
     void setDreamNailActive(bool active) { _isDreamNailActive = active; }
 
@@ -131,8 +145,8 @@ public:
     cocos2d::Rect getCollisionBox() const;
     cocos2d::Rect getAttackHitbox() const;
 
-    bool isOnGround() const { return _isOnGround; }
-    float getVelocityY() const { return _velocity.y; }
+    bool isOnGround() const { return _body.onGround; }
+    float getVelocityY() const { return _body.velocity.y; }
     bool isInvincible() const { return _isInvincible; }
     bool isFacingRight() const { return _isFacingRight; }
 
@@ -146,6 +160,13 @@ public:
 
     void recordSafePositionIfOnGround();
 
+    // ==========================================
+    // 7.  (㸴 / ع SimSnapshot.h)
+    // ==========================================
+    void saveSnapshot(PlayerSnapshot& out) const;
+    // ԭػָ״̬ exit״̬ enter (ظ/)״̬²
+    void restoreSnapshot(const PlayerSnapshot& in);
+
 private:
     // --- ڲ߼ ---
     void updateMovementX(float dt);
@@ -163,21 +184,22 @@ private:
     PlayerState* _state = nullptr;       // ǰ״̬
 
     // ---  ---
-    cocos2d::Vec2 _velocity;
+    // ٶȡءԾʱȫ㶼 _body  (ͷ PlayerPhysics 𲽽)
+    PlayerBody _body;
+    SimRectList _simPlatforms; // ÿ֡תõĻ壬ⷴ
+
     cocos2d::Size _bodySize;
     cocos2d::Vec2 _bodyOffset;
     cocos2d::Rect _localBodyRect;
-    cocos2d::Vec2 _lastSafePosition;// ¼һΰȫصλ
 
-    bool _isOnGround;
     bool _isFacingRight;
     // ȴʱ
     float _attackCooldownTimer;
 
     // --- ߼ ---
     bool _isInvincible;
-    bool _isJumpingAction;
-    float _jumpTimer;
+    float _invincibleTimer = 0.0f; // ܻ޵ʣʱ ( update ﵹܽ)
+    void setInvincibleBlink(bool on);
 
     // --- 뻺 ---
     int _inputDirectionX;
@@ -196,6 +218,8 @@ private:
     bool _isDreamNailPressed = false;
     bool _isDreamNailActive = false;
 
+    InputQueue* _inputQueue = nullptr;
+
     // ---  ---
     cocos2d::DrawNode* _debugNode = nullptr;
 
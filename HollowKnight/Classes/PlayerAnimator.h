@@ -3,6 +3,7 @@
 
 #include "cocos2d.h"
 #include <string>
+#include <vector>
 
 // ǰѭ
 class Player;
@@ -14,8 +15,24 @@ public:
     ~PlayerAnimator();
 
     // ʼ owner ()ԱЧӵ
+    // ֻͬ CORE  (վ///)Ž̨ض
     void init(cocos2d::Sprite* owner);
-    static void preloadSounds();
+
+    // ==========================================
+    // Ƭηּ
+    // - COREƶأinit ʱͬ
+    // - COMBAT///ʩinit ˳ں̨֡
+    // - RARE֮һβʱżأǰʾ֡
+    // ÿ֡ pumpLoads ʱԤƽڻʱ addImageAsync
+    // κһ֡Ϊ̶ס
+    // ==========================================
+    enum class ClipTier : uint8_t { CORE, COMBAT, RARE };
+    struct ClipDef;                                // Ƭα PlayAnimator.cpp
+
+    void pumpLoads(float budgetMs);
+    bool isClipLoaded(const std::string& name) const { return _animations.find(name) != _animations.end(); }
+    // û (ڼ) Ƭ
+    int getPendingClipCount() const { return (int)_loadQueue.size() + (_loading ? 1 : 0); }
 
     // --- Ľӿ ---
     // Ǳ嶯
@@ -30,10 +47,21 @@ public:
     void stopFocusEffect();
     void playFocusEndEffect();
 
+    // ѭЧ (ܲ / )ID ߣȫֱ
+    void startRunSound();
+    void stopRunSound();
+    void startFocusSound();
+    void stopFocusSound();
+
 private:
     // ڲغ
-    void loadAllAnimations();
-    void loadAnim(const std::string& name, const std::string& format, int count, float delay);
+    static const ClipDef* findClip(const std::string& name);
+    void loadClipNow(const ClipDef& def);          // ͬ (ֻ CORE)
+    void requestClip(const ClipDef& def);          // ŵضǰ
+    bool stepLoad();                               // ƽһ֡ͼƬûпķ false
+    void finishClip();
+    // ȡѼصƬΣûʱŶӲ nullptr
+    cocos2d::Animation* getClip(const std::string& name);
 
 
 private:
@@ -43,9 +71,21 @@ private:
     // 
     cocos2d::Map<std::string, cocos2d::Animation*> _animations;
 
+    // ̨״̬
+    std::vector<const ClipDef*> _loadQueue;        //  (ȼ)
+    const ClipDef* _loading = nullptr;             // ڼصƬ
+    int _loadingFrame = 0;                         // һҪ֡ ( 1 ʼ)
+    bool _asyncRequested = false;                  // ȱ֡Ѿ addImageAsync
+    cocos2d::Vector<cocos2d::SpriteFrame*> _loadingFrames;
+    std::string _pendingAnim;                      // ʾ֡ȼɺ󲥷ŵĶ
+
     // --- Ч (ڹ Animator ) ---
     cocos2d::Sprite* _slashEffectSprite; // 
     cocos2d::Sprite* _focusEffectSprite; // ۹Ч
+
+    // ڲŵѭЧ ID (0 = û)
+    unsigned int _runSoundID = 0;
+    unsigned int _focusSoundID = 0;
 };
 
 #endif
\ No newline at end of file
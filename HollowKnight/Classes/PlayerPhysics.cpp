@@ -0,0 +1,146 @@
+#include "PlayerPhysics.h"
+#include "SimConfig.h"
+
+void PlayerPhysics::startJump(PlayerBody& body)
+{
+    body.onGround = false;
+    body.jumping = true;
+    body.jumpTimer = 0.0f;
+    body.velocity.y = Config::Player::JUMP_FORCE_BASE;
+}
+
+void PlayerPhysics::stopJump(PlayerBody& body)
+{
+    body.jumping = false;
+
+    // ضԾ - ָŻ
+    if (body.velocity.y > 0)
+    {
+        body.velocity.y *= 0.5f;
+    }
+}
+
+void PlayerPhysics::pogoJump(PlayerBody& body)
+{
+    // һϵ˲ʱٶ (Ծ)
+    body.velocity.y = Config::Player::JUMP_FORCE_BASE * 1.2f;
+    body.onGround = false;
+}
+
+void PlayerPhysics::integrateX(PlayerBody& body, float dt)
+{
+    body.position.x += body.velocity.x * dt;
+}
+
+bool PlayerPhysics::integrateY(PlayerBody& body, float dt)
+{
+    // Ծ
+    if (body.jumping)
+    {
+        body.jumpTimer += dt;
+        if (body.jumpTimer < Config::Player::MAX_JUMP_TIME) {
+            body.velocity.y += Config::Player::JUMP_ACCEL * dt;
+        }
+        else {
+            body.jumping = false;
+        }
+    }
+
+    //  + նٶ
+    body.velocity.y -= Config::Player::GRAVITY * dt;
+    if (body.velocity.y < Config::Player::MAX_FALL_SPEED)
+        body.velocity.y = Config::Player::MAX_FALL_SPEED;
+
+    body.position.y += body.velocity.y * dt;
+
+    // Bug⣺ͼһεİȫذ
+    if (body.position.y < Config::Player::FALL_RESCUE_Y)
+    {
+        // ΢̧ 50 أֹٴοȫ㻹ûʼõǰ X + ߶ȶ
+        if (body.lastSafePosition.isZero()) {
+            body.position = SimVec2(body.position.x, 1000.0f);
+        }
+        else {
+            body.position = body.lastSafePosition + SimVec2(0, 50.0f);
+        }
+
+        // ٶȣǿƽԾ
+        body.velocity = SimVec2();
+        body.jumping = false;
+        return true;
+    }
+    return false;
+}
+
+void PlayerPhysics::collideX(PlayerBody& body, const SimRect* platforms, size_t count)
+{
+    SimRect playerRect = body.getCollisionBox();
+    for (size_t i = 0; i < count; i++)
+    {
+        const SimRect& wall = platforms[i];
+        if (!playerRect.intersectsRect(wall)) continue;
+
+        float overlapY = SimRect::overlapY(playerRect, wall);
+        if (overlapY > playerRect.height * 0.5f)
+        {
+            if (body.velocity.x > 0)
+            {
+                body.position.x = wall.getMinX() - (body.localBox.x + body.localBox.width) - 0.1f;
+                body.velocity.x = 0;
+            }
+            else if (body.velocity.x < 0)
+            {
+                body.position.x = wall.getMaxX() - body.localBox.x + 0.1f;
+                body.velocity.x = 0;
+            }
+        }
+    }
+}
+
+void PlayerPhysics::collideY(PlayerBody& body, const SimRect* platforms, size_t count)
+{
+    body.onGround = false;
+    SimRect playerRect = body.getCollisionBox();
+
+    for (size_t i = 0; i < count; i++)
+    {
+        const SimRect& platform = platforms[i];
+        if (!playerRect.intersectsRect(platform)) continue;
+
+        float overlapX = SimRect::overlapX(playerRect, platform);
+        if (overlapX <= playerRect.width * 0.1f) continue;
+
+        if (body.velocity.y <= 0)
+        {
+            float overlapY = platform.getMaxY() - playerRect.getMinY();
+            if (overlapY > -0.1f && overlapY <= Config::Player::LAND_TOLERANCE)
+            {
+                body.position.y = platform.getMaxY() - body.localBox.y - 1.0f;
+                body.velocity.y = 0;
+                body.onGround = true;
+
+                // ¼ȫ
+                body.lastSafePosition = body.position;
+            }
+        }
+        else
+        {
+            float overlapY = playerRect.getMaxY() - platform.getMinY();
+            if (overlapY > 0 && overlapY <= Config::Player::CEILING_TOLERANCE)
+            {
+                body.position.y = platform.getMinY() - (body.localBox.y + body.localBox.height);
+                body.velocity.y = 0;
+            }
+        }
+    }
+}
+
+bool PlayerPhysics::step(PlayerBody& body, float dt, const SimRect* platforms, size_t count)
+{
+    integrateX(body, dt);
+    collideX(body, platforms, count);
+
+    bool rescued = integrateY(body, dt);
+    collideY(body, platforms, count);
+    return rescued;
+}
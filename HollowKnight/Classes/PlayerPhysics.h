@@ -0,0 +1,54 @@
+#ifndef __PLAYER_PHYSICS_H__
+#define __PLAYER_PHYSICS_H__
+
+#include "SimTypes.h"
+
+// ==========================================
+// ״̬ (ͷģ cocos)
+// Player ֻ position ͬ Sprite
+// ==========================================
+struct PlayerBody
+{
+    SimVec2 position;          // ŵ ( Sprite  position)
+    SimVec2 velocity;
+    SimRect localBox;          // ײ䣬 position ƫ
+    SimVec2 lastSafePosition;  // һΰȫصλ
+
+    bool onGround = false;
+    bool jumping = false;      // Ծ
+    float jumpTimer = 0.0f;
+
+    SimRect getCollisionBox() const
+    {
+        return SimRect(position.x + localBox.x, position.y + localBox.y, localBox.width, localBox.height);
+    }
+};
+
+// ==========================================
+//  + 뾲̬εײ
+// ˳ԭ Player::update һ£X ƶ -> X ײ -> Y ƶ -> Y ײ
+// ==========================================
+class PlayerPhysics
+{
+public:
+    // Ծ
+    static void startJump(PlayerBody& body);
+    static void stopJump(PlayerBody& body);
+    static void pogoJump(PlayerBody& body);
+
+    // Ჽ
+    static void integrateX(PlayerBody& body, float dt);
+    //  true ʾ˵ͼذȫ
+    static bool integrateY(PlayerBody& body, float dt);
+    static void collideX(PlayerBody& body, const SimRect* platforms, size_t count);
+    static void collideY(PlayerBody& body, const SimRect* platforms, size_t count);
+
+    // һ (ͷģ)
+    static bool step(PlayerBody& body, float dt, const SimRect* platforms, size_t count);
+
+    static void collideX(PlayerBody& body, const SimRectList& platforms) { collideX(body, platforms.data(), platforms.size()); }
+    static void collideY(PlayerBody& body, const SimRectList& platforms) { collideY(body, platforms.data(), platforms.size()); }
+    static bool step(PlayerBody& body, float dt, const SimRectList& platforms) { return step(body, dt, platforms.data(), platforms.size()); }
+};
+
+#endif // __PLAYER_PHYSICS_H__
@@ -2,12 +2,60 @@
 // һ࣬Ҫ include Player.h
 // ʹǰ (Forward Declaration)
 
+#include <cstddef>
+#include <cstdint>
+
 class Player; // ؼ߱ Player Ǹ࣬ȱϸ
 
+// ״̬ (浵/عãֻĩβ׷ӣ˳Ҫ SimSnapshot::VERSION)
+enum class PlayerStateId : uint8_t
+{
+    IDLE = 0,
+    RUN,
+    JUMP,
+    FALL,
+    SLASH,
+    DAMAGED,
+    LOOK_UP,
+    LOOK_DOWN,
+    SLASH_UP,
+    SLASH_DOWN,
+    FOCUS,
+    DEAD,
+    CAST,
+    DREAM_NAIL
+};
+
+// ״̬ڲļʱͽ׶α (״̬Լ flagA / flagB ĺ)
+struct PlayerStateData
+{
+    float timer = 0.0f;
+    float duration = 0.0f;
+    bool flagA = false;
+    bool flagB = false;
+};
+
 class PlayerState {
 public:
     virtual ~PlayerState() {}
     virtual void enter(Player* player) = 0;
     virtual void update(Player* player, float dt) = 0;
     virtual void exit(Player* player) = 0;
-};
\ No newline at end of file
+
+    virtual PlayerStateId getId() const = 0;
+
+    // գֻʱͽ׶αǣûڲݵ״̬д
+    virtual void saveData(PlayerStateData& /*out*/) const {}
+
+    // ӿջָ enter (ظظ)ֻݺͶ
+    // ĬʵֲŸ״̬ (PlayerStates.cpp)
+    virtual void restore(Player* player, const PlayerStateData& data);
+
+    // Ŵ״̬
+    static PlayerState* createById(PlayerStateId id);
+
+    // ״̬߶ (PlayerStates.cpp)״̬Ƶ߶
+    // Ȳλʱ˻ȫ newֻ߳
+    static void* operator new(std::size_t size);
+    static void operator delete(void* p);
+};
@@ -2,23 +2,21 @@
 #include "Player.h"  
 #include "config.h" 
 #include "HelloWorldScene.h"
-#include "SimpleAudioEngine.h" // Ƶ
+#include "AudioManager.h"
+#include "Log.h"
+#include "AllocTracker.h"
+#include "SimRandom.h"
 
 USING_NS_CC;
-using namespace CocosDenshion; // ʹƵռ
-
-// ȫֱڼ¼(Focus)ܲѭЧIDֹͣ
-static unsigned int g_focusSoundID = 0;
-static unsigned int g_runSoundID = 0;
 
 void playRandomSlashSound() {
-    int r = cocos2d::random(0, 2);
+    int r = SimRandom::get(RngStream::FX).range(0, 2);
     const char* soundPath = Config::Audio::SWORD_3; // Ĭ
 
     if (r == 0) soundPath = Config::Audio::SWORD_1;
     else if (r == 1) soundPath = Config::Audio::SWORD_2;
 
-    SimpleAudioEngine::getInstance()->playEffect(soundPath);
+    AudioManager::getInstance()->play(soundPath);
 }
 
 // ============================================================================
@@ -121,7 +119,7 @@ void StateRun::enter(Player* player)
 {
     player->playAnimation("run");
 
-    g_runSoundID = SimpleAudioEngine::getInstance()->playEffect(Config::Audio::HERO_RUN, true);
+    player->startRunSound();
 }
 
 void StateRun::update(Player* player, float dt)
@@ -182,10 +180,7 @@ void StateRun::update(Player* player, float dt)
 
 void StateRun::exit(Player* player)
 {
-    if (g_runSoundID != 0) {
-        SimpleAudioEngine::getInstance()->stopEffect(g_runSoundID);
-        g_runSoundID = 0; //  ID
-    }
+    player->stopRunSound();
 }
 
 
@@ -199,7 +194,7 @@ void StateJump::enter(Player* player)
     player->startJump();
 
     // ԾЧ
-    SimpleAudioEngine::getInstance()->playEffect(Config::Audio::HERO_JUMP);
+    AudioManager::getInstance()->play(Config::Audio::HERO_JUMP);
 }
 
 void StateJump::update(Player* player, float dt)
@@ -299,7 +294,7 @@ void StateFall::update(Player* player, float dt)
     // ؼ
     if (player->isOnGround()) {
         // ޸ġЧ ()
-        SimpleAudioEngine::getInstance()->playEffect(Config::Audio::HERO_LAND_SOFT);
+        AudioManager::getInstance()->play(Config::Audio::HERO_LAND_SOFT);
 
         if (dir != 0) {
             player->changeState(new StateRun());
@@ -459,7 +454,7 @@ void StateSlashDown::exit(Player* player) { player->setAttackDir(0); }
 // ============================================================
 void StateFocus::enter(Player* player)
 {
-    CCLOG("State: Enter Focus");
+    HK_LOG_DEBUG(PLAYER, "State: Enter Focus");
     player->setVelocityX(0);
     _timer = 0.0f;
     _hasHealed = false;
@@ -469,7 +464,7 @@ void StateFocus::enter(Player* player)
     player->startFocusEffect();
 
     //  Ч (Config)¼IDԱֹͣ
-    g_focusSoundID = SimpleAudioEngine::getInstance()->playEffect(Config::Audio::FOCUS_CHARGE, true);
+    player->startFocusSound();
 }
 
 void StateFocus::update(Player* player, float dt)
@@ -481,13 +476,11 @@ void StateFocus::update(Player* player, float dt)
     const float TIME_END = 3 * 0.08f;
 
     auto triggerEnd = [this, player, TIME_END]() {
+        HK_ALLOW_ALLOC_SCOPE("StateFocus::end");
         this->_isEnding = true;
 
         // ʱֹͣЧ
-        if (g_focusSoundID != 0) {
-            SimpleAudioEngine::getInstance()->stopEffect(g_focusSoundID);
-            g_focusSoundID = 0;
-        }
+        player->stopFocusSound();
 
         player->playAnimation("focus_end");
         player->runAction(Sequence::create(
@@ -511,16 +504,14 @@ void StateFocus::update(Player* player, float dt)
         _timer += dt;
         if (_timer >= TIME_CHARGE)
         {
+            HK_ALLOW_ALLOC_SCOPE("StateFocus::heal");
             player->executeHeal();
             _hasHealed = true;
             _isEnding = true;
 
             // ɣֹͣŻѪ
-            if (g_focusSoundID != 0) {
-                SimpleAudioEngine::getInstance()->stopEffect(g_focusSoundID);
-                g_focusSoundID = 0;
-            }
-            SimpleAudioEngine::getInstance()->playEffect(Config::Audio::FOCUS_HEAL);
+            player->stopFocusSound();
+            AudioManager::getInstance()->play(Config::Audio::FOCUS_HEAL);
 
             player->playFocusEndEffect();
             player->playAnimation("focus_get");
@@ -545,10 +536,7 @@ void StateFocus::exit(Player* player)
     }
 
     //  ˫رգȷ˳״̬ʱЧһֹͣ
-    if (g_focusSoundID != 0) {
-        SimpleAudioEngine::getInstance()->stopEffect(g_focusSoundID);
-        g_focusSoundID = 0;
-    }
+    player->stopFocusSound();
 }
 
 // ============================================================================
@@ -561,7 +549,7 @@ void StateDamaged::enter(Player* player)
     _duration = 8 * 0.06f;
 
     // Ч
-    SimpleAudioEngine::getInstance()->playEffect(Config::Audio::HERO_DAMAGE);
+    AudioManager::getInstance()->play(Config::Audio::HERO_DAMAGE);
 }
 
 void StateDamaged::update(Player* player, float dt)
@@ -610,12 +598,12 @@ void StateDamaged::exit(Player* player)
 // ============================================================
 void StateDead::enter(Player* player)
 {
-    CCLOG("State: Enter Dead");
+    HK_LOG_INFO(PLAYER, "State: Enter Dead");
     player->stopAllActions();
     player->setVelocityX(0);
 
     // Ч
-    SimpleAudioEngine::getInstance()->playEffect(Config::Audio::HERO_DEATH);
+    AudioManager::getInstance()->play(Config::Audio::HERO_DEATH);
 
     player->playAnimation("death");
 
@@ -670,7 +658,7 @@ void StateCast::update(Player* player, float dt)
     if (!_hasSpawned && _timer >= TIME_ANTIC)
     {
         player->executeSpell();
-        SimpleAudioEngine::getInstance()->playEffect(Config::Audio::HERO_CAST);
+        AudioManager::getInstance()->play(Config::Audio::HERO_CAST);
         player->playAnimation("cast_release");
         float recoilDir = player->isFacingRight() ? -1.0f : 1.0f;
         player->setPositionX(player->getPositionX() + recoilDir * 10.0f);
@@ -767,4 +755,175 @@ void StateDreamNail::update(Player* player, float dt)
 void StateDreamNail::exit(Player* player)
 {
     player->setDreamNailActive(false); // ȷ˳״̬ʱжر
-}
\ No newline at end of file
+}
+
+// ============================================================
+// ״̬ ( PlayerState.h)
+// ͬһʱ¾״̬ (changeState  new  delete)
+// ============================================================
+namespace {
+    const int STATE_SLOT_SIZE = 32;
+    const int STATE_SLOT_COUNT = 4;
+
+    alignas(std::max_align_t) unsigned char s_stateSlots[STATE_SLOT_COUNT][STATE_SLOT_SIZE];
+    bool s_stateSlotUsed[STATE_SLOT_COUNT] = {};
+}
+
+void* PlayerState::operator new(std::size_t size)
+{
+    if (size <= (std::size_t)STATE_SLOT_SIZE) {
+        for (int i = 0; i < STATE_SLOT_COUNT; i++) {
+            if (!s_stateSlotUsed[i]) {
+                s_stateSlotUsed[i] = true;
+                return s_stateSlots[i];
+            }
+        }
+    }
+    return ::operator new(size);
+}
+
+void PlayerState::operator delete(void* p)
+{
+    for (int i = 0; i < STATE_SLOT_COUNT; i++) {
+        if (p == s_stateSlots[i]) {
+            s_stateSlotUsed[i] = false;
+            return;
+        }
+    }
+    ::operator delete(p);
+}
+
+// ============================================================
+// ջָ ( PlayerState.h)
+// ============================================================
+PlayerState* PlayerState::createById(PlayerStateId id)
+{
+    switch (id)
+    {
+    case PlayerStateId::IDLE: return new StateIdle();
+    case PlayerStateId::RUN: return new StateRun();
+    case PlayerStateId::JUMP: return new StateJump();
+    case PlayerStateId::FALL: return new StateFall();
+    case PlayerStateId::SLASH: return new StateSlash();
+    case PlayerStateId::DAMAGED: return new StateDamaged();
+    case PlayerStateId::LOOK_UP: return new StateLookUp();
+    case PlayerStateId::LOOK_DOWN: return new StateLookDown();
+    case PlayerStateId::SLASH_UP: return new StateSlashUp();
+    case PlayerStateId::SLASH_DOWN: return new StateSlashDown();
+    case PlayerStateId::FOCUS: return new StateFocus();
+    case PlayerStateId::DEAD: return new StateDead();
+    case PlayerStateId::CAST: return new StateCast();
+    case PlayerStateId::DREAM_NAIL: return new StateDreamNail();
+    }
+    return new StateIdle();
+}
+
+void PlayerState::restore(Player* player, const PlayerStateData& data)
+{
+    // ͸״̬ enter ﲥŵһ
+    static const char* animNames[] = {
+        "idle", "run", "jump", "fall", "slash", "damage", "lookup", "lookdown",
+        "slash_up", "slash_down", "focus_loop", "death", "cast_antic", "dream_nail_charge"
+    };
+    int index = (int)getId();
+    if (index < (int)(sizeof(animNames) / sizeof(animNames[0]))) {
+        player->playAnimation(animNames[index]);
+    }
+}
+
+void StateRun::restore(Player* player, const PlayerStateData& data)
+{
+    PlayerState::restore(player, data);
+    player->startRunSound();
+}
+
+void StateSlash::restore(Player* player, const PlayerStateData& data)
+{
+    _timer = data.timer;
+    _duration = data.duration;
+    PlayerState::restore(player, data);
+}
+
+void StateDamaged::restore(Player* player, const PlayerStateData& data)
+{
+    _timer = data.timer;
+    _duration = data.duration;
+    PlayerState::restore(player, data);
+}
+
+void StateLookUp::restore(Player* player, const PlayerStateData& data)
+{
+    _timer = data.timer;
+    _duration = data.duration;
+    PlayerState::restore(player, data);
+}
+
+void StateLookDown::restore(Player* player, const PlayerStateData& data)
+{
+    _timer = data.timer;
+    _duration = data.duration;
+    PlayerState::restore(player, data);
+}
+
+void StateSlashUp::restore(Player* player, const PlayerStateData& data)
+{
+    _timer = data.timer;
+    _duration = data.duration;
+    PlayerState::restore(player, data);
+}
+
+void StateSlashDown::restore(Player* player, const PlayerStateData& data)
+{
+    _timer = data.timer;
+    _duration = data.duration;
+    PlayerState::restore(player, data);
+}
+
+// flagA: ѻѪ  flagB: β׶ (βл IdlePlayer ָʱֱӻ Idle)
+void StateFocus::saveData(PlayerStateData& out) const
+{
+    out.timer = _timer;
+    out.flagA = _hasHealed;
+    out.flagB = _isEnding;
+}
+
+void StateFocus::restore(Player* player, const PlayerStateData& data)
+{
+    _timer = data.timer;
+    _hasHealed = false;
+    _isEnding = false;
+
+    PlayerState::restore(player, data);
+    player->startFocusEffect();
+    player->startFocusSound();
+}
+
+// flagA: ѷų
+void StateCast::saveData(PlayerStateData& out) const
+{
+    out.timer = _timer;
+    out.flagA = _hasSpawned;
+}
+
+void StateCast::restore(Player* player, const PlayerStateData& data)
+{
+    _timer = data.timer;
+    _hasSpawned = data.flagA;
+    if (_hasSpawned) player->playAnimation("cast_release");
+    else PlayerState::restore(player, data);
+}
+
+// flagA: ѻӳ
+void StateDreamNail::saveData(PlayerStateData& out) const
+{
+    out.timer = _timer;
+    out.flagA = _hasSlashed;
+}
+
+void StateDreamNail::restore(Player* player, const PlayerStateData& data)
+{
+    _timer = data.timer;
+    _hasSlashed = data.flagA;
+    if (_hasSlashed) player->playAnimation("dream_nail_slash");
+    else PlayerState::restore(player, data);
+}
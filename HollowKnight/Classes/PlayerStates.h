@@ -11,6 +11,7 @@ public:
     void enter(Player* player) override;
     void update(Player* player, float dt) override;
     void exit(Player* player) override;
+    PlayerStateId getId() const override { return PlayerStateId::IDLE; }
 };
 
 // =========================
@@ -21,6 +22,8 @@ public:
     void enter(Player* player) override;
     void update(Player* player, float dt) override;
     void exit(Player* player) override;
+    PlayerStateId getId() const override { return PlayerStateId::RUN; }
+    void restore(Player* player, const PlayerStateData& data) override;
 };
 
 // =========================
@@ -31,6 +34,7 @@ public:
     void enter(Player* player) override;
     void update(Player* player, float dt) override;
     void exit(Player* player) override;
+    PlayerStateId getId() const override { return PlayerStateId::JUMP; }
 };
 
 // =========================
@@ -41,6 +45,7 @@ public:
     void enter(Player* player) override;
     void update(Player* player, float dt) override;
     void exit(Player* player) override;
+    PlayerStateId getId() const override { return PlayerStateId::FALL; }
 };
 
 // =========================
@@ -51,6 +56,9 @@ public:
     void enter(Player* player) override;
     void update(Player* player, float dt) override;
     void exit(Player* player) override;
+    PlayerStateId getId() const override { return PlayerStateId::SLASH; }
+    void saveData(PlayerStateData& out) const override { out.timer = _timer; out.duration = _duration; }
+    void restore(Player* player, const PlayerStateData& data) override;
 private:
     float _timer;
     float _duration;
@@ -64,6 +72,9 @@ public:
     void enter(Player* player) override;
     void update(Player* player, float dt) override;
     void exit(Player* player) override;
+    PlayerStateId getId() const override { return PlayerStateId::DAMAGED; }
+    void saveData(PlayerStateData& out) const override { out.timer = _timer; out.duration = _duration; }
+    void restore(Player* player, const PlayerStateData& data) override;
 private:
     float _timer;
     float _duration;
@@ -77,6 +88,9 @@ public:
     void enter(Player* player) override;
     void update(Player* player, float dt) override;
     void exit(Player* player) override;
+    PlayerStateId getId() const override { return PlayerStateId::LOOK_UP; }
+    void saveData(PlayerStateData& out) const override { out.timer = _timer; out.duration = _duration; }
+    void restore(Player* player, const PlayerStateData& data) override;
 private:
     float _timer;
     float _duration;
@@ -90,6 +104,9 @@ public:
     void enter(Player* player) override;
     void update(Player* player, float dt) override;
     void exit(Player* player) override;
+    PlayerStateId getId() const override { return PlayerStateId::LOOK_DOWN; }
+    void saveData(PlayerStateData& out) const override { out.timer = _timer; out.duration = _duration; }
+    void restore(Player* player, const PlayerStateData& data) override;
 private:
     float _timer;
     float _duration;
@@ -101,6 +118,9 @@ public:
     void enter(Player* player) override;
     void update(Player* player, float dt) override;
     void exit(Player* player) override;
+    PlayerStateId getId() const override { return PlayerStateId::SLASH_UP; }
+    void saveData(PlayerStateData& out) const override { out.timer = _timer; out.duration = _duration; }
+    void restore(Player* player, const PlayerStateData& data) override;
 private:
     float _timer; float _duration;
 };
@@ -111,6 +131,9 @@ public:
     void enter(Player* player) override;
     void update(Player* player, float dt) override;
     void exit(Player* player) override;
+    PlayerStateId getId() const override { return PlayerStateId::SLASH_DOWN; }
+    void saveData(PlayerStateData& out) const override { out.timer = _timer; out.duration = _duration; }
+    void restore(Player* player, const PlayerStateData& data) override;
 private:
     float _timer; float _duration;
 };
@@ -124,6 +147,9 @@ public:
     virtual void enter(Player* player) override;
     virtual void update(Player* player, float dt) override;
     virtual void exit(Player* player) override;
+    virtual PlayerStateId getId() const override { return PlayerStateId::FOCUS; }
+    virtual void saveData(PlayerStateData& out) const override;
+    virtual void restore(Player* player, const PlayerStateData& data) override;
 
 private:
     float _timer;
@@ -140,6 +166,7 @@ public:
     virtual void enter(Player* player) override;
     virtual void update(Player* player, float dt) override;
     virtual void exit(Player* player) override;
+    virtual PlayerStateId getId() const override { return PlayerStateId::DEAD; }
 };
 #endif // __PLAYER_STATES_H__
 
@@ -149,6 +176,9 @@ public:
     virtual void enter(Player* player);
     virtual void update(Player* player, float dt) override;
     virtual void exit(Player* player) override;
+    virtual PlayerStateId getId() const override { return PlayerStateId::CAST; }
+    virtual void saveData(PlayerStateData& out) const override;
+    virtual void restore(Player* player, const PlayerStateData& data) override;
 
 private:
     float _timer;
@@ -162,6 +192,9 @@ public:
     void enter(Player* player) override;
     void update(Player* player, float dt) override;
     void exit(Player* player) override;
+    PlayerStateId getId() const override { return PlayerStateId::DREAM_NAIL; }
+    void saveData(PlayerStateData& out) const override;
+    void restore(Player* player, const PlayerStateData& data) override;
 
 private:
     float _timer;
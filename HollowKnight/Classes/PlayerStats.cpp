@@ -1,6 +1,5 @@
 #include "PlayerStats.h"
-
-USING_NS_CC;
+#include <algorithm>
 
 PlayerStats::PlayerStats() : _health(0), _soul(0) {}
 
@@ -21,6 +20,14 @@ void PlayerStats::reset()
     if (onSoulChanged) onSoulChanged(_soul);
 }
 
+void PlayerStats::restore(int health, int soul)
+{
+    _health = std::max(0, std::min(health, _config.maxHealth));
+    _soul = std::max(0, std::min(soul, _config.maxSoul));
+    if (onHealthChanged) onHealthChanged(_health, _config.maxHealth);
+    if (onSoulChanged) onSoulChanged(_soul);
+}
+
 bool PlayerStats::canFocus() const
 {
     return (_soul >= _config.healCost) && (_health < _config.maxHealth);
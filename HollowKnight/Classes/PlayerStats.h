@@ -1,9 +1,8 @@
 #ifndef __PLAYER_STATS_H__
 #define __PLAYER_STATS_H__
 
-#include "cocos2d.h"
 #include <functional>
-#include "Config.h" // Ϊʶṹ嶨壬"Լ"Ǻ
+#include "SimConfig.h" // ֻã cocosͷģ
 
 class PlayerStats
 {
@@ -19,6 +18,8 @@ public:
     void gainSoulOnKill(); // רڹػ
     void gainSoul(int amount); // ͨüӼ
     void reset();
+    // ӿջָ (֪ͨ UI)
+    void restore(int health, int soul);
 
     // --- ѯ ---
     bool isDead() const { return _health <= 0; }
@@ -0,0 +1,78 @@
+#include "PreloadScene.h"
+#include "AssetPreloader.h"
+#include "KeyBindingScene.h"
+#include "config.h"
+
+USING_NS_CC;
+
+Scene* PreloadScene::createScene()
+{
+    return PreloadScene::create();
+}
+
+bool PreloadScene::init()
+{
+    if (!Scene::init())
+    {
+        return false;
+    }
+
+    auto visibleSize = Director::getInstance()->getVisibleSize();
+    Vec2 origin = Director::getInstance()->getVisibleOrigin();
+
+    this->addChild(LayerColor::create(Color4B::BLACK));
+
+    // Ļ·У + 
+    float width = visibleSize.width * 0.4f;
+    float height = 12.0f;
+    _barRect = Rect(origin.x + (visibleSize.width - width) / 2, origin.y + visibleSize.height * 0.2f, width, height);
+
+    _bar = DrawNode::create();
+    this->addChild(_bar);
+
+    _label = Label::createWithTTF("0%", Config::Preload::FONT, 24.0f);
+    if (_label) {
+        _label->setPosition(Vec2(_barRect.getMidX(), _barRect.getMaxY() + 30.0f));
+        _label->setTextColor(Color4B(200, 200, 200, 255));
+        this->addChild(_label);
+    }
+
+    drawProgress(0.0f);
+    return true;
+}
+
+void PreloadScene::onEnter()
+{
+    Scene::onEnter();
+
+    // 嵥ʱ pump ֱӷɣԴԭķʽõʱȡ
+    AssetPreloader::getInstance()->begin();
+    this->scheduleUpdate();
+}
+
+void PreloadScene::update(float dt)
+{
+    _elapsed += dt;
+    if (_leaving) return;
+
+    auto preloader = AssetPreloader::getInstance();
+    bool done = preloader->pump(Config::Preload::FRAME_BUDGET_MS);
+    drawProgress(preloader->getProgress());
+
+    if (done && _elapsed >= Config::Preload::MIN_SHOW_TIME)
+    {
+        _leaving = true;
+        this->unscheduleUpdate();
+        Director::getInstance()->replaceScene(TransitionFade::create(0.5f, KeyBindingScene::createScene(), Color3B::BLACK));
+    }
+}
+
+void PreloadScene::drawProgress(float progress)
+{
+    _bar->clear();
+    _bar->drawRect(_barRect.origin - Vec2(2, 2), Vec2(_barRect.getMaxX(), _barRect.getMaxY()) + Vec2(2, 2), Color4F(0.6f, 0.6f, 0.6f, 1.0f));
+    if (progress > 0.0f) {
+        _bar->drawSolidRect(_barRect.origin, _barRect.origin + Vec2(_barRect.size.width * progress, _barRect.size.height), Color4F::WHITE);
+    }
+    if (_label) _label->setString(StringUtils::format("%d%%", (int)(progress * 100)));
+}
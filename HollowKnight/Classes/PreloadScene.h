@@ -0,0 +1,31 @@
+#ifndef __PRELOAD_SCENE_H__
+#define __PRELOAD_SCENE_H__
+
+#include "cocos2d.h"
+
+// ==========================================
+// س (Ϸĵһ)
+//  AssetPreloader ֡Ԥأʾɺеλó
+// ==========================================
+class PreloadScene : public cocos2d::Scene
+{
+public:
+    static cocos2d::Scene* createScene();
+
+    virtual bool init() override;
+    virtual void onEnter() override;
+    virtual void update(float dt) override;
+
+    CREATE_FUNC(PreloadScene);
+
+private:
+    void drawProgress(float progress);
+
+    cocos2d::DrawNode* _bar = nullptr;
+    cocos2d::Label* _label = nullptr;
+    cocos2d::Rect _barRect;
+    float _elapsed = 0.0f;
+    bool _leaving = false;
+};
+
+#endif // __PRELOAD_SCENE_H__
@@ -0,0 +1,214 @@
+#include "Profiler.h"
+#include "cocos2d.h"
+#include "config.h"
+#include "Log.h"
+#include <algorithm>
+#include <cstdio>
+#include <thread>
+
+USING_NS_CC;
+
+Profiler* Profiler::s_instance = nullptr;
+
+Profiler* Profiler::getInstance()
+{
+    if (!s_instance)
+    {
+        s_instance = new Profiler();
+    }
+    return s_instance;
+}
+
+Profiler::Profiler()
+    : _epochUs(0)
+    , _writers(0)
+    , _eventCount(0)
+    , _dropped(0)
+    , _capturing(false)
+    , _liveEnabled(false)
+    , _active(false)
+{
+}
+
+void Profiler::updateActive()
+{
+    _active.store(_capturing.load() || _liveEnabled.load());
+}
+
+unsigned int Profiler::currentThreadId()
+{
+    // trace С̺߳ţ std::thread::id ö
+    static std::atomic<unsigned int> s_nextId(1);
+    thread_local unsigned int t_id = s_nextId.fetch_add(1);
+    return t_id;
+}
+
+long long Profiler::nowUs() const
+{
+    using namespace std::chrono;
+    return duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+// ============================================================
+// ɼ
+// ============================================================
+void Profiler::beginCapture()
+{
+    if (isCapturing()) return;
+
+    if (_events.empty()) _events.resize(Config::Profiler::MAX_EVENTS);
+    _eventCount.store(0);
+    _dropped.store(0);
+    _epochUs.store(nowUs());
+    _capturing.store(true);
+    updateActive();
+    HK_LOG_INFO(GENERAL, "Profiler: capture started");
+}
+
+std::string Profiler::endCapture()
+{
+    if (!isCapturing()) return "";
+    _capturing.store(false);
+    updateActive();
+
+    // ܸ߳̿պд¼дٵ
+    while (_writers.load() != 0) std::this_thread::yield();
+
+    static int s_captureIndex = 0;
+    std::string path = FileUtils::getInstance()->getWritablePath()
+        + StringUtils::format("%s%d.json", Config::Profiler::TRACE_PREFIX, s_captureIndex++);
+
+    if (!exportChromeTrace(path)) return "";
+    HK_LOG_INFO(GENERAL, "Profiler: %u events (%u dropped) -> %s", (unsigned)getEventCount(), (unsigned)getDroppedCount(), path);
+    return path;
+}
+
+void Profiler::toggleCapture()
+{
+    if (isCapturing()) endCapture();
+    else beginCapture();
+}
+
+void Profiler::setLiveStatsEnabled(bool enabled)
+{
+    _liveEnabled.store(enabled);
+    updateActive();
+    if (!enabled) {
+        std::lock_guard<std::mutex> lock(_liveMutex);
+        _liveStats.clear();
+    }
+}
+
+void Profiler::takeLiveStats(std::vector<LiveStat>& out)
+{
+    std::lock_guard<std::mutex> lock(_liveMutex);
+    out = _liveStats;
+    for (auto& stat : _liveStats) {
+        stat.totalUs = 0;
+        stat.calls = 0;
+    }
+}
+
+// ============================================================
+// ¼
+// ============================================================
+void Profiler::record(const char* name, long long startUs, long long endUs)
+{
+    if (_liveEnabled.load(std::memory_order_relaxed) && endUs >= startUs)
+    {
+        std::lock_guard<std::mutex> lock(_liveMutex);
+        auto it = std::find_if(_liveStats.begin(), _liveStats.end(),
+            [name](const LiveStat& stat) { return stat.name == name; });
+        if (it == _liveStats.end()) {
+            _liveStats.push_back({ name, 0, 0 });
+            it = _liveStats.end() - 1;
+        }
+        it->totalUs += endUs - startUs;
+        it->calls++;
+    }
+
+    if (!isCapturing()) return;
+
+    // Բɼ㣻ɼʼǰӲɼζ֮ǰĲҪ
+    long long epoch = _epochUs.load(std::memory_order_relaxed);
+    if (endUs < epoch) return;
+    long long start = std::max(startUs, epoch) - epoch;
+    writeEvent(name, start, endUs - epoch - start);
+}
+
+void Profiler::writeEvent(const char* name, long long startUs, long long durationUs)
+{
+    // ȵǼȷһβɼ״̬ ( seq_cst)endCapture ־󿴵 _writers Ϊ 0
+    // Ͳ߳ _events д
+    _writers.fetch_add(1);
+    if (_capturing.load())
+    {
+        size_t index = _eventCount.fetch_add(1, std::memory_order_relaxed);
+        if (index < _events.size()) {
+            Event& e = _events[index];
+            e.name = name;
+            e.startUs = startUs;
+            e.durationUs = durationUs;
+            e.threadId = currentThreadId();
+        }
+        else {
+            _dropped.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+    _writers.fetch_sub(1);
+}
+
+void Profiler::markFrame()
+{
+    if (!isCapturing()) return;
+
+    // ָ֡óʱΪ -1 ¼ʾ instant ¼
+    writeEvent("frame", nowUs() - _epochUs.load(std::memory_order_relaxed), -1);
+}
+
+size_t Profiler::getEventCount() const
+{
+    return std::min(_eventCount.load(std::memory_order_relaxed), _events.size());
+}
+
+// ============================================================
+//  (Chrome trace event formatPerfetto ҲֱӴ)
+// ============================================================
+bool Profiler::exportChromeTrace(const std::string& path) const
+{
+    // ɼй̻߳д _eventsܱд߶
+    if (isCapturing()) {
+        HK_LOG_WARN(GENERAL, "Profiler: stop the capture before exporting");
+        return false;
+    }
+    size_t count = getEventCount();
+
+    std::string json;
+    json.reserve(count * 96 + 128);
+    json += "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+
+    char line[256];
+    for (size_t i = 0; i < count; i++)
+    {
+        const Event& e = _events[i];
+        if (e.durationUs < 0) {
+            snprintf(line, sizeof(line),
+                "{\"name\":\"%s\",\"ph\":\"i\",\"s\":\"g\",\"ts\":%lld,\"pid\":1,\"tid\":%u}",
+                e.name, e.startUs, e.threadId);
+        }
+        else {
+            snprintf(line, sizeof(line),
+                "{\"name\":\"%s\",\"cat\":\"game\",\"ph\":\"X\",\"ts\":%lld,\"dur\":%lld,\"pid\":1,\"tid\":%u}",
+                e.name, e.startUs, e.durationUs, e.threadId);
+        }
+        json += line;
+        json += (i + 1 < count) ? ",\n" : "\n";
+    }
+    json += "]}\n";
+
+    if (!FileUtils::getInstance()->writeStringToFile(json, path)) {
+        HK_LOG_ERROR(GENERAL, "Profiler: failed to write %s", path);
+        return false;
+    }
+    return true;
+}
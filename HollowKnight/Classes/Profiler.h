@@ -0,0 +1,186 @@
+#ifndef __PROFILER_H__
+#define __PROFILER_H__
+
+#include "AllocTracker.h"
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// ==========================================
+// ֡ڷֶμʱ (ʱ)
+// ÷
+//   HK_PROFILE_ZONE("HelloWorld::loadMap");        // Ϊֹһ
+//   HK_PROFILE_SECTIONS(sections);                 // һβӵķֶ
+//   HK_PROFILE_NEXT(sections, "update.camera");    // һΡʼһ
+// ֻڲɼвд¼ɼ󵼳Ϊ Chrome trace JSON
+// ֱϽ chrome://tracing  ui.perfetto.dev 鿴
+// ʵʱͳģʽ (ʱ)ֻۼӺʱд¼
+//  HK_RELEASE_LITE ʱкչΪգκο
+//  HK_TRACK_ALLOCS ʱʱͬʱΪѷĹ ( AllocTracker)
+// ==========================================
+#ifndef HK_RELEASE_LITE
+#define HK_PROFILER_ENABLED 1
+#else
+#define HK_PROFILER_ENABLED 0
+#endif
+
+class Profiler
+{
+public:
+    static Profiler* getInstance();
+
+    // һ¼ (Chrome trace  "X" ¼)
+    struct Event
+    {
+        const char* name;       // ָֻ룺ַ
+        long long startUs;
+        long long durationUs;
+        unsigned int threadId;
+    };
+
+    // ʼ / ɼʱԶдĿ¼
+    void beginCapture();
+    std::string endCapture();
+    // ݼûڲɼͿʼɼоͽ
+    void toggleCapture();
+    bool isCapturing() const { return _capturing.load(std::memory_order_relaxed); }
+
+    // ʵʱͳƣÿۼƵĺʱʹ (һγֵ˳)
+    struct LiveStat
+    {
+        const char* name;
+        long long totalUs;
+        int calls;
+    };
+    void setLiveStatsEnabled(bool enabled);
+    // ȡϴȡͳƲ
+    void takeLiveStats(std::vector<LiveStat>& out);
+
+    // ɼлʵʱͳ (ʱֻڴʱʱ)
+    bool isActive() const { return _active.load(std::memory_order_relaxed); }
+
+    // ÿ֡ͷһΣ trace ﻭָ֡
+    void markFrame();
+
+    // ǰʱ (ʱӣ΢)д¼ʱٻԲɼ
+    long long nowUs() const;
+
+    // һμʱڲɼ (ɼʼǰͽ) صɼ
+    void record(const char* name, long long startUs, long long endUs);
+
+    // Ѳɼ¼ (ɼеûʧܣ endCapture)
+    bool exportChromeTrace(const std::string& path) const;
+
+    size_t getEventCount() const;
+    size_t getDroppedCount() const { return _dropped.load(std::memory_order_relaxed); }
+
+private:
+    Profiler();
+    ~Profiler() = default;
+
+    static Profiler* s_instance;
+    static unsigned int currentThreadId();
+
+    // һ¼д (startUs ѾԲɼ)durationUs < 0 ʾ instant ¼
+    void writeEvent(const char* name, long long startUs, long long durationUs);
+
+    // ɼ (nowUs ֵ)߳д¼ʱʱԭ
+    std::atomic<long long> _epochUs;
+    //  record д¼߳endCapture ŵ
+    std::atomic<int> _writers;
+    std::vector<Event> _events;         // Ԥ䣬ɼв
+    std::atomic<size_t> _eventCount;
+    std::atomic<size_t> _dropped;       // ¼
+    std::atomic<bool> _capturing;
+
+    std::atomic<bool> _liveEnabled;
+    std::atomic<bool> _active;
+    std::mutex _liveMutex;
+    std::vector<LiveStat> _liveStats;   // ٣ԲҼ
+
+    void updateActive();
+};
+
+#if HK_PROFILER_ENABLED
+
+// ʱʱ㣬ʱдһ¼
+class ProfileZone
+{
+public:
+    explicit ProfileZone(const char* name)
+        : _name(name)
+        , _startUs(-1)
+    {
+        HK_ALLOC_ZONE_PUSH(name);
+        auto profiler = Profiler::getInstance();
+        if (profiler->isActive()) _startUs = profiler->nowUs();
+    }
+    ~ProfileZone()
+    {
+        HK_ALLOC_ZONE_POP();
+        if (_startUs < 0) return;
+        auto profiler = Profiler::getInstance();
+        profiler->record(_name, _startUs, profiler->nowUs());
+    }
+
+private:
+    const char* _name;
+    long long _startUs;
+};
+
+// βӵķֶμʱ (ʺϰŷֽڡ; return ĳ)
+class ProfileSections
+{
+public:
+    ProfileSections() : _name(nullptr), _startUs(-1) {}
+    ~ProfileSections()
+    {
+        close();
+        if (_name) HK_ALLOC_ZONE_POP();
+    }
+
+    void next(const char* name)
+    {
+        close();
+        // ŷֶ (Ƿڼʱ)
+        if (_name) HK_ALLOC_ZONE_POP();
+        HK_ALLOC_ZONE_PUSH(name);
+        _name = name;
+
+        auto profiler = Profiler::getInstance();
+        if (!profiler->isActive()) return;
+        _startUs = profiler->nowUs();
+    }
+
+private:
+    void close()
+    {
+        if (_startUs < 0) return;
+        auto profiler = Profiler::getInstance();
+        profiler->record(_name, _startUs, profiler->nowUs());
+        _startUs = -1;
+    }
+
+    const char* _name;
+    long long _startUs;
+};
+
+#define HK_PROFILE_CONCAT_INNER(a, b) a##b
+#define HK_PROFILE_CONCAT(a, b) HK_PROFILE_CONCAT_INNER(a, b)
+#define HK_PROFILE_ZONE(name) ProfileZone HK_PROFILE_CONCAT(__hkProfileZone, __LINE__)(name)
+#define HK_PROFILE_SECTIONS(var) ProfileSections var
+#define HK_PROFILE_NEXT(var, name) var.next(name)
+#define HK_PROFILE_FRAME() Profiler::getInstance()->markFrame()
+
+#else
+
+#define HK_PROFILE_ZONE(name) do {} while (0)
+#define HK_PROFILE_SECTIONS(var) do {} while (0)
+#define HK_PROFILE_NEXT(var, name) do {} while (0)
+#define HK_PROFILE_FRAME() do {} while (0)
+
+#endif // HK_PROFILER_ENABLED
+
+#endif // __PROFILER_H__
@@ -0,0 +1,358 @@
+#include "ScenarioRunner.h"
+#include "HelloWorldScene.h"
+#include "Boss.h"
+#include "Jar.h"
+#include "AllocTracker.h"
+#include "SimRandom.h"
+#include "InputRecorder.h"
+#include "AssetPreloader.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+USING_NS_CC;
+
+namespace {
+
+// ȷٷλ
+float percentile(std::vector<float> samples, float p)
+{
+    if (samples.empty()) return 0.0f;
+    size_t rank = (size_t)std::ceil(p * samples.size());
+    size_t index = std::min(samples.size() - 1, rank > 0 ? rank - 1 : 0);
+    std::nth_element(samples.begin(), samples.begin() + index, samples.end());
+    return samples[index];
+}
+
+// ÿ period ֡ס hold ֡ (/ԾҪɿٰ²Żᴥ)
+bool pulse(int frame, int period, int hold, int offset = 0)
+{
+    return ((frame + offset) % period) < hold;
+}
+
+} // namespace
+
+// ============================================================
+// ýű
+// ============================================================
+std::vector<Scenario> ScenarioRunner::builtinScenarios()
+{
+    std::vector<Scenario> list;
+
+    // 1. һشߵ (һ·һ·)ߵص״еΪֹ
+    {
+        Scenario s;
+        s.name = "level1_walkthrough";
+        s.level = 1;
+        s.maxFrames = Config::Scenario::LEVEL1_MAX_FRAMES;
+        s.drive = [](HelloWorld*, int frame, ScenarioInput& input) {
+            input.moveRight = true;
+            input.jump = pulse(frame, 45, 20);
+            input.attack = pulse(frame, 30, 4, 15);
+        };
+        s.isDone = [](HelloWorld* scene) {
+            return scene->_currentLevel != 1 || scene->_isTransitioning;
+        };
+        list.push_back(s);
+    }
+
+    // 2. ذйӴ (ù߹ȥ)
+    {
+        Scenario s;
+        s.name = "level2_break_jars";
+        s.level = 2;
+        s.maxFrames = Config::Scenario::LEVEL2_MAX_FRAMES;
+        s.drive = [](HelloWorld* scene, int frame, ScenarioInput& input) {
+            float px = scene->_player->getPositionX();
+            float target = px;
+            float best = -1.0f;
+            for (auto jar : scene->_jars) {
+                if (!jar || jar->isDestroyed()) continue;
+                float d = std::fabs(jar->getPositionX() - px);
+                if (best < 0 || d < best) { best = d; target = jar->getPositionX(); }
+            }
+            if (target > px + 60) input.moveRight = true;
+            else if (target < px - 60) input.moveLeft = true;
+            input.jump = pulse(frame, 60, 20);
+            input.attack = pulse(frame, 20, 4);
+        };
+        s.isDone = [](HelloWorld* scene) {
+            if (scene->_currentLevel != 2) return true;
+            for (auto jar : scene->_jars) {
+                if (jar && !jar->isDestroyed()) return false;
+            }
+            return true;
+        };
+        list.push_back(s);
+    }
+
+    // 3. ش Bossߴ֮ + żܣ򵽿񱩽׶ֱ֮ Boss 
+    {
+        Scenario s;
+        s.name = "level3_boss_fight";
+        s.level = 3;
+        s.maxFrames = Config::Scenario::LEVEL3_MAX_FRAMES;
+        s.requireRampage = true;
+        s.drive = [](HelloWorld* scene, int frame, ScenarioInput& input) {
+            float px = scene->_player->getPositionX();
+            float target = scene->_boss ? scene->_boss->getPositionX() : px + 500;
+            if (target > px + 150) input.moveRight = true;
+            else if (target < px - 150) input.moveLeft = true;
+            input.jump = pulse(frame, 90, 25);
+            input.attack = pulse(frame, 24, 4);
+            input.cast = pulse(frame, 240, 4, 120);
+        };
+        s.isDone = [](HelloWorld* scene) {
+            return scene->_currentLevel != 3 || (scene->_boss && scene->_boss->isDead());
+        };
+        list.push_back(s);
+    }
+
+    return list;
+}
+
+// ============================================================
+// 룺ֱλ (¼طһֻڱ仯ʱ·)
+// ============================================================
+void ScenarioRunner::applyInput(const ScenarioInput& input)
+{
+    uint16_t bits = 0;
+    if (input.moveLeft) bits |= InputBit::MOVE_LEFT;
+    if (input.moveRight) bits |= InputBit::MOVE_RIGHT;
+    if (input.jump) bits |= InputBit::JUMP;
+    if (input.attack) bits |= InputBit::ATTACK;
+    if (input.cast) bits |= InputBit::CAST_SPELL;
+    _scene->setInputBits(bits);
+}
+
+// ============================================================
+// ƽһ֡ ( update + ж) + Զͷųأ mainLoop ģⲿһ
+// ============================================================
+void ScenarioRunner::stepFrame(float dt)
+{
+    Director::getInstance()->getScheduler()->update(dt);
+    PoolManager::getInstance()->getCurrentPool()->clear();
+}
+
+bool ScenarioRunner::waitForTransition()
+{
+    for (int i = 0; i < Config::Scenario::TRANSITION_TIMEOUT; i++) {
+        if (!_scene->_isTransitioning) return true;
+        stepFrame(Config::Scenario::FIXED_DT);
+    }
+    return !_scene->_isTransitioning;
+}
+
+bool ScenarioRunner::startScene(const std::string& name, uint64_t seed)
+{
+    // ع/طű¼ӹ̶ÿܳʽһ
+    InputRecorder::getInstance()->setEnabled(false);
+    SimRandom::setSessionSeed(seed);
+
+    // һȰԴȫԤ (ֻеһ)֡ʱﲻ
+    AssetPreloader::getInstance()->finish();
+
+    auto director = Director::getInstance();
+    _scene = HelloWorld::create();
+    if (!_scene) {
+        CCLOG("Scenario [%s]: failed to create scene", name.c_str());
+        return false;
+    }
+
+    // Ϊеĳȥ (Ҫͨ getRunningScene ҵ)
+    // drawScene ֻһΣõл֮Ⱦ
+    if (director->getRunningScene()) director->replaceScene(_scene);
+    else director->runWithScene(_scene);
+    director->drawScene();
+    return true;
+}
+
+float ScenarioRunner::measureFrame(float dt, ScenarioReport& report)
+{
+    AllocTracker::Counters allocsBefore = AllocTracker::getTotals();
+    auto t0 = std::chrono::steady_clock::now();
+    Director::getInstance()->getScheduler()->update(dt);
+    auto t1 = std::chrono::steady_clock::now();
+    AllocTracker::Counters allocsAfter = AllocTracker::getTotals();
+    size_t allocs = allocsAfter.count - allocsBefore.count;
+    PoolManager::getInstance()->getCurrentPool()->clear();
+
+    report.totalAllocs += allocs;
+    report.totalAllocBytes += allocsAfter.bytes - allocsBefore.bytes;
+    report.maxFrameAllocs = std::max(report.maxFrameAllocs, allocs);
+    report.maxEntities = std::max(report.maxEntities, (int)_scene->_gameLayer->getChildrenCount());
+    if (_scene->_boss && _scene->_boss->isRampaging()) report.reachedRampage = true;
+
+    return std::chrono::duration<float, std::milli>(t1 - t0).count();
+}
+
+void ScenarioRunner::finishReport(ScenarioReport& report, std::vector<float>& frameMs)
+{
+    report.frames = (int)frameMs.size();
+    if (!frameMs.empty()) {
+        float sum = 0.0f;
+        for (float ms : frameMs) sum += ms;
+        auto maxIt = std::max_element(frameMs.begin(), frameMs.end());
+        report.avgMs = sum / frameMs.size();
+        report.maxMs = *maxIt;
+        report.maxFrame = (int)(maxIt - frameMs.begin());
+        report.p50Ms = percentile(frameMs, 0.50f);
+        report.p99Ms = percentile(frameMs, 0.99f);
+    }
+
+    CCLOG("Scenario [%s]: %d frames, completed=%d, avg=%.3fms p50=%.3fms p99=%.3fms (budget %.2fms) max=%.3fms @%d, allocs=%zu / %zu bytes (max %zu/frame), entities<=%d",
+        report.name.c_str(), report.frames, report.completed ? 1 : 0,
+        report.avgMs, report.p50Ms, report.p99Ms, report.budgetMs, report.maxMs, report.maxFrame,
+        report.totalAllocs, report.totalAllocBytes, report.maxFrameAllocs, report.maxEntities);
+
+    _scene = nullptr; // 鵼ݹһ replaceScene ˳ʱͷ
+}
+
+ScenarioReport ScenarioRunner::run(const Scenario& scenario)
+{
+    ScenarioReport report;
+    report.name = scenario.name;
+    report.budgetMs = scenario.budgetP99Ms;
+    report.requireRampage = scenario.requireRampage;
+
+    KeyBindingManager::Scope bindingScope(_bindings);
+    if (!startScene(scenario.name, Config::Replay::SCENARIO_SEED)) return report;
+
+    const float dt = Config::Scenario::FIXED_DT;
+
+    // 1. Ĺؿл̵Ŀؿ
+    if (scenario.level == 2) _scene->switchToLevel2();
+    else if (scenario.level == 3) _scene->switchToLevel3();
+    if (!waitForTransition()) {
+        CCLOG("Scenario [%s]: level transition timed out", scenario.name.c_str());
+        return report;
+    }
+
+    // 2. Ԥȣ״μ/䲻ͳ
+    for (int i = 0; i < Config::Scenario::WARMUP_FRAMES; i++) stepFrame(dt);
+
+    // 3. ű֡ƽ
+    std::vector<float> frameMs;
+    frameMs.reserve(scenario.maxFrames);
+    for (int frame = 0; frame < scenario.maxFrames; frame++)
+    {
+        if (scenario.isDone(_scene)) {
+            report.completed = true;
+            break;
+        }
+
+        ScenarioInput input;
+        scenario.drive(_scene, frame, input);
+        applyInput(input);
+
+        frameMs.push_back(measureFrame(dt, report));
+    }
+    if (!report.completed) report.completed = scenario.isDone(_scene);
+
+    applyInput(ScenarioInput()); // ɿм
+
+    // 4. ͳ
+    finishReport(report, frameMs);
+    return report;
+}
+
+// ============================================================
+// ¼طţ½ʼÿ֡·¼µλ¼µ dt ƽ
+// (¼ʱλڳ update ͷµģ¼ε֮䵽
+//  ڵ update ֮ǰ·ǵȼ۵)
+// ============================================================
+ScenarioReport ScenarioRunner::runReplay(const InputRecording& recording, const std::string& name)
+{
+    ScenarioReport report;
+    report.name = name;
+    report.budgetMs = Config::Scenario::P99_BUDGET_MS;
+
+    KeyBindingManager::Scope bindingScope(_bindings);
+    if (!startScene(name, recording.seed)) return report;
+    if (recording.startLevel != _scene->_currentLevel) {
+        CCLOG("Scenario [%s]: recorded from level %d, scene starts at level %d, replay may diverge",
+            name.c_str(), recording.startLevel, _scene->_currentLevel);
+    }
+
+    std::vector<float> frameMs;
+    frameMs.reserve(recording.frames.size());
+    for (const auto& frame : recording.frames)
+    {
+        _scene->setInputBits(frame.bits);
+        frameMs.push_back(measureFrame(frame.dt, report));
+    }
+    _scene->setInputBits(0);
+    report.completed = true;
+
+    finishReport(report, frameMs);
+    return report;
+}
+
+bool ScenarioRunner::runReplayFile(const std::string& replayPath, const std::string& reportPath)
+{
+    InputRecording recording;
+    if (!recording.load(replayPath)) {
+        CCLOG("Replay: cannot read %s", replayPath.c_str());
+        return false;
+    }
+    CCLOG("Replay: %s, seed %llu, %d frames", replayPath.c_str(), (unsigned long long)recording.seed, (int)recording.frames.size());
+
+    std::vector<ScenarioReport> reports;
+    reports.push_back(runReplay(recording, "replay"));
+    if (!reportPath.empty()) {
+        FileUtils::getInstance()->writeStringToFile(toJson(reports), reportPath);
+        CCLOG("Replay report written to %s", reportPath.c_str());
+    }
+    return reports.back().withinBudget();
+}
+
+// ============================================================
+// ȫһ + 
+// ============================================================
+bool ScenarioRunner::runAll(const std::string& reportPath)
+{
+    std::vector<ScenarioReport> reports;
+    bool allOk = true;
+    for (const auto& scenario : builtinScenarios())
+    {
+        reports.push_back(run(scenario));
+        const auto& r = reports.back();
+        if (!r.withinBudget()) {
+            CCLOG("Scenario [%s]: FAILED, p99 %.3fms over budget %.2fms", r.name.c_str(), r.p99Ms, r.budgetMs);
+            allOk = false;
+        }
+        if (!r.completed) {
+            CCLOG("Scenario [%s]: FAILED, script goal not reached in %d frames", r.name.c_str(), r.frames);
+            allOk = false;
+        }
+        else if (!r.goalReached()) {
+            CCLOG("Scenario [%s]: FAILED, boss never reached the rampage phase", r.name.c_str());
+            allOk = false;
+        }
+    }
+
+    if (!reportPath.empty()) {
+        FileUtils::getInstance()->writeStringToFile(toJson(reports), reportPath);
+        CCLOG("Scenario report written to %s", reportPath.c_str());
+    }
+    return allOk;
+}
+
+std::string ScenarioRunner::toJson(const std::vector<ScenarioReport>& reports)
+{
+    std::string json = "{\n  \"scenarios\": [\n";
+    for (size_t i = 0; i < reports.size(); i++)
+    {
+        const auto& r = reports[i];
+        json += StringUtils::format(
+            "    {\"name\": \"%s\", \"frames\": %d, \"completed\": %s, \"reached_rampage\": %s, "
+            "\"avg_ms\": %.4f, \"p50_ms\": %.4f, \"p99_ms\": %.4f, \"max_ms\": %.4f, \"max_frame\": %d, \"budget_ms\": %.4f, "
+            "\"within_budget\": %s, \"total_allocs\": %zu, \"total_alloc_bytes\": %zu, \"max_frame_allocs\": %zu, \"max_entities\": %d}%s\n",
+            r.name.c_str(), r.frames, r.completed ? "true" : "false", r.reachedRampage ? "true" : "false",
+            r.avgMs, r.p50Ms, r.p99Ms, r.maxMs, r.maxFrame, r.budgetMs,
+            r.withinBudget() ? "true" : "false", r.totalAllocs, r.totalAllocBytes, r.maxFrameAllocs, r.maxEntities,
+            i + 1 < reports.size() ? "," : "");
+    }
+    json += "  ]\n}\n";
+    return json;
+}
@@ -0,0 +1,104 @@
+#ifndef __SCENARIO_RUNNER_H__
+#define __SCENARIO_RUNNER_H__
+
+#include "cocos2d.h"
+#include "config.h"
+#include "KeyBindingScene.h"
+#include <functional>
+#include <string>
+#include <vector>
+
+class HelloWorld;
+struct InputRecording;
+
+// ==========================================
+// ع (֡Ԥ)
+// ù̶ֱ HelloWorld ĵ ( mainLoopȾ)
+// űģⰴ֡¼ģʱ / ڴ / ʵ
+// p99 ֡ʱԤжʧ
+// ܳʱλ runner ԼĬϼλ (KeyBindingManager::Scope)ҸĹļλӰ
+// ==========================================
+
+// ĳһ֡Ҫסļ (λֱӽ HelloWorld::setInputBits¼طһ
+// ¼У뻺岻룬űдľÿһ֡ʵ)
+struct ScenarioInput
+{
+    bool moveLeft = false;
+    bool moveRight = false;
+    bool jump = false;
+    bool attack = false;
+    bool cast = false;
+};
+
+struct Scenario
+{
+    std::string name;
+    int level = 1;                  // һؿʼ (2/3  switchToLevelN )
+    int maxFrames = 0;
+    float budgetP99Ms = Config::Scenario::P99_BUDGET_MS;
+    bool requireRampage = false;    // p99 ԤҪ Boss 񱩽׶Σû򵽾ʧ
+
+    // ÿ֡
+    std::function<void(HelloWorld* scene, int frame, ScenarioInput& input)> drive;
+    // űĿǷ (ߵصסȫ顢Boss )
+    std::function<bool(HelloWorld* scene)> isDone;
+};
+
+struct ScenarioReport
+{
+    std::string name;
+    int frames = 0;
+    bool completed = false;
+    bool reachedRampage = false;    // Boss Ƿ˿񱩽׶
+    bool requireRampage = false;
+
+    float budgetMs = 0.0f;
+    float avgMs = 0.0f;
+    float p50Ms = 0.0f;
+    float p99Ms = 0.0f;
+    float maxMs = 0.0f;
+    int maxFrame = -1;              // ǵڼ֡ (طʱӦ¼֡)
+
+    size_t totalAllocs = 0;         // ֻж HK_TRACK_ALLOCS ʱ
+    size_t totalAllocBytes = 0;
+    size_t maxFrameAllocs = 0;
+    int maxEntities = 0;            // Ϸӽڵķֵ
+
+    bool withinBudget() const { return frames > 0 && p99Ms <= budgetMs; }
+    // űĿ (Boss Ҫ򵽿񱩽׶)ûʱ p99 ǱĲ֣
+    bool goalReached() const { return completed && (!requireRampage || reachedRampage); }
+};
+
+class ScenarioRunner
+{
+public:
+    // ýűһߵסشӡش Boss ֱ֮
+    static std::vector<Scenario> builtinScenarios();
+
+    ScenarioReport run(const Scenario& scenario);
+
+    // ȫóд JSON 棬һԤͷ false
+    bool runAll(const std::string& reportPath);
+
+    // ¼֡طһ (ͬӡͬλ dt)ʵʱ
+    ScenarioReport runReplay(const InputRecording& recording, const std::string& name);
+    // ȡ¼񡢻طŲд JSON 
+    bool runReplayFile(const std::string& replayPath, const std::string& reportPath);
+
+private:
+    void applyInput(const ScenarioInput& input);
+    void stepFrame(float dt);
+    bool waitForTransition();
+
+    bool startScene(const std::string& name, uint64_t seed);
+    // ʱƽһ֡ۼͳƣģʱ ()
+    float measureFrame(float dt, ScenarioReport& report);
+    void finishReport(ScenarioReport& report, std::vector<float>& frameMs);
+
+    static std::string toJson(const std::vector<ScenarioReport>& reports);
+
+    HelloWorld* _scene = nullptr;
+    KeyBindingManager _bindings{ false };
+};
+
+#endif // __SCENARIO_RUNNER_H__
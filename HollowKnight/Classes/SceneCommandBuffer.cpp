@@ -0,0 +1,104 @@
+#include "SceneCommandBuffer.h"
+#include "JobSystem.h"
+#include <algorithm>
+
+USING_NS_CC;
+
+void SceneCommandBuffer::resize(int threadCount, size_t reservePerLane)
+{
+    _lanes.resize(std::max(threadCount, 1));
+    for (auto& lane : _lanes) lane.reserve(reservePerLane);
+    _merged.reserve(reservePerLane * _lanes.size());
+}
+
+std::vector<SceneCommandBuffer::Command>& SceneCommandBuffer::lane()
+{
+    int index = JobSystem::getThreadIndex();
+    CCASSERT(index < (int)_lanes.size(), "SceneCommandBuffer: resize() with JobSystem::getThreadCount() first");
+    return _lanes[index];
+}
+
+void SceneCommandBuffer::push(const Command& command)
+{
+    auto& commands = lane();
+    commands.push_back(command);
+    commands.back().seq = (int)commands.size();
+}
+
+void SceneCommandBuffer::setPosition(int order, Node* node, const Vec2& position)
+{
+    push({ order, 0, Op::SET_POSITION, false, node, position, nullptr, 0 });
+}
+
+void SceneCommandBuffer::setVisible(int order, Node* node, bool visible)
+{
+    push({ order, 0, Op::SET_VISIBLE, visible, node, Vec2::ZERO, nullptr, 0 });
+}
+
+void SceneCommandBuffer::setFlippedX(int order, Sprite* sprite, bool flipped)
+{
+    push({ order, 0, Op::SET_FLIPPED_X, flipped, sprite, Vec2::ZERO, nullptr, 0 });
+}
+
+void SceneCommandBuffer::removeFromParent(int order, Node* node)
+{
+    push({ order, 0, Op::REMOVE, false, node, Vec2::ZERO, nullptr, 0 });
+}
+
+void SceneCommandBuffer::call(int order, Node* node, CallFn fn, int arg)
+{
+    push({ order, 0, Op::CALL, false, node, Vec2::ZERO, fn, arg });
+}
+
+bool SceneCommandBuffer::empty() const
+{
+    for (const auto& lane : _lanes) {
+        if (!lane.empty()) return false;
+    }
+    return true;
+}
+
+void SceneCommandBuffer::clear()
+{
+    for (auto& lane : _lanes) lane.clear();
+}
+
+void SceneCommandBuffer::commit()
+{
+    _merged.clear();
+    for (auto& lane : _lanes) {
+        _merged.insert(_merged.end(), lane.begin(), lane.end());
+        lane.clear();
+    }
+    if (_merged.empty()) return;
+
+    std::sort(_merged.begin(), _merged.end(), [](const Command& a, const Command& b) {
+        return a.order != b.order ? a.order < b.order : a.seq < b.seq;
+    });
+
+    for (const auto& command : _merged)
+    {
+        switch (command.op)
+        {
+        case Op::SET_POSITION:
+            command.node->setPosition(command.position);
+            break;
+        case Op::SET_VISIBLE:
+            command.node->setVisible(command.flag);
+            break;
+        case Op::SET_FLIPPED_X:
+            static_cast<Sprite*>(command.node)->setFlippedX(command.flag);
+            break;
+        case Op::CALL:
+            command.fn(command.node, command.arg);
+            break;
+        case Op::REMOVE:
+            // ͬһܻ֡ڵ (ߵ÷ָ)ӳٵ֡ĩͷ
+            command.node->retain();
+            command.node->removeFromParent();
+            command.node->autorelease();
+            break;
+        }
+    }
+    _merged.clear();
+}
@@ -0,0 +1,61 @@
+#ifndef __SCENE_COMMAND_BUFFER_H__
+#define __SCENE_COMMAND_BUFFER_H__
+
+#include "cocos2d.h"
+#include <vector>
+
+// ==========================================
+// ͼ޸Ļ
+// cocos Ľڵֻ߳ϸģJobSystem Ҫ޸ļ
+// ߳ parallelFor غͳһ commit
+// - ÿ߳һļ¼ͨ ( JobSystem::getThreadIndex ȡ)¼ʱ
+// - ÿһ (һʵб±)commit ʱ
+//   ִ˳߳ô͵޹
+// - ͨԤ reserve̬¼¼ڴ
+// - ״̬runAction ûɵԵ޸ callһָ룬߳ϰ˳
+// ==========================================
+class SceneCommandBuffer
+{
+public:
+    // threadCount = JobSystem::getThreadCount()
+    void resize(int threadCount, size_t reservePerLane = 64);
+
+    void setPosition(int order, cocos2d::Node* node, const cocos2d::Vec2& position);
+    void setVisible(int order, cocos2d::Node* node, bool visible);
+    void setFlippedX(int order, cocos2d::Sprite* sprite, bool flipped);
+    void removeFromParent(int order, cocos2d::Node* node);
+
+    // ߳ϵ fn(node, arg)
+    using CallFn = void (*)(cocos2d::Node* node, int arg);
+    void call(int order, cocos2d::Node* node, CallFn fn, int arg);
+
+    // ִ̣߳
+    void commit();
+    // ֱִӶ (йʱ)
+    void clear();
+
+    bool empty() const;
+
+private:
+    enum class Op : uint8_t { SET_POSITION, SET_VISIBLE, SET_FLIPPED_X, REMOVE, CALL };
+
+    struct Command
+    {
+        int order;
+        int seq;            // ͬһڰ¼Ⱥ
+        Op op;
+        bool flag;          // SET_VISIBLE / SET_FLIPPED_X
+        cocos2d::Node* node;
+        cocos2d::Vec2 position;
+        CallFn fn;
+        int arg;
+    };
+
+    std::vector<Command>& lane();
+    void push(const Command& command);
+
+    std::vector<std::vector<Command>> _lanes;
+    std::vector<Command> _merged;           // commit ʱϲã
+};
+
+#endif // __SCENE_COMMAND_BUFFER_H__
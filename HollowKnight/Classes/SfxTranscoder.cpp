@@ -0,0 +1,190 @@
+#include "SfxTranscoder.h"
+#include "cocos2d.h"
+#include "config.h"
+#include "Log.h"
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#if (CC_TARGET_PLATFORM == CC_PLATFORM_WIN32 || CC_TARGET_PLATFORM == CC_PLATFORM_LINUX)
+#include "audio/include/AudioDecoder.h"
+#include "audio/include/AudioDecoderManager.h"
+#define HK_SFX_CAN_DECODE 1
+#endif
+
+USING_NS_CC;
+
+namespace {
+    const size_t WAV_HEADER_BYTES = 44;
+
+    void put16(std::vector<char>& out, uint16_t v)
+    {
+        out.push_back((char)(v & 0xFF));
+        out.push_back((char)(v >> 8));
+    }
+    void put32(std::vector<char>& out, uint32_t v)
+    {
+        put16(out, (uint16_t)(v & 0xFFFF));
+        put16(out, (uint16_t)(v >> 16));
+    }
+    uint16_t get16(const unsigned char* p) { return (uint16_t)(p[0] | (p[1] << 8)); }
+    uint32_t get32(const unsigned char* p) { return get16(p) | ((uint32_t)get16(p + 2) << 16); }
+
+    // 16 λ PCM  WAV ͷ
+    void writeWavHeader(std::vector<char>& out, uint32_t channels, uint32_t sampleRate, uint32_t dataBytes)
+    {
+        out.insert(out.end(), { 'R', 'I', 'F', 'F' });
+        put32(out, 36 + dataBytes);
+        out.insert(out.end(), { 'W', 'A', 'V', 'E', 'f', 'm', 't', ' ' });
+        put32(out, 16);
+        put16(out, 1);                          // PCM
+        put16(out, (uint16_t)channels);
+        put32(out, sampleRate);
+        put32(out, sampleRate * channels * 2);  // ÿֽ
+        put16(out, (uint16_t)(channels * 2));   // ÿֽ֡
+        put16(out, 16);
+        out.insert(out.end(), { 'd', 'a', 't', 'a' });
+        put32(out, dataBytes);
+    }
+}
+
+SfxTranscoder* SfxTranscoder::getInstance()
+{
+    static SfxTranscoder s_instance;
+    return &s_instance;
+}
+
+const std::string& SfxTranscoder::prepare(const std::string& path)
+{
+    auto it = _playPaths.find(path);
+    if (it != _playPaths.end()) return it->second;
+
+    std::string& playPath = _playPaths[path];
+    playPath = path;
+
+    auto fileUtils = FileUtils::getInstance();
+    std::string fullPath = fileUtils->fullPathForFilename(path);
+    if (fullPath.empty()) return playPath;
+
+    // WAV ļԭļ + ԴļС (زľͶԲϣ)
+    //  _v2ǰİ汾˵
+    size_t slash = path.find_last_of('/');
+    size_t dot = path.find_last_of('.');
+    std::string stem = path.substr(slash == std::string::npos ? 0 : slash + 1,
+                                   dot == std::string::npos || dot < slash + 1 ? std::string::npos : dot - (slash + 1));
+    std::string dir = fileUtils->getWritablePath() + Config::Sfx::CACHE_DIR;
+    std::string wavPath = StringUtils::format("%s%s_%ld_v2.wav", dir.c_str(), stem.c_str(), fileUtils->getFileSize(fullPath));
+
+    size_t pcmBytes = 0;
+    if (fileUtils->isFileExist(wavPath)) {
+        pcmBytes = validateWav(wavPath);
+        if (pcmBytes == 0) {
+            // ϴд (߱Ĺ)ɾת
+            HK_LOG_WARN(AUDIO, "SfxTranscoder: %s is corrupt, transcoding again", wavPath);
+            fileUtils->removeFile(wavPath);
+        }
+        else if (_pcmBytes + pcmBytes > (size_t)Config::Sfx::BUDGET_KB * 1024) {
+            return playPath;
+        }
+    }
+    if (pcmBytes == 0) {
+        if (!fileUtils->isDirectoryExist(dir)) fileUtils->createDirectory(dir);
+        pcmBytes = decodeToWav(fullPath, wavPath);
+    }
+
+    if (pcmBytes > 0) {
+        playPath = wavPath;
+        _pcmBytes += pcmBytes;
+        _transcodedCount++;
+        HK_LOG_DEBUG(AUDIO, "SfxTranscoder: %s -> PCM (%u KB, total %u KB)", path,
+                     (unsigned)(pcmBytes / 1024), (unsigned)(_pcmBytes / 1024));
+    }
+    return playPath;
+}
+
+size_t SfxTranscoder::validateWav(const std::string& wavPath) const
+{
+    Data data = FileUtils::getInstance()->getDataFromFile(wavPath);
+    const unsigned char* p = data.getBytes();
+    size_t size = (size_t)data.getSize();
+    if (size <= WAV_HEADER_BYTES) return 0;
+
+    uint32_t channels = get16(p + 22);
+    uint32_t dataBytes = get32(p + 40);
+    bool ok = memcmp(p, "RIFF", 4) == 0 && get32(p + 4) == size - 8
+        && memcmp(p + 8, "WAVEfmt ", 8) == 0 && get32(p + 16) == 16
+        && get16(p + 20) == 1 && (channels == 1 || channels == 2)
+        && get16(p + 32) == channels * 2 && get16(p + 34) == 16
+        && memcmp(p + 36, "data", 4) == 0 && dataBytes == size - WAV_HEADER_BYTES;
+    return ok ? dataBytes : 0;
+}
+
+#if HK_SFX_CAN_DECODE
+size_t SfxTranscoder::decodeToWav(const std::string& srcFullPath, const std::string& wavPath)
+{
+    using namespace cocos2d::experimental;
+
+    AudioDecoderManager::init();
+    AudioDecoder* decoder = AudioDecoderManager::createDecoder(srcFullPath.c_str());
+    if (!decoder) return 0;
+
+    size_t result = 0;
+    uint32_t channels = decoder->getChannelCount();
+    uint32_t sampleRate = decoder->getSampleRate();
+    uint32_t totalFrames = decoder->getTotalFrames();
+    size_t dataBytes = (size_t)totalFrames * channels * 2;
+
+    // ЧѹʽװµҲ
+    if (channels == 0 || channels > 2 || sampleRate == 0 || totalFrames == 0
+        || totalFrames > sampleRate * Config::Sfx::MAX_SECONDS
+        || _pcmBytes + dataBytes > (size_t)Config::Sfx::BUDGET_KB * 1024) {
+        AudioDecoderManager::destroyDecoder(decoder);
+        return 0;
+    }
+
+    //  16 λ PCMԭ
+    std::vector<char> wav;
+    wav.reserve(WAV_HEADER_BYTES + dataBytes);
+    writeWavHeader(wav, channels, sampleRate, 0);
+
+    const uint32_t CHUNK_FRAMES = 4096;
+    std::vector<int16_t> chunk((size_t)CHUNK_FRAMES * channels);
+    uint32_t framesDone = 0;
+    while (framesDone < totalFrames)
+    {
+        uint32_t got = decoder->read(std::min(CHUNK_FRAMES, totalFrames - framesDone), (char*)chunk.data());
+        if (got == 0) break;
+        const char* bytes = (const char*)chunk.data();
+        wav.insert(wav.end(), bytes, bytes + (size_t)got * channels * 2);
+        framesDone += got;
+    }
+    AudioDecoderManager::destroyDecoder(decoder);
+
+    // ʵʽܱ֡ļͷ٣ʵʳȲдͷ
+    uint32_t written = (uint32_t)(wav.size() - WAV_HEADER_BYTES);
+    if (written == 0) return 0;
+    std::vector<char> header;
+    writeWavHeader(header, channels, sampleRate, written);
+    std::copy(header.begin(), header.end(), wav.begin());
+
+    // дʱļٸ;˳ֻ .tmpᱻ WAV
+    auto fileUtils = FileUtils::getInstance();
+    std::string tmpPath = wavPath + ".tmp";
+    Data data;
+    data.copy((const unsigned char*)wav.data(), (ssize_t)wav.size());
+    if (fileUtils->writeDataToFile(data, tmpPath) && fileUtils->renameFile(tmpPath, wavPath)) {
+        result = written;
+    }
+    else {
+        HK_LOG_WARN(AUDIO, "SfxTranscoder: cannot write %s", wavPath);
+        fileUtils->removeFile(tmpPath);
+    }
+    return result;
+}
+#else
+// ƽ̨ cocos ûеЧԭļ
+size_t SfxTranscoder::decodeToWav(const std::string&, const std::string&)
+{
+    return 0;
+}
+#endif
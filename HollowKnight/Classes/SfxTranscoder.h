@@ -0,0 +1,46 @@
+#ifndef __SFX_TRANSCODER_H__
+#define __SFX_TRANSCODER_H__
+
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+
+// ==========================================
+// Чʱת ()
+// Ч (<= Config::Sfx::MAX_SECONDS) Ԥʱ cocos ԴĽ 16 λ PCM
+// д WAV ڿдĿ¼Ժֱļʱ治 MP3 
+// - ԭ (زĲɵ)
+// - ת Config::Sfx::BUDGET_KB ġ̫ġʧܵģԭѹļ
+// - дʱļٸ;˳° WAVǰУͷļȣԲϾת
+// - ֻ Win32 / Linux  cocos  AudioDecoderƽֱ̨ԭļ
+// - ֲ (MusicPlayer ʽ)
+// ֻܴϵļ PCM Žڴ AudioEngine::preload 
+// WAV ļԴļСزĻ
+// ==========================================
+class SfxTranscoder
+{
+public:
+    static SfxTranscoder* getInstance();
+
+    // ʵʽƵ· (ת WAV ԭ·)һĳļʱת
+    // صڳ˳ǰһֱЧ
+    const std::string& prepare(const std::string& path);
+
+    // תЧ PCM ֽ
+    size_t getPcmBytes() const { return _pcmBytes; }
+    int getTranscodedCount() const { return _transcodedCount; }
+
+private:
+    SfxTranscoder() {}
+
+    // е WAV Ƿ (ͷϷȺͷдһ)ǵĻ PCM ֽ򷵻 0
+    size_t validateWav(const std::string& wavPath) const;
+    //  srcFullPath д wavPathɹʱ PCM ֽʧ/̫/Ԥ㷵 0
+    size_t decodeToWav(const std::string& srcFullPath, const std::string& wavPath);
+
+    std::unordered_map<std::string, std::string> _playPaths; // ԭ· -> ·
+    size_t _pcmBytes = 0;
+    int _transcodedCount = 0;
+};
+
+#endif // __SFX_TRANSCODER_H__
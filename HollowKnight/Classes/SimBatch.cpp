@@ -0,0 +1,157 @@
+#include "SimBatch.h"
+#include "SimRandom.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+namespace {
+    double msSince(const std::chrono::steady_clock::time_point& start)
+    {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+}
+
+SimBatchRunner::SimBatchRunner(int threads)
+{
+    if (threads <= 0) threads = (int)std::thread::hardware_concurrency();
+    _threads = std::max(1, std::min(threads, Config::Batch::MAX_THREADS));
+}
+
+// ============================================================
+// Ự
+// ============================================================
+SimSessionResult SimBatchRunner::runSession(const SimSessionSpec& spec) const
+{
+    auto start = std::chrono::steady_clock::now();
+
+    // ỰԼ (뿪ǰָ̻߳ԭ)
+    RandomStreams streams;
+    SimRandom::Scope scope(streams);
+    SimRandom::seedAll(spec.seed);
+
+    SimWorld world;
+    if (_setup) _setup(world);
+    else defaultWorldSetup(world);
+
+    int frames = spec.frames;
+    if (spec.replay) frames = std::min(frames, (int)spec.replay->size());
+
+    for (int f = 0; f < frames; f++)
+    {
+        if (spec.replay) {
+            const InputFrame& in = (*spec.replay)[f];
+            world.step(in.dt, inputFromBits(in.bits));
+        }
+        else {
+            world.step(spec.dt, _bot ? _bot(world, f) : defaultBot(world, f));
+        }
+    }
+
+    SimSessionResult result;
+    result.seed = spec.seed;
+    result.frames = frames;
+    result.rescueCount = world.getRescueCount();
+    result.health = world.getStats().getHealth();
+    result.finalPosition = world.getPlayer().position;
+    result.wallMs = msSince(start);
+    return result;
+}
+
+// ============================================================
+// ̳߳أ̴߳ӹ±Ự߳Ҳ
+// ============================================================
+SimBatchSummary SimBatchRunner::run(const std::vector<SimSessionSpec>& specs, std::vector<SimSessionResult>& results) const
+{
+    SimBatchSummary summary;
+    summary.sessions = (int)specs.size();
+    summary.threads = std::max(1, std::min(_threads, summary.sessions));
+    results.assign(specs.size(), SimSessionResult());
+    if (specs.empty()) return summary;
+
+    auto start = std::chrono::steady_clock::now();
+    std::atomic<size_t> next(0);
+
+    // ÿỰֻдԼ±ĽҪ
+    auto worker = [&](int id) {
+        for (size_t i = next.fetch_add(1); i < specs.size(); i = next.fetch_add(1))
+        {
+            results[i] = runSession(specs[i]);
+            results[i].worker = id;
+        }
+    };
+
+    std::vector<std::thread> pool;
+    pool.reserve(summary.threads - 1);
+    for (int t = 1; t < summary.threads; t++) pool.emplace_back(worker, t);
+    worker(0);
+    for (auto& thread : pool) thread.join();
+
+    summary.wallMs = msSince(start);
+
+    // 
+    std::vector<double> times;
+    times.reserve(results.size());
+    double sum = 0.0;
+    for (const auto& r : results)
+    {
+        summary.totalFrames += r.frames;
+        summary.totalRescues += r.rescueCount;
+        times.push_back(r.wallMs);
+        sum += r.wallMs;
+    }
+    std::sort(times.begin(), times.end());
+    auto percentile = [&](double p) { return times[std::min(times.size() - 1, (size_t)(p * (times.size() - 1) + 0.5))]; };
+
+    summary.sessionAvgMs = sum / times.size();
+    summary.sessionP50Ms = percentile(0.50);
+    summary.sessionP99Ms = percentile(0.99);
+    summary.sessionMaxMs = times.back();
+    if (summary.wallMs > 0.0) summary.framesPerSecond = summary.totalFrames * 1000.0 / summary.wallMs;
+    return summary;
+}
+
+// ============================================================
+// Ĭϳ /  / ¼
+// ============================================================
+void SimBatchRunner::defaultWorldSetup(SimWorld& world)
+{
+    world.addPlatform(SimRect(0, 0, 8000, 100));
+    world.addPlatform(SimRect(600, 250, 300, 40));
+    world.addPlatform(SimRect(1500, 350, 400, 40));
+    world.addPlatform(SimRect(3000, 250, 250, 40));
+    // ͷǽ
+    world.addPlatform(SimRect(-100, 0, 100, 2000));
+    world.addPlatform(SimRect(8000, 0, 100, 2000));
+
+    world.spawnPlayer(SimVec2(200, 200), SimRect(-20, 30, 40, 80));
+    for (int i = 0; i < 8; i++) {
+        world.addPatroller(SimVec2(800.0f + i * 900, 100), SimVec2(60, 60), 600.0f + i * 900, 1100.0f + i * 900, 60.0f + i * 10);
+    }
+}
+
+SimInput SimBatchRunner::defaultBot(const SimWorld& world, int /*frame*/)
+{
+    RandomStream& rng = SimRandom::get(RngStream::AI);
+    const PlayerBody& body = world.getPlayer();
+    SimInput input;
+
+    // 򣺱һ֡ķײǽͣ»Сʱѡ
+    int dir = body.velocity.x > 0 ? 1 : (body.velocity.x < 0 ? -1 : 0);
+    if (dir == 0 || rng.range(0, 89) == 0) dir = rng.range(0, 1) ? 1 : -1;
+    input.moveX = dir;
+
+    // Ծдʼס (ʱ)
+    if (body.onGround) input.jump = rng.range(0, 39) == 0;
+    else input.jump = body.velocity.y > 0 && rng.range(0, 9) < 8;
+    return input;
+}
+
+SimInput SimBatchRunner::inputFromBits(uint16_t bits)
+{
+    SimInput input;
+    if (bits & InputBit::MOVE_LEFT) input.moveX -= 1;
+    if (bits & InputBit::MOVE_RIGHT) input.moveX += 1;
+    input.jump = (bits & InputBit::JUMP) != 0;
+    return input;
+}
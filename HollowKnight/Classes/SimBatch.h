@@ -0,0 +1,89 @@
+#ifndef __SIM_BATCH_H__
+#define __SIM_BATCH_H__
+
+#include "SimWorld.h"
+#include "SimConfig.h"
+#include "InputRecorder.h" // ֻõ InputFrame / InputBitͷļ cocos
+#include <functional>
+#include <vector>
+
+// ==========================================
+// ͷģ (ƽԲ / һ)
+// ѼٸỰָ̳߳زܣÿỰĽͺʱ
+// - ÿỰռһ SimWorld һ (SimRandom::Scope)Ự֮ûйĿɱ״̬
+//   ͬһӲֵܷĸ̡߳˭һܣһ
+// - Դ¼ (InputFrame )  (ñỰ)
+// - ֻͷģֱ SimInput / λλ
+//   cocos һļλỰ (KeyBindingManager::Scope)DirectorƵǽ̼ﲢ
+// ==========================================
+
+struct SimSessionSpec
+{
+    uint64_t seed = 0;
+    int frames = Config::Batch::DEFAULT_SESSION_FRAMES;
+    float dt = 1.0f / 60;
+    const std::vector<InputFrame>* replay = nullptr; // ǿʱ¼ط (¼̾ǰ)
+};
+
+struct SimSessionResult
+{
+    uint64_t seed = 0;
+    int frames = 0;            // ʵ˶֡
+    int rescueCount = 0;       // ͼصĴ
+    int health = 0;
+    SimVec2 finalPosition;
+    double wallMs = 0.0;       // Ựĺʱ
+    int worker = -1;           // ĸ߳
+};
+
+struct SimBatchSummary
+{
+    int sessions = 0;
+    int threads = 0;
+    long long totalFrames = 0;
+    int totalRescues = 0;
+
+    double wallMs = 0.0;           // ǽʱ
+    double sessionAvgMs = 0.0;
+    double sessionP50Ms = 0.0;
+    double sessionP99Ms = 0.0;
+    double sessionMaxMs = 0.0;
+    double framesPerSecond = 0.0;  // ̺߳ϼƵģ
+};
+
+class SimBatchRunner
+{
+public:
+    // ˣݵǰһ֡
+    //  SimRandom::get(...) ȡõǱỰԼ
+    using Bot = std::function<SimInput(const SimWorld& world, int frame)>;
+    // ÿỰԼĹ߳ϵһ
+    using WorldSetup = std::function<void(SimWorld& world)>;
+
+    // threads <= 0 ʱӲ߳
+    explicit SimBatchRunner(int threads = 0);
+
+    void setWorldSetup(const WorldSetup& setup) { _setup = setup; }
+    void setBot(const Bot& bot) { _bot = bot; }
+    int getThreadCount() const { return _threads; }
+
+    // лỰŷأresults ± specs һһӦ (˳޹)
+    SimBatchSummary run(const std::vector<SimSessionSpec>& specs, std::vector<SimSessionResult>& results) const;
+
+    // ܵỰ (߳ãҲԵĳ)
+    SimSessionResult runSession(const SimSessionSpec& spec) const;
+
+    // Ĭϳ + ƽ̨ + һѲ߹
+    static void defaultWorldSetup(SimWorld& world);
+    // Ĭϻˣ
+    static SimInput defaultBot(const SimWorld& world, int frame);
+    // ¼λ -> SimInput
+    static SimInput inputFromBits(uint16_t bits);
+
+private:
+    int _threads;
+    WorldSetup _setup;
+    Bot _bot;
+};
+
+#endif // __SIM_BATCH_H__
@@ -0,0 +1,26 @@
+#ifndef __SIM_COCOS_H__
+#define __SIM_COCOS_H__
+
+#include "cocos2d.h"
+#include "SimTypes.h"
+
+// ==========================================
+// ͷ <-> cocos  ת (ֻڱֲʹ)
+// ==========================================
+namespace SimCocos {
+    inline SimVec2 toSim(const cocos2d::Vec2& v) { return SimVec2(v.x, v.y); }
+    inline cocos2d::Vec2 toCocos(const SimVec2& v) { return cocos2d::Vec2(v.x, v.y); }
+
+    inline SimRect toSim(const cocos2d::Rect& r) { return SimRect(r.origin.x, r.origin.y, r.size.width, r.size.height); }
+    inline cocos2d::Rect toCocos(const SimRect& r) { return cocos2d::Rect(r.x, r.y, r.width, r.height); }
+
+    // ת out ÿ֡òᷴ
+    inline void toSim(const std::vector<cocos2d::Rect>& rects, SimRectList& out)
+    {
+        out.clear();
+        out.reserve(rects.size());
+        for (const auto& r : rects) out.push_back(toSim(r));
+    }
+}
+
+#endif // __SIM_COCOS_H__
@@ -0,0 +1,75 @@
+#ifndef __SIM_CONFIG_H__
+#define __SIM_CONFIG_H__
+
+// ==========================================
+// 淨ֵ (ݣ cocos)
+// ͷģ (Sim*PlayerPhysicsPlayerStats) ֻܰļ
+// Ⱦ/Դ· config.h
+// ==========================================
+namespace Config {
+    struct PlayerStatConfig {
+        int maxHealth = 5;       // Ѫ
+        int maxSoul = 4;         // 
+        int healCost = 1;        // Ѫ
+        int soulGainPerKill = 1; // ɱһ֣ 1  ( 1/4 ƿ)
+	};
+    // ȫĬʵ
+    static const PlayerStatConfig DEFAULT_PLAYER_CFG;
+
+    namespace Skill {
+        const int FIREBALL_COST = 1;     //  1  (1/3  1/4 ƿ)
+        const float FIREBALL_SPEED = 600.0f; // ٶ
+        const int FIREBALL_DAMAGE = 2;   // ˺ (ͨƽ)
+    }
+
+    namespace Player {
+        // 
+        const float MOVE_SPEED = 300.0f;
+        const float GRAVITY = 2000.0f;
+        const float MAX_FALL_SPEED = -1500.0f;
+
+        // ָв
+        const float MAX_JUMP_TIME = 0.35f;      // Ծʱ
+        const float JUMP_ACCEL = 3000.0f;       // ٶ
+        const float JUMP_FORCE_BASE = 400.0f;
+
+        // ս
+        const float ATTACK_COOLDOWN = 0.04f;
+
+        // ֮
+        const float DREAM_NAIL_CHARGE_TIME = 0.3f; // Ҫ ()
+        const float DREAM_NAIL_RANGE = 200.0f;     //  (ͨԶ)
+
+        // ײ
+        const float LAND_TOLERANCE = 40.0f;    // ʱݽ
+        const float CEILING_TOLERANCE = 20.0f; // ͷʱص
+        const float FALL_RESCUE_Y = -50.0f;    // ߶Ϊͼ
+    }
+
+    namespace Snapshot {
+        const int ROLLBACK_FRAMES = 8;          // ع֡ (ջС)
+        const int INPUT_DELAY_FRAMES = 2;       // ӳټ֡Чٻع
+        const float CAPTURE_BUDGET_MS = 1.0f;   // ץһοյĺʱ
+    }
+
+    namespace Batch {
+        const int DEFAULT_SESSION_FRAMES = 60 * 60 * 5; // һỰĬ 5  (60fps)
+        const int MAX_THREADS = 64;                     // ̳߳ (ٶֻ)
+    }
+
+    namespace Jobs {
+        const int WORKER_COUNT = 0;             // ߳0 = Ӳ߳ - 1 (߳Ҳɻ)
+        const int QUEUE_CAPACITY = 1024;        // ÿ̵߳гȣ˾ֱͶִ߳
+        const int MIN_ITEMS_PER_JOB = 8;        // parallelFor ÿټԪ (̫鲻ֵõ)
+    }
+
+    namespace Input {
+        const int QUEUE_CAPACITY = 64;          // ģⲽܼ֮¼ (˶µ)
+        // 뻺壺ǰôðҲ (ǰӲֱﰴ)0 = 
+        const float JUMP_BUFFER = 0.12f;
+        const float ATTACK_BUFFER = 0.10f;
+        const float CAST_BUFFER = 0.10f;
+    }
+}
+
+#endif // __SIM_CONFIG_H__
@@ -0,0 +1,326 @@
+#include "gtest/gtest.h"
+#include "SimWorld.h"
+#include "SimRandom.h"
+#include "SimSnapshot.h"
+#include "SimBatch.h"
+#include "JobSystem.h"
+#include "InputQueue.h"
+#include <atomic>
+#include <chrono>
+#include <vector>
+
+// ============================================================
+// ͷģĵĲ (ĲĿ SimCoreTest)
+// ֻ롢ӺԴļ + gtest cocos ͷļ·Ҳ cocos
+//   SimWorld  SimBatch  JobSystem  PlayerPhysics  PatrolAI  PlayerStats  SimRandom  InputQueue
+// ˭ cocos  includeĿͱ಻
+// Ҫ Director / Ĳ GameLogicTest.cpp
+// ============================================================
+
+// ͷļ cocos ʱֱӱ (cocos2d.h ᶨ CC_TARGET_PLATFORM)
+#ifdef CC_TARGET_PLATFORM
+#error "SimCoreTest: a headless core header pulled in cocos2d"
+#endif
+
+// 1.  / Ѳ / 粽 (Ҫ Director / GLԴ)
+TEST(HeadlessCoreTest, PlayerLandsOnPlatform) {
+    PlayerBody body;
+    body.position = SimVec2(100, 300);
+    body.localBox = SimRect(-20, 30, 40, 80);
+    SimRectList ground = { SimRect(0, 0, 1000, 100) };
+
+    for (int i = 0; i < 120; i++) {
+        PlayerPhysics::step(body, 1.0f / 60, ground);
+    }
+    EXPECT_TRUE(body.onGround);
+    EXPECT_NEAR(body.position.y + body.localBox.y, 100.0f, 2.0f);
+}
+
+TEST(HeadlessCoreTest, PatrolTurnsAtBounds) {
+    PatrolState patrol;
+    patrol.speed = 100.0f;
+    PatrolAI::setRange(patrol, 0.0f, 50.0f);
+
+    float x = 0.0f;
+    bool turned = false;
+    for (int i = 0; i < 60 && !turned; i++) {
+        x = PatrolAI::step(patrol, x, 1.0f / 60, &turned);
+    }
+    EXPECT_TRUE(turned);
+    EXPECT_FALSE(patrol.movingRight);
+}
+
+TEST(HeadlessCoreTest, ThousandsOfFramesStayOnMap) {
+    SimWorld world;
+    world.addPlatform(SimRect(0, 0, 4000, 100));
+    world.addPlatform(SimRect(600, 250, 300, 40));
+    world.spawnPlayer(SimVec2(100, 200), SimRect(-20, 30, 40, 80));
+    world.addPatroller(SimVec2(800, 100), SimVec2(60, 60), 700, 1000, 50.0f);
+
+    SimInput input;
+    for (int i = 0; i < 20000; i++) {
+        input.moveX = ((i / 300) % 2 == 0) ? 1 : -1;
+        input.jump = (i % 50) < 20;
+        world.step(1.0f / 60, input);
+    }
+    EXPECT_EQ(world.getFrame(), 20000u);
+    EXPECT_EQ(world.getRescueCount(), 0);
+    EXPECT_GT(world.getPlayer().position.y, 0.0f);
+}
+
+// 2. ɸ֣Ӱ
+TEST(SimRandomTest, SeededStreamsAreReproducibleAndIndependent) {
+    SimRandom::seedAll(42);
+    int first[16];
+    for (int i = 0; i < 16; i++) first[i] = SimRandom::get(RngStream::BOSS).range(0, 2);
+
+    //  AI Ӱ Boss 
+    SimRandom::seedAll(42);
+    for (int i = 0; i < 100; i++) SimRandom::get(RngStream::AI).next();
+    for (int i = 0; i < 16; i++) {
+        int v = SimRandom::get(RngStream::BOSS).range(0, 2);
+        EXPECT_EQ(v, first[i]);
+        EXPECT_GE(v, 0);
+        EXPECT_LE(v, 2);
+    }
+    float f = SimRandom::get(RngStream::BOSS).range(0.6f, 1.0f);
+    EXPECT_GE(f, 0.6f);
+    EXPECT_LT(f, 1.0f);
+}
+
+// 3. عԶ֡´˾ͻع㣬Ͱʱһģһ
+namespace {
+    void setupRollbackWorld(SimWorld& world) {
+        world.addPlatform(SimRect(0, 0, 4000, 100));
+        world.addPlatform(SimRect(600, 250, 300, 40));
+        world.spawnPlayer(SimVec2(100, 200), SimRect(-20, 30, 40, 80));
+        for (int i = 0; i < 4; i++) {
+            world.addPatroller(SimVec2(500.0f + i * 400, 100), SimVec2(60, 60), 400.0f + i * 400, 700.0f + i * 400, 50.0f + i * 20);
+        }
+    }
+
+    SimInput scriptedInput(int frame) {
+        SimInput input;
+        input.moveX = ((frame / 120) % 2 == 0) ? 1 : -1;
+        input.jump = (frame % 45) < (frame % 7 == 0 ? 5 : 15);
+        return input;
+    }
+}
+
+TEST(SnapshotTest, RollbackMatchesStraightRun) {
+    const float dt = 1.0f / 60;
+    const int FRAMES = 900;
+    const int LAG = Config::Snapshot::INPUT_DELAY_FRAMES + 3; // ԾԶ룬 LAG ֡յ
+    ASSERT_LE(LAG, Config::Snapshot::ROLLBACK_FRAMES);
+
+    // գ밴ʱ
+    SimRandom::seedAll(7);
+    SimWorld reference;
+    setupRollbackWorld(reference);
+    for (int i = 0; i < FRAMES; i++) reference.step(dt, scriptedInput(i));
+
+    // عûյ֡յԶ
+    SimRandom::seedAll(7);
+    SimWorld world;
+    setupRollbackWorld(world);
+    SnapshotRing ring;
+    std::vector<bool> predicted(FRAMES, false);
+    int confirmed = -1;
+    int rollbacks = 0;
+
+    auto simulate = [&](int f) {
+        SimInput input = scriptedInput(f);
+        if (f > confirmed) input.jump = confirmed >= 0 && scriptedInput(confirmed).jump;
+        predicted[f] = input.jump;
+        world.saveSnapshot(ring.slot(f));
+        world.step(dt, input);
+    };
+
+    for (int frame = 0; frame < FRAMES; frame++)
+    {
+        int arrived = frame - LAG;
+        if (arrived >= 0) {
+            confirmed = arrived;
+            if (predicted[arrived] != scriptedInput(arrived).jump) {
+                const SimSnapshot* snap = ring.find(arrived);
+                ASSERT_NE(snap, nullptr);
+                ASSERT_TRUE(world.restoreSnapshot(*snap));
+                for (int f = arrived; f < frame; f++) simulate(f);
+                rollbacks++;
+            }
+        }
+        simulate(frame);
+    }
+
+    EXPECT_GT(rollbacks, 0);
+    EXPECT_EQ(world.getFrame(), reference.getFrame());
+    EXPECT_EQ(world.getPlayer().position.x, reference.getPlayer().position.x);
+    EXPECT_EQ(world.getPlayer().position.y, reference.getPlayer().position.y);
+    EXPECT_EQ(world.getPlayer().velocity.y, reference.getPlayer().velocity.y);
+    for (size_t i = 0; i < world.getPatrollers().size(); i++) {
+        EXPECT_EQ(world.getPatrollers()[i].position.x, reference.getPatrollers()[i].position.x);
+        EXPECT_EQ(world.getPatrollers()[i].patrol.movingRight, reference.getPatrollers()[i].patrol.movingRight);
+    }
+
+    // ľ֡ȡѲ߹һʱָܾ
+    EXPECT_EQ(ring.find(0), nullptr);
+    SimSnapshot bad = *ring.find(FRAMES - 1);
+    bad.entityCount--;
+    EXPECT_FALSE(world.restoreSnapshot(bad));
+}
+
+TEST(SnapshotTest, CaptureWithinBudget) {
+    SimWorld world;
+    setupRollbackWorld(world);
+    SimSnapshot snap;
+
+    const int N = 1000;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < N; i++) world.saveSnapshot(snap);
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / N;
+
+    EXPECT_TRUE(snap.isValid());
+    EXPECT_LT(ms, Config::Snapshot::CAPTURE_BUDGET_MS);
+    EXPECT_LE(snap.usedBytes(), sizeof(SimSnapshot));
+}
+
+// 4. ģ⣺Ự֮以Ӱ죬ͬһӲܼ߳ܽһ
+TEST(BatchTest, ResultsIndependentOfThreadCount) {
+    std::vector<InputFrame> replay;
+    for (int i = 0; i < 2000; i++) {
+        uint16_t bits = (i / 200) % 2 ? InputBit::MOVE_LEFT : InputBit::MOVE_RIGHT;
+        if (i % 40 < 12) bits |= InputBit::JUMP;
+        replay.push_back({ bits, 1.0f / 60 });
+    }
+
+    std::vector<SimSessionSpec> specs(24);
+    for (size_t i = 0; i < specs.size(); i++) {
+        specs[i].seed = 1000 + i;
+        specs[i].frames = 3000;
+    }
+    specs[0].replay = &replay;
+
+    SimRandom::seedAll(5);
+    uint64_t mainState = SimRandom::get(RngStream::AI).getState();
+
+    std::vector<SimSessionResult> serial, parallel;
+    SimBatchSummary a = SimBatchRunner(1).run(specs, serial);
+    SimBatchSummary b = SimBatchRunner(4).run(specs, parallel);
+
+    EXPECT_EQ(a.threads, 1);
+    EXPECT_EQ(b.threads, 4);
+    EXPECT_EQ(a.totalFrames, 2000 + 23 * 3000);
+    EXPECT_EQ(a.totalFrames, b.totalFrames);
+    EXPECT_GT(b.framesPerSecond, 0.0);
+    EXPECT_LE(b.sessionP50Ms, b.sessionMaxMs);
+
+    bool anyDiffers = false;
+    for (size_t i = 0; i < specs.size(); i++) {
+        EXPECT_EQ(serial[i].seed, specs[i].seed);
+        EXPECT_EQ(serial[i].finalPosition.x, parallel[i].finalPosition.x);
+        EXPECT_EQ(serial[i].finalPosition.y, parallel[i].finalPosition.y);
+        EXPECT_EQ(serial[i].rescueCount, parallel[i].rescueCount);
+        if (i > 1 && serial[i].finalPosition.x != serial[1].finalPosition.x) anyDiffers = true;
+    }
+    EXPECT_TRUE(anyDiffers); // ͬӵĻ߷ͬ
+
+    // ỰõԼ̵߳û
+    EXPECT_EQ(SimRandom::get(RngStream::AI).getState(), mainState);
+}
+
+// 5. ϵͳÿ±ǡִһΣûʱڵֱ߳
+TEST(JobSystemTest, ParallelForCoversEveryIndexOnce) {
+    JobSystem* jobs = JobSystem::getInstance();
+    const int N = 5000;
+    std::vector<std::atomic<int>> hits(N);
+
+    auto run = [&]() {
+        for (auto& h : hits) h.store(0);
+        jobs->parallelFor(N, 16, [&](int begin, int end) {
+            for (int i = begin; i < end; i++) hits[i].fetch_add(1);
+        });
+        for (int i = 0; i < N; i++) {
+            if (hits[i].load() != 1) return i;
+        }
+        return -1;
+    };
+
+    ASSERT_FALSE(jobs->isRunning());
+    EXPECT_EQ(jobs->getThreadCount(), 1);
+    EXPECT_EQ(run(), -1);
+
+    jobs->start(3);
+    EXPECT_EQ(jobs->getThreadCount(), 4);
+    EXPECT_EQ(JobSystem::getThreadIndex(), 0);
+    for (int round = 0; round < 20; round++) {
+        ASSERT_EQ(run(), -1) << "round " << round;
+    }
+
+    // ٿ parallelFor (߳Ҳȴæɻ)
+    std::atomic<int> total(0);
+    jobs->parallelFor(8, 1, [&](int begin, int end) {
+        for (int i = begin; i < end; i++) {
+            jobs->parallelFor(100, 10, [&](int b, int e) { total.fetch_add(e - b); });
+        }
+    });
+    EXPECT_EQ(total.load(), 800);
+
+    jobs->stop();
+    EXPECT_FALSE(jobs->isRunning());
+}
+
+// 6. Уһ֡ڰɿҲ㰴嵽ЧΪֹ
+TEST(InputQueueTest, TapWithinOneStepAndBuffering) {
+    InputQueue queue;
+    queue.bind(90, InputBit::JUMP);
+    queue.bind(37, InputBit::MOVE_LEFT);
+    EXPECT_EQ(queue.bitsForKey(90), InputBit::JUMP);
+    EXPECT_EQ(queue.bitsForKey(-1), 0);
+    EXPECT_EQ(queue.bitsForKey(InputQueue::KEY_TABLE_SIZE), 0);
+
+    uint16_t bits = 0;
+    EXPECT_FALSE(queue.beginStep(0.0, bits));
+
+    // ֮ һ£һܿһû ()
+    queue.push(InputBit::MOVE_LEFT, true, 1.000);
+    queue.push(InputBit::MOVE_LEFT, false, 1.005);
+    EXPECT_TRUE(queue.beginStep(1.010, bits));
+    EXPECT_EQ(bits, InputBit::MOVE_LEFT);
+    EXPECT_TRUE(queue.beginStep(1.026, bits));
+    EXPECT_EQ(bits, 0);
+
+    // Ծһ£һֱЧںʧ
+    queue.push(InputBit::JUMP, true, 2.000);
+    queue.push(InputBit::JUMP, false, 2.005);
+    EXPECT_TRUE(queue.beginStep(2.010, bits));
+    EXPECT_EQ(bits, InputBit::JUMP);
+    EXPECT_FALSE(queue.beginStep(2.000 + Config::Input::JUMP_BUFFER * 0.5, bits));
+    EXPECT_EQ(bits, InputBit::JUMP);
+    EXPECT_TRUE(queue.beginStep(2.001 + Config::Input::JUMP_BUFFER, bits));
+    EXPECT_EQ(bits, 0);
+
+    // Ч壻סŵĲӰ
+    queue.push(InputBit::JUMP, true, 3.000);
+    queue.push(InputBit::JUMP, false, 3.005);
+    queue.beginStep(3.010, bits);
+    queue.consume(InputBit::JUMP);
+    queue.beginStep(3.026, bits);
+    EXPECT_EQ(bits, 0);
+
+    queue.push(InputBit::JUMP, true, 4.000);
+    queue.beginStep(4.010, bits);
+    queue.consume(InputBit::JUMP);
+    queue.beginStep(4.5, bits);
+    EXPECT_EQ(bits, InputBit::JUMP);
+
+    // ˶µģǻûȡ
+    queue.reset();
+    for (int i = 0; i < InputQueue::CAPACITY; i++) {
+        EXPECT_TRUE(queue.push(InputBit::MOVE_LEFT, (i & 1) == 0, 5.0));
+    }
+    EXPECT_FALSE(queue.push(InputBit::MOVE_LEFT, true, 5.0));
+    EXPECT_EQ(queue.getDroppedCount(), 1);
+    queue.beginStep(5.01, bits);
+    EXPECT_EQ(bits, InputBit::MOVE_LEFT); //  (һ¼ɿ)
+    EXPECT_EQ(queue.getHeldBits(), 0);
+}
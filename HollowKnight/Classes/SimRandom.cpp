@@ -0,0 +1,77 @@
+#include "SimRandom.h"
+#include <chrono>
+
+thread_local RandomStreams SimRandom::s_threadStreams;
+thread_local RandomStreams* SimRandom::s_current = nullptr;
+bool SimRandom::s_hasPresetSeed = false;
+uint64_t SimRandom::s_presetSeed = 0;
+
+namespace {
+    // splitmix64ڵӴɢɻص״̬
+    uint64_t splitmix64(uint64_t& x)
+    {
+        uint64_t z = (x += 0x9E3779B97F4A7C15ull);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+}
+
+// ============================================================
+// RandomStream
+// ============================================================
+void RandomStream::seed(uint64_t seed)
+{
+    setState(splitmix64(seed));
+}
+
+uint32_t RandomStream::next()
+{
+    _state ^= _state >> 12;
+    _state ^= _state << 25;
+    _state ^= _state >> 27;
+    return (uint32_t)((_state * 0x2545F4914F6CDD1Dull) >> 32);
+}
+
+int RandomStream::range(int lo, int hi)
+{
+    if (hi <= lo) return lo;
+    uint32_t span = (uint32_t)(hi - lo) + 1;
+    return lo + (int)(((uint64_t)next() * span) >> 32);
+}
+
+float RandomStream::range(float lo, float hi)
+{
+    // ȡ 24 λ֤ < 1
+    float t = (next() >> 8) * (1.0f / 16777216.0f);
+    return lo + (hi - lo) * t;
+}
+
+// ============================================================
+// SimRandom
+// ============================================================
+void SimRandom::seedAll(uint64_t seed)
+{
+    RandomStreams& streams = current();
+    streams.seed = seed;
+    uint64_t x = seed;
+    for (int i = 0; i < (int)RngStream::COUNT; i++) {
+        streams.streams[i].seed(splitmix64(x));
+    }
+}
+
+void SimRandom::setSessionSeed(uint64_t seed)
+{
+    s_presetSeed = seed;
+    s_hasPresetSeed = true;
+}
+
+uint64_t SimRandom::takeSessionSeed()
+{
+    if (s_hasPresetSeed) {
+        s_hasPresetSeed = false;
+        return s_presetSeed;
+    }
+    uint64_t x = (uint64_t)std::chrono::high_resolution_clock::now().time_since_epoch().count();
+    return splitmix64(x);
+}
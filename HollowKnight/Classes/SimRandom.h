@@ -0,0 +1,87 @@
+#ifndef __SIM_RANDOM_H__
+#define __SIM_RANDOM_H__
+
+#include <cstdint>
+
+// ==========================================
+// ɸֵ ( cocos)
+// ÿϵͳһȫһỰ
+// ͬһ + ͬ֡ => ͬ Boss ʽͬΪ֧
+// Ӱ죺 AI һ Boss 
+// 淨ﲻҪ cocos2d::random / rand()
+// ̸߳룻ģʱÿỰԼһ (RandomStreams)
+//  SimRandom::Scope 󶨵ǰ̣߳Ự֮以
+// ==========================================
+
+enum class RngStream : uint8_t
+{
+    BOSS = 0,   // Boss ʽʱ䡢񱩻
+    AI,         // Ϊѡ
+    FX,         //  (Ч)Ӱģ
+    COUNT
+};
+
+// xorshift64*״ֻ̬ 8 ֽڣ浵/ع
+class RandomStream
+{
+public:
+    void seed(uint64_t seed);
+
+    uint32_t next();
+    // [lo, hi] 
+    int range(int lo, int hi);
+    // [lo, hi)
+    float range(float lo, float hi);
+
+    uint64_t getState() const { return _state; }
+    void setState(uint64_t state) { _state = state ? state : 1; }
+
+private:
+    uint64_t _state = 1;
+};
+
+// һỰȫ
+struct RandomStreams
+{
+    uint64_t seed = 0;
+    RandomStream streams[(int)RngStream::COUNT];
+};
+
+class SimRandom
+{
+public:
+    // ûỰõǰ̰߳󶨵
+    static void seedAll(uint64_t seed);
+    static uint64_t getSeed() { return current().seed; }
+
+    static RandomStream& get(RngStream stream) { return current().streams[(int)stream]; }
+
+    // ڰѵǰ̵߳ĳỰԼ (Ƕ)
+    class Scope
+    {
+    public:
+        explicit Scope(RandomStreams& streams) : _previous(s_current) { s_current = &streams; }
+        ~Scope() { s_current = _previous; }
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        RandomStreams* _previous;
+    };
+
+    // »Ự (HelloWorld::init) ȡӣԤ (ط/ع) Ԥģ
+    // 꼴壻ʱһµ
+    static void setSessionSeed(uint64_t seed);
+    static uint64_t takeSessionSeed();
+
+private:
+    static RandomStreams& current() { return s_current ? *s_current : s_threadStreams; }
+
+    static thread_local RandomStreams s_threadStreams; // ûа󶨻Ựʱõ (Ϸ߳̾һ)
+    static thread_local RandomStreams* s_current;
+    static bool s_hasPresetSeed;
+    static uint64_t s_presetSeed;
+};
+
+#endif // __SIM_RANDOM_H__
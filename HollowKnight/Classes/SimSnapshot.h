@@ -0,0 +1,224 @@
+#ifndef __SIM_SNAPSHOT_H__
+#define __SIM_SNAPSHOT_H__
+
+#include "SimTypes.h"
+#include "SimRandom.h"
+#include "SimConfig.h"
+#include "PlayerPhysics.h"
+#include "PatrolAI.h"
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+// ==========================================
+// ģ״̬ ( cocos)
+// һ֡ȫ淨״ֵ̬//״̬ Boss ״̬ʱ
+// Ļӡǰؿ
+// - ƽץȡֶдԤȷõĽṹ壬ڴ
+// - ħͰ汾ţṹ˾ͼ VERSIONֱӾܾ
+// - ֻģ״̬˸ܻЧിڻָʱ״̬²
+// ;㸴 (HelloWorld) ͻع (SnapshotRing)
+// ==========================================
+
+struct PlayerSnapshot
+{
+    PlayerBody body;
+    bool facingRight;
+    float attackCooldown;
+    float invincibleTimer;     // > 0 ʾ޵
+
+    int health;
+    int soul;
+    bool hasFireballSkill;
+
+    int attackDir;
+    bool jumpInputReleased;
+    bool castInputReleased;
+    bool dreamNailActive;
+
+    // ״̬״̬ + ״̬ļʱ/׶α ( PlayerState.h)
+    uint8_t stateId;
+    float stateTimer;
+    float stateDuration;
+    bool stateFlagA;
+    bool stateFlagB;
+};
+
+// Сֺ干 (ֻͬõһֶ)
+struct EntitySnapshot
+{
+    enum class Kind : uint8_t { ENEMY, ZOMBIE, SPIKE, BUZZER, PATROLLER };
+
+    int tag;
+    Kind kind;
+    uint8_t state;             // Լ State ö
+    SimVec2 position;
+    SimVec2 velocity;
+    int health;
+    bool facingRight;
+    bool onGround;
+    PatrolState patrol;
+};
+
+struct BossSnapshot
+{
+    uint8_t state;
+    SimVec2 position;
+    SimVec2 velocity;
+    float facing;
+
+    int hitCount;
+    int stunHitCount;
+    int stunHP;
+    float stunTimer;
+    bool isStunAnimPlaying;
+    float hurtTimer;
+    float lastPlayerX;
+
+    bool isDead;
+    bool onGround;
+    bool isAttackLanded;
+
+    int rampageCounter;
+    float rampageFireballTimer;
+    bool isRampaging;
+
+    int actionStep;
+    float stateTimer;
+    int pendingIdleCount;
+};
+
+struct JarSnapshot
+{
+    int tag;
+    int health;
+};
+
+struct ProjectileSnapshot
+{
+    enum class Kind : uint8_t { PLAYER_FIREBALL, BOSS_FIREBALL, SHOCKWAVE };
+
+    Kind kind;
+    SimVec2 position;
+    SimVec2 velocity;
+    float life;                // Ѵʱ䣻ѷо
+    float dir;
+};
+
+struct SimSnapshot
+{
+    static const uint32_t MAGIC = 0x50534B48; // "HKSP"
+    static const uint16_t VERSION = 2;
+
+    static const int MAX_ENTITIES = 16;
+    static const int MAX_JARS = 8;
+    static const int MAX_PROJECTILES = 64;
+
+    uint32_t magic;
+    uint16_t version;
+    uint16_t byteSize;         // sizeof(SimSnapshot)ֹ֮ͬ
+
+    uint32_t frame;
+    int level;
+    bool bossTriggered;
+    int bossHitCombo;
+    bool hasBoss;
+    bool hasSkillPickup;       // ֮߻ڵ (Level 2)
+    uint64_t rngState[(int)RngStream::COUNT];
+
+    PlayerSnapshot player;
+    BossSnapshot boss;
+
+    int entityCount;
+    EntitySnapshot entities[MAX_ENTITIES];
+    int jarCount;
+    JarSnapshot jars[MAX_JARS];
+    int projectileCount;
+    ProjectileSnapshot projectiles[MAX_PROJECTILES];
+
+    // ղдͷ (ץȡʼʱ)
+    void begin(uint32_t frameIndex, int levelIndex)
+    {
+        magic = MAGIC;
+        version = VERSION;
+        byteSize = (uint16_t)sizeof(SimSnapshot);
+        frame = frameIndex;
+        level = levelIndex;
+        bossTriggered = false;
+        bossHitCombo = 0;
+        hasBoss = false;
+        hasSkillPickup = false;
+        entityCount = 0;
+        jarCount = 0;
+        projectileCount = 0;
+    }
+
+    bool isValid() const
+    {
+        return magic == MAGIC && version == VERSION && byteSize == (uint16_t)sizeof(SimSnapshot);
+    }
+
+    // Ҳ״̬һ֣ع Boss 鵽ͬʽ
+    void captureRandom()
+    {
+        for (int i = 0; i < (int)RngStream::COUNT; i++) rngState[i] = SimRandom::get((RngStream)i).getState();
+    }
+    void restoreRandom() const
+    {
+        for (int i = 0; i < (int)RngStream::COUNT; i++) SimRandom::get((RngStream)i).setState(rngState[i]);
+    }
+
+    // ˷ nullptr (Ĳֲ棬÷һ)
+    EntitySnapshot* addEntity() { return entityCount < MAX_ENTITIES ? &entities[entityCount++] : nullptr; }
+    JarSnapshot* addJar() { return jarCount < MAX_JARS ? &jars[jarCount++] : nullptr; }
+    ProjectileSnapshot* addProjectile() { return projectileCount < MAX_PROJECTILES ? &projectiles[projectileCount++] : nullptr; }
+
+    const EntitySnapshot* findEntity(int tag) const
+    {
+        for (int i = 0; i < entityCount; i++) {
+            if (entities[i].tag == tag) return &entities[i];
+        }
+        return nullptr;
+    }
+    const JarSnapshot* findJar(int tag) const
+    {
+        for (int i = 0; i < jarCount; i++) {
+            if (jars[i].tag == tag) return &jars[i];
+        }
+        return nullptr;
+    }
+
+    // Чֵֽ (ֻõ)д/ʱ
+    size_t usedBytes() const
+    {
+        return offsetof(SimSnapshot, projectiles) + sizeof(ProjectileSnapshot) * projectileCount;
+    }
+};
+
+static_assert(std::is_trivially_copyable<SimSnapshot>::value, "SimSnapshot must stay memcpy-able");
+
+// ==========================================
+//  N ֡Ŀջ (ع)
+// ֡ȡģţȡʱУ֡ţǵľ֡ nullptr
+// ==========================================
+class SnapshotRing
+{
+public:
+    static const int SIZE = Config::Snapshot::ROLLBACK_FRAMES + 1; // ǰ֡ + ɻع֡
+
+    // ȡ frame ֡Ĳλ׼д (ɵ֡)
+    SimSnapshot& slot(uint32_t frame) { return _slots[frame % SIZE]; }
+
+    const SimSnapshot* find(uint32_t frame) const
+    {
+        const SimSnapshot& s = _slots[frame % SIZE];
+        return (s.isValid() && s.frame == frame) ? &s : nullptr;
+    }
+
+    void clear() { for (auto& s : _slots) s.magic = 0; }
+
+private:
+    SimSnapshot _slots[SIZE] = {};
+};
+
+#endif // __SIM_SNAPSHOT_H__
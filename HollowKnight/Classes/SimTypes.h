@@ -0,0 +1,71 @@
+#ifndef __SIM_TYPES_H__
+#define __SIM_TYPES_H__
+
+#include <algorithm>
+#include <vector>
+
+// ==========================================
+// ͷģõĻ ( cocos)
+// ϵ cocos һ£ԭ£Rect  origin ½
+// ==========================================
+
+struct SimVec2
+{
+    float x = 0.0f;
+    float y = 0.0f;
+
+    SimVec2() = default;
+    SimVec2(float x_, float y_) : x(x_), y(y_) {}
+
+    SimVec2 operator+(const SimVec2& o) const { return SimVec2(x + o.x, y + o.y); }
+    SimVec2 operator-(const SimVec2& o) const { return SimVec2(x - o.x, y - o.y); }
+    SimVec2 operator*(float s) const { return SimVec2(x * s, y * s); }
+    bool operator==(const SimVec2& o) const { return x == o.x && y == o.y; }
+    bool operator!=(const SimVec2& o) const { return !(*this == o); }
+
+    bool isZero() const { return x == 0.0f && y == 0.0f; }
+};
+
+struct SimRect
+{
+    float x = 0.0f;
+    float y = 0.0f;
+    float width = 0.0f;
+    float height = 0.0f;
+
+    SimRect() = default;
+    SimRect(float x_, float y_, float w_, float h_) : x(x_), y(y_), width(w_), height(h_) {}
+
+    float getMinX() const { return x; }
+    float getMaxX() const { return x + width; }
+    float getMinY() const { return y; }
+    float getMaxY() const { return y + height; }
+
+    //  cocos2d::Rect::intersectsRect ͬж (߽Ҳཻ)
+    bool intersectsRect(const SimRect& o) const
+    {
+        return !(getMaxX() < o.getMinX() ||
+                 o.getMaxX() < getMinX() ||
+                 getMaxY() < o.getMinY() ||
+                 o.getMaxY() < getMinY());
+    }
+
+    bool containsPoint(const SimVec2& p) const
+    {
+        return p.x >= getMinX() && p.x <= getMaxX() && p.y >= getMinY() && p.y <= getMaxY();
+    }
+
+    //  X / Y ϵص (ཻʱΪ)
+    static float overlapX(const SimRect& a, const SimRect& b)
+    {
+        return std::min(a.getMaxX(), b.getMaxX()) - std::max(a.getMinX(), b.getMinX());
+    }
+    static float overlapY(const SimRect& a, const SimRect& b)
+    {
+        return std::min(a.getMaxY(), b.getMaxY()) - std::max(a.getMinY(), b.getMinY());
+    }
+};
+
+typedef std::vector<SimRect> SimRectList;
+
+#endif // __SIM_TYPES_H__
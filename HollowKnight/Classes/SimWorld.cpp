@@ -0,0 +1,121 @@
+#include "SimWorld.h"
+#include "SimConfig.h"
+#include "PlayerState.h"
+
+SimWorld::SimWorld()
+{
+    _stats.initStats(Config::DEFAULT_PLAYER_CFG);
+}
+
+void SimWorld::spawnPlayer(const SimVec2& pos, const SimRect& localBox)
+{
+    _player = PlayerBody();
+    _player.position = pos;
+    _player.localBox = localBox;
+    _player.lastSafePosition = pos;
+    _jumpReleased = true;
+    _rising = false;
+}
+
+SimPatroller& SimWorld::addPatroller(const SimVec2& pos, const SimVec2& size, float left, float right, float speed)
+{
+    SimPatroller p;
+    p.position = pos;
+    p.size = size;
+    PatrolAI::setRange(p.patrol, left, right);
+    p.patrol.speed = speed;
+    _patrollers.push_back(p);
+    return _patrollers.back();
+}
+
+void SimWorld::step(float dt, const SimInput& input)
+{
+    // 1.  -> ٶ ( StateRun / StateJump Ĺһ)
+    _player.velocity.x = input.moveX * Config::Player::MOVE_SPEED;
+
+    if (!input.jump) {
+        _jumpReleased = true;
+    }
+
+    if (_rising) {
+        // StateJump־ͽضϣٶº
+        if (!input.jump) PlayerPhysics::stopJump(_player);
+        if (_player.velocity.y <= 0) _rising = false;
+    }
+    else if (input.jump && _jumpReleased && _player.onGround) {
+        _jumpReleased = false;
+        _rising = true;
+        PlayerPhysics::startJump(_player);
+    }
+
+    // 2. 
+    if (PlayerPhysics::step(_player, dt, _platforms)) {
+        _rescueCount++;
+    }
+
+    // 3. Ѳ߹
+    for (auto& p : _patrollers)
+    {
+        if (!p.isAlive()) continue;
+        p.position.x = PatrolAI::step(p.patrol, p.position.x, dt);
+    }
+
+    _frame++;
+}
+
+void SimWorld::saveSnapshot(SimSnapshot& out) const
+{
+    out.begin((uint32_t)_frame, 0);
+
+    PlayerSnapshot& p = out.player;
+    p = PlayerSnapshot();
+    p.body = _player;
+    p.facingRight = true;
+    p.health = _stats.getHealth();
+    p.soul = _stats.getSoul();
+    p.jumpInputReleased = _jumpReleased;
+    p.castInputReleased = true;
+    if (_rising) p.stateId = (uint8_t)PlayerStateId::JUMP;
+    else p.stateId = (uint8_t)(_player.onGround ? PlayerStateId::IDLE : PlayerStateId::FALL);
+
+    for (int i = 0; i < (int)_patrollers.size(); i++)
+    {
+        EntitySnapshot* e = out.addEntity();
+        if (!e) break;
+        const SimPatroller& src = _patrollers[i];
+        *e = EntitySnapshot();
+        e->tag = i;
+        e->kind = EntitySnapshot::Kind::PATROLLER;
+        e->position = src.position;
+        e->health = src.health;
+        e->facingRight = src.patrol.movingRight;
+        e->onGround = true;
+        e->patrol = src.patrol;
+    }
+
+    out.captureRandom();
+}
+
+bool SimWorld::restoreSnapshot(const SimSnapshot& in)
+{
+    if (!in.isValid() || in.entityCount != (int)_patrollers.size()) return false;
+
+    const PlayerSnapshot& p = in.player;
+    _player = p.body;
+    _stats.restore(p.health, p.soul);
+    _jumpReleased = p.jumpInputReleased;
+    _rising = p.stateId == (uint8_t)PlayerStateId::JUMP;
+
+    for (int i = 0; i < in.entityCount; i++)
+    {
+        const EntitySnapshot& e = in.entities[i];
+        SimPatroller& dst = _patrollers[i];
+        dst.position = e.position;
+        dst.health = e.health;
+        dst.patrol = e.patrol;
+    }
+
+    _frame = in.frame;
+    in.restoreRandom();
+    return true;
+}
@@ -0,0 +1,77 @@
+#ifndef __SIM_WORLD_H__
+#define __SIM_WORLD_H__
+
+#include "SimTypes.h"
+#include "PlayerPhysics.h"
+#include "PlayerStats.h"
+#include "PatrolAI.h"
+#include "SimSnapshot.h"
+#include <vector>
+
+// ==========================================
+// ͷģ ( cocosҪ Director / GL)
+// ڲԡܲԺͳʱһܣһ + ̬ + Ѳ߹
+// ǵ -> Ϸһ (ܡֽض)
+// /۵״̬ PlayerStates 
+// ==========================================
+struct SimInput
+{
+    int moveX = 0;         // -1 / 0 / +1
+    bool jump = false;     // ԾǷס
+};
+
+struct SimPatroller
+{
+    SimVec2 position;
+    SimVec2 size;          // ײߴ (ŵĶ position)
+    PatrolState patrol;
+    int health = 1;
+
+    SimRect getHitbox() const
+    {
+        return SimRect(position.x - size.x * 0.5f, position.y, size.x, size.y);
+    }
+    bool isAlive() const { return health > 0; }
+};
+
+class SimWorld
+{
+public:
+    SimWorld();
+
+    // 
+    void addPlatform(const SimRect& rect) { _platforms.push_back(rect); }
+    void setPlatforms(const SimRectList& rects) { _platforms = rects; }
+    void spawnPlayer(const SimVec2& pos, const SimRect& localBox);
+    SimPatroller& addPatroller(const SimVec2& pos, const SimVec2& size, float left, float right, float speed);
+
+    // ƽһ֡
+    void step(float dt, const SimInput& input);
+
+    //  (ع)Ѳ߹ְ±棻ָʱԲϷ false
+    // Ǿ̬ģ
+    void saveSnapshot(SimSnapshot& out) const;
+    bool restoreSnapshot(const SimSnapshot& in);
+
+    // ѯ
+    const PlayerBody& getPlayer() const { return _player; }
+    PlayerBody& getPlayer() { return _player; }
+    PlayerStats& getStats() { return _stats; }
+    const SimRectList& getPlatforms() const { return _platforms; }
+    std::vector<SimPatroller>& getPatrollers() { return _patrollers; }
+    unsigned long long getFrame() const { return _frame; }
+    int getRescueCount() const { return _rescueCount; }
+
+private:
+    SimRectList _platforms;
+    PlayerBody _player;
+    PlayerStats _stats;
+    std::vector<SimPatroller> _patrollers;
+
+    bool _jumpReleased = true; // Ծɿ
+    bool _rising = false;      // Ӧ StateJump (ٶ֮)
+    unsigned long long _frame = 0;
+    int _rescueCount = 0;      // ͼصĴ (һ)
+};
+
+#endif // __SIM_WORLD_H__
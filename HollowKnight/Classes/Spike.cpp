@@ -1,4 +1,6 @@
 #include "Spike.h"
+#include "Log.h"
+#include "SimCocos.h"
 
 USING_NS_CC;
 
@@ -68,7 +70,7 @@ void Spike::update(float dt, const cocos2d::Vec2& playerPos, const std::vector<c
         // Ƿڴ̵·
         if (isPlayerBelowSpike(playerPos))
         {
-            CCLOG("[Spike] Player detected below! Falling!");
+            HK_LOG_DEBUG(AI, "[Spike] Player detected below! Falling!");
             changeState(State::FALLING);
         }
         break;
@@ -112,7 +114,7 @@ void Spike::changeState(State newState)
     case State::FALLING:
         // ʼʱʼٶ
         _velocity.y = 0;
-        CCLOG("[Spike] State changed to FALLING");
+        HK_LOG_DEBUG(AI, "[Spike] State changed to FALLING");
         break;
 
     case State::DEAD:
@@ -121,7 +123,7 @@ void Spike::changeState(State newState)
         auto fadeOut = FadeOut::create(0.5f);
         auto removeSelf = CallFunc::create([this]() {
             this->removeFromParent();
-            CCLOG("? Spike removed from scene");
+            HK_LOG_DEBUG(AI, "Spike removed from scene");
         });
         auto sequence = Sequence::create(fadeOut, removeSelf, nullptr);
         this->runAction(sequence);
@@ -180,7 +182,7 @@ void Spike::updateCollisionY(const std::vector<cocos2d::Rect>& platforms)
                         // ޸ġغDEAD״̬ʧȥײ˺
                         changeState(State::DEAD);
                         
-                        CCLOG("[Spike] Hit ground! Changed to DEAD state (no collision, no damage)");
+                        HK_LOG_DEBUG(AI, "[Spike] Hit ground! Changed to DEAD state (no collision, no damage)");
                     }
                 }
             }
@@ -208,5 +210,38 @@ void Spike::setInitialPosition(const cocos2d::Vec2& pos)
 
 Spike::~Spike()
 {
-    CCLOG("[Spike] Destructor called");
+    HK_LOG_TRACE(AI, "[Spike] Destructor called");
+}
+
+// ========================================
+// 
+// ========================================
+void Spike::saveSnapshot(EntitySnapshot& out) const
+{
+    out.tag = this->getTag();
+    out.kind = EntitySnapshot::Kind::SPIKE;
+    out.state = (uint8_t)_currentState;
+    out.position = SimCocos::toSim(this->getPosition());
+    out.velocity = SimCocos::toSim(_velocity);
+    out.health = 1;
+    out.facingRight = false;
+    out.onGround = false;
+    out.patrol = PatrolState();
+}
+
+void Spike::restoreSnapshot(const EntitySnapshot& in)
+{
+    this->stopAllActions();
+    this->setOpacity(255);
+    this->setVisible(true);
+
+    this->setPosition(SimCocos::toCocos(in.position));
+    _velocity = SimCocos::toCocos(in.velocity);
+
+    // ֱд״̬ changeState (FALLING Ľ߼ٶ)
+    _currentState = (State)in.state;
+    if (_currentState == State::DEAD) {
+        _currentState = State::FALLING;
+        changeState(State::DEAD);
+    }
 }
@@ -2,6 +2,7 @@
 #define __SPIKE_H__
 
 #include "cocos2d.h"
+#include "SimSnapshot.h"
 
 USING_NS_CC;
 
@@ -30,6 +31,11 @@ public:
     // ô̵ĳʼλãã
     void setInitialPosition(const cocos2d::Vec2& pos);
 
+    //  (SimSnapshot.h)
+    void saveSnapshot(EntitySnapshot& out) const;
+    void restoreSnapshot(const EntitySnapshot& in);
+    bool isDead() const { return _currentState == State::DEAD; }
+
     // 
     virtual ~Spike();
 
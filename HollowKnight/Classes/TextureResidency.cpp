@@ -0,0 +1,213 @@
+#include "TextureResidency.h"
+#include "config.h"
+#include "Profiler.h"
+#include "Log.h"
+#include <algorithm>
+#include <cstring>
+
+USING_NS_CC;
+
+namespace {
+    uint32_t levelBit(int level) { return 1u << level; }
+
+    // ·ǰ׺ (ƥһ)
+    struct Rule
+    {
+        const char* prefix;
+        TextureCategory category;
+        uint32_t levelMask;
+        bool pinned;
+    };
+
+    const Rule RULES[] = {
+        { "knight/", TextureCategory::PLAYER, 0, true },
+        { "HUDanim/", TextureCategory::HUD, 0, true },
+        { "fireball/", TextureCategory::EFFECT, 0, true },
+        { "hit_crack/", TextureCategory::EFFECT, 0, true },
+        { "dialogue/", TextureCategory::EFFECT, 0, false },
+        { "enemies/", TextureCategory::ENEMY, 1u << 1, false },
+        { "zombie/", TextureCategory::ENEMY, 1u << 1, false },
+        { "buzzer/", TextureCategory::ENEMY, 1u << 1, false },
+        { "traps/", TextureCategory::ENEMY, 1u << 1, false },
+        { "warm/", TextureCategory::PROP, 1u << 2, false },
+        { "boss/", TextureCategory::BOSS, 1u << 3, false },
+        { "maps/GameAsset/fight.png", TextureCategory::MAP, 1u << 3, false },
+        { "maps/", TextureCategory::MAP, 0, false },
+    };
+
+    // key ·ǰ׺ڿͷĳ '/' ֮
+    bool matches(const std::string& key, const char* prefix)
+    {
+        size_t len = strlen(prefix);
+        if (key.compare(0, len, prefix) == 0) return true;
+        size_t pos = key.find(prefix);
+        while (pos != std::string::npos) {
+            if (pos > 0 && key[pos - 1] == '/') return true;
+            pos = key.find(prefix, pos + 1);
+        }
+        return false;
+    }
+
+    size_t textureBytes(Texture2D* texture)
+    {
+        return (size_t)texture->getPixelsWide() * texture->getPixelsHigh() * texture->getBitsPerPixelForFormat() / 8;
+    }
+}
+
+TextureResidency* TextureResidency::getInstance()
+{
+    static TextureResidency s_instance;
+    return &s_instance;
+}
+
+TextureResidency::TextureResidency()
+    : _budgetBytes((size_t)Config::Residency::BUDGET_MB * 1024 * 1024)
+{
+}
+
+const char* TextureResidency::getCategoryName(TextureCategory category)
+{
+    static const char* names[] = { "player", "hud", "effect", "enemy", "prop", "map", "boss", "other" };
+    return (int)category < (int)TextureCategory::COUNT ? names[(int)category] : "?";
+}
+
+// ============================================================
+// Ǽ
+// ============================================================
+TextureResidency::Record& TextureResidency::recordFor(const std::string& key)
+{
+    auto it = _index.find(key);
+    if (it != _index.end()) return _records[it->second];
+
+    Record record = { key, TextureCategory::OTHER, 0, false, false, 0, _epoch };
+    for (const auto& rule : RULES) {
+        if (matches(key, rule.prefix)) {
+            record.category = rule.category;
+            record.levelMask = rule.levelMask;
+            record.pinned = rule.pinned;
+            break;
+        }
+    }
+    _index[key] = _records.size();
+    _records.push_back(record);
+    return _records.back();
+}
+
+void TextureResidency::track(const std::string& key, Texture2D* texture)
+{
+    if (key.empty()) return;
+    Record& record = recordFor(key);
+    if (texture) {
+        record.resident = true;
+        record.bytes = textureBytes(texture);
+    }
+}
+
+void TextureResidency::trackMap(TMXTiledMap* map, int level)
+{
+    if (!map) return;
+    auto cache = Director::getInstance()->getTextureCache();
+    for (auto child : map->getChildren())
+    {
+        auto layer = dynamic_cast<TMXLayer*>(child);
+        if (!layer || !layer->getTexture()) continue;
+
+        std::string key = cache->getTextureFilePath(layer->getTexture());
+        if (key.empty()) continue;
+        Record& record = recordFor(key);
+        record.levelMask |= levelBit(level);
+        record.resident = true;
+        record.bytes = textureBytes(layer->getTexture());
+    }
+}
+
+// ============================================================
+// أͳ + ̭ + 
+// ============================================================
+void TextureResidency::refresh(int level)
+{
+    auto cache = Director::getInstance()->getTextureCache();
+    _residentBytes = 0;
+    std::fill(std::begin(_categoryBytes), std::end(_categoryBytes), 0);
+
+    for (auto& record : _records)
+    {
+        Texture2D* texture = cache->getTextureForKey(record.key);
+        record.resident = texture != nullptr;
+        if (!texture) continue;
+
+        record.bytes = textureBytes(texture);
+        // ü > 1˻滹о/֡/
+        if (texture->getReferenceCount() > 1 || (record.levelMask & levelBit(level))) {
+            record.lastUsed = _epoch;
+        }
+        _residentBytes += record.bytes;
+        _categoryBytes[(int)record.category] += record.bytes;
+    }
+}
+
+void TextureResidency::evict(int level)
+{
+    if (_residentBytes <= _budgetBytes) return;
+
+    auto cache = Director::getInstance()->getTextureCache();
+    std::vector<Record*> candidates;
+    for (auto& record : _records)
+    {
+        if (!record.resident || record.pinned || (record.levelMask & levelBit(level))) continue;
+        Texture2D* texture = cache->getTextureForKey(record.key);
+        if (texture && texture->getReferenceCount() == 1) candidates.push_back(&record);
+    }
+
+    // ûõߣͬõ̭
+    std::sort(candidates.begin(), candidates.end(), [](const Record* a, const Record* b) {
+        return a->lastUsed != b->lastUsed ? a->lastUsed < b->lastUsed : a->bytes > b->bytes;
+    });
+
+    for (Record* record : candidates)
+    {
+        if (_residentBytes <= _budgetBytes) break;
+        cache->removeTextureForKey(record->key);
+        record->resident = false;
+        _residentBytes -= record->bytes;
+        _categoryBytes[(int)record->category] -= record->bytes;
+        _evictedCount++;
+    }
+}
+
+void TextureResidency::onLevelEnter(int level)
+{
+    HK_PROFILE_ZONE("TextureResidency::onLevelEnter");
+    _epoch++;
+
+    refresh(level);
+    size_t before = _residentBytes;
+    int evictedBefore = _evictedCount;
+    evict(level);
+
+    // һػõ֮ǰ̭ģ̨ (ɺɻУ´νʱͳ)
+    auto cache = Director::getInstance()->getTextureCache();
+    int reloads = 0;
+    for (const auto& record : _records)
+    {
+        if (record.resident || !(record.levelMask & levelBit(level))) continue;
+        cache->addImageAsync(record.key, [](Texture2D*) {});
+        reloads++;
+    }
+
+    HK_LOG_INFO(LEVEL, "Textures: level %d, %.1f -> %.1f MB (budget %.0f MB), evicted %d, reloading %d | %s",
+        level, before / (1024.0 * 1024.0), _residentBytes / (1024.0 * 1024.0), _budgetBytes / (1024.0 * 1024.0),
+        _evictedCount - evictedBefore, reloads, getSummary());
+}
+
+std::string TextureResidency::getSummary() const
+{
+    std::string out;
+    for (int i = 0; i < (int)TextureCategory::COUNT; i++)
+    {
+        if (_categoryBytes[i] == 0) continue;
+        if (!out.empty()) out += "  ";
+        out += StringUtils::format("%s %.1f", getCategoryName((TextureCategory)i), _categoryBytes[i] / (1024.0 * 1024.0));
+    }
+    return out.empty() ? "(none)" : out + " MB";
+}
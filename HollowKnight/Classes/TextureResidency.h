@@ -0,0 +1,87 @@
+#ifndef __TEXTURE_RESIDENCY_H__
+#define __TEXTURE_RESIDENCY_H__
+
+#include "cocos2d.h"
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+//  (ͳԴ)
+enum class TextureCategory : uint8_t
+{
+    PLAYER = 0,
+    HUD,
+    EFFECT,     // ܻơ
+    ENEMY,
+    PROP,       // ӡ׳
+    MAP,        // ͼ鼯
+    BOSS,
+    OTHER,
+    COUNT
+};
+
+// ==========================================
+// פ
+// TextureCache ֻйԺһصͼ顢ӡBoss ֡ȫԴ
+// - Ǽǹ·࣬ļ (ͼͼ鼯 loadMap ʱ)
+// - ÿν (onLevelEnter) ͳԴ棻Ԥʱδʹõ˳
+//   ̭ڵǰءҲûнڵ/ (üֻʣԼ) 
+// - ǰõ֮ǰ̭ addImageAsync ں̨¼
+// ǡHUDЧפ̭
+// ==========================================
+class TextureResidency
+{
+public:
+    static TextureResidency* getInstance();
+
+    // Ǽһ (key = TextureCache ļ·)
+    void track(const std::string& key, cocos2d::Texture2D* texture);
+    // ͼõͼ鼯һ
+    void trackMap(cocos2d::TMXTiledMap* map, int level);
+
+    // ؿл (¹ؿĵͼͶѴ) ʱ
+    void onLevelEnter(int level);
+
+    size_t getBudgetBytes() const { return _budgetBytes; }
+    void setBudgetBytes(size_t bytes) { _budgetBytes = bytes; }
+
+    // ͳƽֹһ onLevelEnter
+    size_t getResidentBytes() const { return _residentBytes; }
+    size_t getCategoryBytes(TextureCategory category) const { return _categoryBytes[(int)category]; }
+    int getTrackedCount() const { return (int)_records.size(); }
+    int getEvictedCount() const { return _evictedCount; }
+
+    // ռãһı (־ / )
+    std::string getSummary() const;
+
+    static const char* getCategoryName(TextureCategory category);
+
+private:
+    TextureResidency();
+
+    struct Record
+    {
+        std::string key;
+        TextureCategory category;
+        uint32_t levelMask;     //  n λ =  n ػõ
+        bool pinned;            // פ
+        bool resident;
+        size_t bytes;
+        uint32_t lastUsed;      // һαõʱĽ
+    };
+
+    Record& recordFor(const std::string& key);
+    void refresh(int level);    // ͳЩڻЩڱʹ
+    void evict(int level);
+
+    std::vector<Record> _records;
+    std::unordered_map<std::string, size_t> _index;
+    uint32_t _epoch = 0;
+
+    size_t _budgetBytes;
+    size_t _residentBytes = 0;
+    size_t _categoryBytes[(int)TextureCategory::COUNT] = {};
+    int _evictedCount = 0;
+};
+
+#endif // __TEXTURE_RESIDENCY_H__
@@ -1,5 +1,10 @@
 #include "Zombie.h"
 #include "HitEffect.h"
+#include "config.h"
+#include "Profiler.h"
+#include "AllocTracker.h"
+#include "Log.h"
+#include "SimCocos.h"
 
 USING_NS_CC;
 
@@ -24,15 +29,14 @@ bool Zombie::init()
     _currentState = State::PATROL;
     _health = 5;
     _maxHealth = 5;
-    _moveSpeed = 40.0f;
+    _patrol.speed = 40.0f;
     _attackSpeed = 200.0f;
-    _movingRight = true;
+    _patrol.movingRight = true;
     _isFacingRight = true;
     _isInvincible = false;
 
     // AI 
-    _patrolLeftBound = 0.0f;
-    _patrolRightBound = 300.0f;
+    PatrolAI::setRange(_patrol, 0.0f, 300.0f);
     _detectionRange = 400.0f;
 
     // ׷Χ (ȫ)
@@ -47,7 +51,7 @@ bool Zombie::init()
     _maxFallSpeed = -1500.0f;
 
     // ֮ (GameEntity ṩĹ)
-    this->setDreamThought("...Brains...Hungry...");
+    this->setDreamThought(Config::Dialogue::THOUGHT_ZOMBIE);
 
     loadAnimations();
     playWalkAnimation();
@@ -57,6 +61,8 @@ bool Zombie::init()
 
 void Zombie::loadAnimations()
 {
+    HK_PROFILE_ZONE("Zombie::loadAnimations");
+
     // --- · ---
     Vector<SpriteFrame*> walkFrames;
     for (int i = 1; i <= 7; i++) {
@@ -132,7 +138,7 @@ void Zombie::playDeathAnimation() {
         Spawn::create(FadeOut::create(0.5f), RotateBy::create(0.5f, 180), nullptr),
         CallFunc::create([this]() {
             this->removeFromParent();
-            CCLOG("Zombie Dead & Removed");
+            HK_LOG_DEBUG(AI, "Zombie Dead & Removed");
             }),
         nullptr
     );
@@ -140,43 +146,48 @@ void Zombie::playDeathAnimation() {
 }
 
 // ========================================
-//  Update 
+// ֪/ +  ( JobSystem )
+// λþֲƽڵ㱾ֻsetPosition / setFlippedX / ״̬ǽ commands
 // ========================================
-void Zombie::update(float dt, const cocos2d::Vec2& playerPos, const std::vector<cocos2d::Rect>& platforms)
+void Zombie::think(float dt, const cocos2d::Vec2& playerPos, const std::vector<cocos2d::Rect>& platforms,
+                   SceneCommandBuffer& commands, int order)
 {
     if (_currentState == State::DEAD) return;
 
+    Vec2 pos = this->getPosition();
+
     // 1. ʼ
-    if (_spawnPosition == Vec2::ZERO) _spawnPosition = this->getPosition();
+    if (_spawnPosition == Vec2::ZERO) _spawnPosition = pos;
 
     // ============================================================
     // ޸ģ䱣
     // ͼ (ģ)Ҫɾǡء
     // ============================================================
-    if (this->getPositionY() < -300.0f) {
-        CCLOG("[Zombie] Fell off map! Teleporting back to spawn.");
+    if (pos.y < -300.0f) {
+        HK_LOG_WARN(AI, "[Zombie] Fell off map! Teleporting back to spawn.");
 
         // 1. λõ (΢̧һֹ)
-        this->setPosition(_spawnPosition + Vec2(0, 50));
+        commands.setPosition(order, this, _spawnPosition + Vec2(0, 50));
 
         // 2. ٶ (ֹž޴ٶٴδģ)
         _velocity = Vec2::ZERO;
 
         // 3. ״̬ΪѲ
-        changeState(State::PATROL);
+        requestState(State::PATROL, commands, order);
         return;
     }
 
     // ===================================
     // 2. ϵͳY ()
     // ===================================
-    updateMovementY(dt);
-    updateCollisionY(platforms);
+    updateMovementY(dt, pos);
+    updateCollisionY(platforms, pos);
 
     // ״ֻ̬Ӧ˼
     if (_currentState == State::DAMAGED) {
-        updateMovementX(dt);
-        updateCollisionX(platforms);
+        updateMovementX(dt, pos);
+        updateCollisionX(platforms, pos, commands, order);
+        commands.setPosition(order, this, pos);
         return;
     }
 
@@ -186,15 +197,15 @@ void Zombie::update(float dt, const cocos2d::Vec2& playerPos, const std::vector<
     switch (_currentState)
     {
     case State::PATROL:
-        if (isPlayerInRange(playerPos)) {
+        if (isPlayerInRange(playerPos, pos.x)) {
             //  -> ת׼
-            float dir = playerPos.x - this->getPositionX();
+            float dir = playerPos.x - pos.x;
             _isFacingRight = (dir > 0);
-            this->setFlippedX(!_isFacingRight);
-            changeState(State::ATTACK_READY);
+            commands.setFlippedX(order, this, !_isFacingRight);
+            requestState(State::ATTACK_READY, commands, order);
         }
         else {
-            updatePatrolBehavior(dt);
+            updatePatrolBehavior(pos.x, commands, order);
         }
         break;
 
@@ -205,11 +216,11 @@ void Zombie::update(float dt, const cocos2d::Vec2& playerPos, const std::vector<
     case State::ATTACKING:
         // ׷Χ
         if (!isPlayerInChaseRange(playerPos)) {
-            CCLOG("[Zombie] Player too far, give up.");
-            changeState(State::PATROL);
+            HK_LOG_DEBUG(AI, "[Zombie] Player too far, give up.");
+            requestState(State::PATROL, commands, order);
         }
         else {
-            updateAttackBehavior(dt, playerPos);
+            updateAttackBehavior(playerPos, pos.x, commands, order);
         }
         break;
 
@@ -221,50 +232,40 @@ void Zombie::update(float dt, const cocos2d::Vec2& playerPos, const std::vector<
     // ===================================
     // ֻзǾֹ״̬ҪX
     if (_velocity.x != 0) {
-        updateMovementX(dt);
-        updateCollisionX(platforms);
+        updateMovementX(dt, pos);
+        updateCollisionX(platforms, pos, commands, order);
     }
+    commands.setPosition(order, this, pos);
 }
 
 // ========================================
 // AI Ϊ߼
 // ========================================
-bool Zombie::isPlayerInRange(const cocos2d::Vec2& playerPos) {
-    return std::abs(playerPos.x - this->getPositionX()) <= _detectionRange;
+bool Zombie::isPlayerInRange(const cocos2d::Vec2& playerPos, float x) const {
+    return std::abs(playerPos.x - x) <= _detectionRange;
 }
 
-bool Zombie::isPlayerInChaseRange(const cocos2d::Vec2& playerPos) {
+bool Zombie::isPlayerInChaseRange(const cocos2d::Vec2& playerPos) const {
     return std::abs(playerPos.x - _spawnPosition.x) <= _maxChaseRange;
 }
 
-void Zombie::updatePatrolBehavior(float dt) {
-    if (_movingRight) {
-        _velocity.x = _moveSpeed;
-        if (getPositionX() >= _patrolRightBound) {
-            _movingRight = false;
-            _isFacingRight = false;
-            this->setFlippedX(true);
-        }
-    }
-    else {
-        _velocity.x = -_moveSpeed;
-        if (getPositionX() <= _patrolLeftBound) {
-            _movingRight = true;
-            _isFacingRight = true;
-            this->setFlippedX(false);
-        }
+void Zombie::updatePatrolBehavior(float x, SceneCommandBuffer& commands, int order) {
+    // ǰٶȣ߽ PatrolAI ͷ
+    _velocity.x = _patrol.direction() * _patrol.speed;
+    if (PatrolAI::checkTurn(_patrol, x)) {
+        _isFacingRight = _patrol.movingRight;
+        commands.setFlippedX(order, this, !_isFacingRight);
     }
 }
-
-void Zombie::updateAttackBehavior(float dt, const cocos2d::Vec2& playerPos) {
-    float dir = playerPos.x - getPositionX();
+void Zombie::updateAttackBehavior(const cocos2d::Vec2& playerPos, float x, SceneCommandBuffer& commands, int order) {
+    float dir = playerPos.x - x;
 
     // 򵥵׷߼
     if (_isFacingRight && dir > 0) _velocity.x = _attackSpeed;
     else if (!_isFacingRight && dir < 0) _velocity.x = -_attackSpeed;
     else {
         // ܵ -> Ѳ
-        changeState(State::PATROL);
+        requestState(State::PATROL, commands, order);
     }
 }
 
@@ -277,7 +278,7 @@ void Zombie::takeDamage(int damage, const cocos2d::Vec2& attackerPos)
 
     _health -= damage;
     _isInvincible = true;
-    CCLOG("Zombie Hit! HP: %d", _health);
+    HK_LOG_DEBUG(COMBAT, "Zombie Hit! HP: %d", _health);
 
     // ====== ܻЧλ΢ƫ£ ======
     float fxSize = std::max(this->getContentSize().width, this->getContentSize().height) * 0.8f;
@@ -339,8 +340,27 @@ void Zombie::changeState(State newState)
 {
     if (_currentState == newState) return;
     _currentState = newState;
+    playStateAnimation(newState);
+}
 
-    switch (_currentState) {
+// ߽׶״̬״ֵ̬Ч (ͬһ֡ľҪ)ǳ̲߳
+void Zombie::requestState(State newState, SceneCommandBuffer& commands, int order)
+{
+    if (_currentState == newState) return;
+    _currentState = newState;
+    commands.call(order, this, &Zombie::enterStateCommand, (int)newState);
+}
+
+void Zombie::enterStateCommand(Node* node, int state)
+{
+    static_cast<Zombie*>(node)->playStateAnimation((State)state);
+}
+
+void Zombie::playStateAnimation(State state)
+{
+    HK_ALLOW_ALLOC_SCOPE("Zombie::changeState"); // ״̬½
+
+    switch (state) {
     case State::PATROL: playWalkAnimation(); break;
     case State::ATTACK_READY: playAttackReadyAnimation(); break;
     case State::ATTACKING: playAttackAnimation(); break;
@@ -350,8 +370,7 @@ void Zombie::changeState(State newState)
 }
 
 void Zombie::setPatrolRange(float left, float right) {
-    _patrolLeftBound = left;
-    _patrolRightBound = right;
+    PatrolAI::setRange(_patrol, left, right);
 }
 
 cocos2d::Rect Zombie::getHitbox() const {
@@ -365,15 +384,22 @@ cocos2d::Rect Zombie::getHitbox() const {
 // ========================================
 //  ( File 1)
 // ========================================
-void Zombie::updateMovementY(float dt) {
+// ڵ㵱ǰײƽƵ pos (߽׶νڵλûû)
+cocos2d::Rect Zombie::boxAt(const cocos2d::Vec2& pos) const {
+    Rect rect = this->getBoundingBox();
+    rect.origin += pos - this->getPosition();
+    return rect;
+}
+
+void Zombie::updateMovementY(float dt, cocos2d::Vec2& pos) {
     _velocity.y -= _gravity * dt;
     if (_velocity.y < _maxFallSpeed) _velocity.y = _maxFallSpeed;
-    setPositionY(getPositionY() + _velocity.y * dt);
+    pos.y += _velocity.y * dt;
 }
 
-void Zombie::updateCollisionY(const std::vector<cocos2d::Rect>& platforms) {
+void Zombie::updateCollisionY(const std::vector<cocos2d::Rect>& platforms, cocos2d::Vec2& pos) {
     _isOnGround = false;
-    Rect rect = this->getBoundingBox();
+    Rect rect = boxAt(pos);
     for (const auto& wall : platforms) {
         if (rect.intersectsRect(wall)) {
             float overlapX = std::min(rect.getMaxX(), wall.getMaxX()) - std::max(rect.getMinX(), wall.getMinX());
@@ -381,7 +407,7 @@ void Zombie::updateCollisionY(const std::vector<cocos2d::Rect>& platforms) {
                 if (_velocity.y <= 0) { // 
                     float overlapY = wall.getMaxY() - rect.getMinY();
                     if (overlapY > -0.1f && overlapY <= 40.0f) {
-                        setPositionY(wall.getMaxY() + rect.size.height * 0.5f);
+                        pos.y = wall.getMaxY() + rect.size.height * 0.5f;
                         _velocity.y = 0;
                         _isOnGround = true;
                     }
@@ -391,32 +417,32 @@ void Zombie::updateCollisionY(const std::vector<cocos2d::Rect>& platforms) {
     }
 }
 
-void Zombie::updateMovementX(float dt) {
-    setPositionX(getPositionX() + _velocity.x * dt);
+void Zombie::updateMovementX(float dt, cocos2d::Vec2& pos) {
+    pos.x += _velocity.x * dt;
 }
 
-void Zombie::updateCollisionX(const std::vector<cocos2d::Rect>& platforms) {
-    Rect rect = this->getBoundingBox();
+void Zombie::updateCollisionX(const std::vector<cocos2d::Rect>& platforms, cocos2d::Vec2& pos, SceneCommandBuffer& commands, int order) {
+    Rect rect = boxAt(pos);
     for (const auto& wall : platforms) {
         if (rect.intersectsRect(wall)) {
             float overlapY = std::min(rect.getMaxY(), wall.getMaxY()) - std::max(rect.getMinY(), wall.getMinY());
             if (overlapY > rect.size.height * 0.5f) {
                 if (_velocity.x > 0) { // ײ
-                    setPositionX(wall.getMinX() - rect.size.width * 0.5f - 0.1f);
+                    pos.x = wall.getMinX() - rect.size.width * 0.5f - 0.1f;
                     _velocity.x = 0;
                     if (_currentState == State::PATROL) { // Զת
-                        _movingRight = false;
+                        _patrol.movingRight = false;
                         _isFacingRight = false;
-                        this->setFlippedX(true);
+                        commands.setFlippedX(order, this, true);
                     }
                 }
                 else if (_velocity.x < 0) { // ײ
-                    setPositionX(wall.getMaxX() + rect.size.width * 0.5f + 0.1f);
+                    pos.x = wall.getMaxX() + rect.size.width * 0.5f + 0.1f;
                     _velocity.x = 0;
                     if (_currentState == State::PATROL) {
-                        _movingRight = true;
+                        _patrol.movingRight = true;
                         _isFacingRight = true;
-                        this->setFlippedX(false);
+                        commands.setFlippedX(order, this, false);
                     }
                 }
             }
@@ -429,4 +455,56 @@ Zombie::~Zombie() {
     CC_SAFE_RELEASE(_attackReadyAnimation);
     CC_SAFE_RELEASE(_attackAnimation);
     CC_SAFE_RELEASE(_deathAnimation);
-}
\ No newline at end of file
+}
+
+// ========================================
+// 
+// ========================================
+void Zombie::saveSnapshot(EntitySnapshot& out) const
+{
+    out.tag = this->getTag();
+    out.kind = EntitySnapshot::Kind::ZOMBIE;
+    out.state = (uint8_t)_currentState;
+    out.position = SimCocos::toSim(this->getPosition());
+    out.velocity = SimCocos::toSim(_velocity);
+    out.health = _health;
+    out.facingRight = _isFacingRight;
+    out.onGround = _isOnGround;
+    out.patrol = _patrol;
+}
+
+void Zombie::restoreSnapshot(const EntitySnapshot& in)
+{
+    this->stopAllActions();
+    this->unscheduleAllCallbacks();
+    this->setColor(Color3B::WHITE);
+    this->setOpacity(255);
+    this->setRotation(0);
+    _isInvincible = false;
+
+    this->setPosition(SimCocos::toCocos(in.position));
+    _velocity = SimCocos::toCocos(in.velocity);
+    _health = in.health;
+    _isFacingRight = in.facingRight;
+    this->setFlippedX(!_isFacingRight);
+    _isOnGround = in.onGround;
+    _patrol = in.patrol;
+
+    // ״̬л scheduleOnce ģָʱӸ״̬ͷ¼ʱ
+    _currentState = (State)in.state;
+    switch (_currentState) {
+    case State::PATROL: playWalkAnimation(); break;
+    case State::ATTACK_READY: playAttackReadyAnimation(); break;
+    case State::ATTACKING: playAttackAnimation(); break;
+    case State::DEAD: playDeathAnimation(); break;
+    case State::DAMAGED:
+        playWalkAnimation();
+        this->scheduleOnce([this](float) {
+            if (_currentState == State::DAMAGED) {
+                _velocity.x = 0;
+                changeState(State::PATROL);
+            }
+            }, 0.3f, "recover_state");
+        break;
+    }
+}
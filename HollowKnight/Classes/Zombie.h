@@ -4,6 +4,9 @@
 #include "cocos2d.h"
 #include <functional> //  std::function
 #include "GameEntity.h"
+#include "PatrolAI.h"
+#include "SimSnapshot.h"
+#include "SceneCommandBuffer.h"
 
 USING_NS_CC;
 
@@ -25,8 +28,11 @@ public:
     // ʼ
     virtual bool init() override;
 
-    // ĺϲÿ֡ (ͬʱ λ  ƽ̨)
-    void update(float dt, const cocos2d::Vec2& playerPos, const std::vector<cocos2d::Rect>& platforms);
+    // ÿ֡ĸ֪/ +  (ͬʱ λ  ƽ̨)
+    // ֻλú͵ΡֻдԼĳԱ JobSystem ܣ
+    // λá״̬ () ǽ commands߳ commit
+    void think(float dt, const cocos2d::Vec2& playerPos, const std::vector<cocos2d::Rect>& platforms,
+               SceneCommandBuffer& commands, int order);
 
     // ܻ
     void takeDamage(int damage, const cocos2d::Vec2& attackerPos) override;
@@ -44,6 +50,11 @@ public:
     typedef std::function<void()> DeathCallback;
     void setOnDeathCallback(DeathCallback callback) { _onDeathCallback = callback; }
 
+    //  (SimSnapshot.h)ָʱ/˸ȽеĶ޵дڲָ
+    void saveSnapshot(EntitySnapshot& out) const;
+    void restoreSnapshot(const EntitySnapshot& in);
+    bool isDead() const { return _currentState == State::DEAD; }
+
     // 
     virtual ~Zombie();
 
@@ -51,6 +62,9 @@ private:
     // ״̬
     State _currentState;
     void changeState(State newState);
+    void requestState(State newState, SceneCommandBuffer& commands, int order); // ߽׶
+    static void enterStateCommand(cocos2d::Node* node, int state);
+    void playStateAnimation(State state);
 
     // 
     void loadAnimations();
@@ -60,24 +74,22 @@ private:
     void playDeathAnimation();
 
     // AI߼
-    bool isPlayerInRange(const cocos2d::Vec2& playerPos);
-    bool isPlayerInChaseRange(const cocos2d::Vec2& playerPos); //  File 2׷Χ
+    bool isPlayerInRange(const cocos2d::Vec2& playerPos, float x) const;
+    bool isPlayerInChaseRange(const cocos2d::Vec2& playerPos) const; //  File 2׷Χ
 
-    void updatePatrolBehavior(float dt);
-    void updateAttackBehavior(float dt, const cocos2d::Vec2& playerPos);
+    void updatePatrolBehavior(float x, SceneCommandBuffer& commands, int order);
+    void updateAttackBehavior(const cocos2d::Vec2& playerPos, float x, SceneCommandBuffer& commands, int order);
 
-    // · ()
-    void updateMovementY(float dt);
-    void updateCollisionY(const std::vector<cocos2d::Rect>& platforms);
-    void updateMovementX(float dt);
-    void updateCollisionX(const std::vector<cocos2d::Rect>& platforms);
+    // · () pos ƽֱӸĽڵ
+    cocos2d::Rect boxAt(const cocos2d::Vec2& pos) const;
+    void updateMovementY(float dt, cocos2d::Vec2& pos);
+    void updateCollisionY(const std::vector<cocos2d::Rect>& platforms, cocos2d::Vec2& pos);
+    void updateMovementX(float dt, cocos2d::Vec2& pos);
+    void updateCollisionX(const std::vector<cocos2d::Rect>& platforms, cocos2d::Vec2& pos, SceneCommandBuffer& commands, int order);
 
     // ƶ
-    float _moveSpeed;           // Ѳٶ
+    PatrolState _patrol;        // Ѳٶȡұ߽ (ͷ PatrolAI)
     float _attackSpeed;         // ƶٶ
-    bool _movingRight;          // Ƿƶ
-    float _patrolLeftBound;     // Ѳ߽
-    float _patrolRightBound;    // Ѳұ߽
 
     // ⷶΧ
     float _detectionRange;      // ҵķΧ
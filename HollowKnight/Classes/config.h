@@ -2,17 +2,9 @@
 #define __GAME_CONFIG_H__
 
 #include "cocos2d.h"
+#include "SimConfig.h" //  cocos 淨ֵ (ֵ)
 
 namespace Config {
-    struct PlayerStatConfig {
-        int maxHealth = 5;       // Ѫ
-        int maxSoul = 4;         // 
-        int healCost = 1;        // Ѫ
-        int soulGainPerKill = 1; // ɱһ֣ 1  ( 1/4 ƿ)
-	};
-    // ȫĬʵ
-    static const PlayerStatConfig DEFAULT_PLAYER_CFG;
-
     namespace Soul {
         // 
         const float FRAME_SPEED = 0.18f;    // ÿ֡ٶ (0.1һ֡)
@@ -36,12 +28,6 @@ namespace Config {
         const int FRAMES_FULL = 5;
     }
 
-        namespace Skill {
-            const int FIREBALL_COST = 1;     //  1  (1/3  1/4 ƿ)
-            const float FIREBALL_SPEED = 600.0f; // ٶ
-            const int FIREBALL_DAMAGE = 2;   // ˺ (ͨƽ)
-        }
-
     namespace Health {
         // Ѫ·
         const std::string PATH_FULL = "HUDanim/health/full/full.png";
@@ -56,23 +42,14 @@ namespace Config {
         const int FRAMES_BREAK = 6;
     }
 
-    namespace Player {
-        // 
-        const float MOVE_SPEED = 300.0f;
-        const float GRAVITY = 2000.0f;
-        const float MAX_FALL_SPEED = -1500.0f;
-
-        // ָв
-        const float MAX_JUMP_TIME = 0.35f;      // Ծʱ
-        const float JUMP_ACCEL = 3000.0f;       // ٶ
-        const float JUMP_FORCE_BASE = 400.0f;
+    namespace HUD {
+        // HUD ͼ (tools/pack_hud_atlas.py )֡ Soul / Health ԭʼ·
+        const std::string ATLAS_PLIST = "HUDanim/hud_atlas.plist";
+        const std::string ATLAS_TEXTURE = "HUDanim/hud_atlas.png";
+        const int BATCH_CAPACITY = 32;
 
-        // ս
-        const float ATTACK_COOLDOWN = 0.04f;
-
-        // ֮
-        const float DREAM_NAIL_CHARGE_TIME = 0.3f; // Ҫ ()
-        const float DREAM_NAIL_RANGE = 200.0f;     //  (ͨԶ)
+        const float FRAME_GROW_SPEED = 0.1f;  //  0.1һ֡
+        const float HEALTH_ANIM_SPEED = 0.06f; // Ѫ/ 0.06һ֡
     }
 
     namespace Path {
@@ -98,8 +75,8 @@ namespace Config {
         static const char* PLAYER_CAST_RELEASE = "knight/fireballCast/fireballCast_%d.png";        static const char* PLAYER_ANTIC = "knight/fireballAntic/fireballAntic_%d.png";
         static const char* EFFECT_FOCUS_LOOP = "knight/focusGet/focusEffect/focusEffect_%d.png";
         static const char* EFFECT_FOCUS_END = "knight/focusEnd/focusEffectEnd/focusEffectEnd_%d.png";
-        static const char* DREAM_NAIL_CHARGE = "Knight/DNcharge/DNcharge_%d.png";
-        static const char* DREAM_NAIL_SLASH = "Knight/DNslash/DNslash_%d.png";
+        static const char* DREAM_NAIL_CHARGE = "knight/DNcharge/DNcharge_%d.png";
+        static const char* DREAM_NAIL_SLASH = "knight/DNslash/DNslash_%d.png";
 
         // Ч
         static const std::string FIREBALL_IDLE = "fireball/idle/fireball_%d.png";
@@ -110,6 +87,33 @@ namespace Config {
         static const std::string DREAM_DIALOGUE_DOWN = "dialogue/dreamDown/dreamDown_%d.png";
     }
 
+    // ֮Ի
+    namespace Dialogue {
+        static const char* FONT = "fonts/Marker Felt.ttf";
+        const float FONT_SIZE = 60.0f;
+        const int OUTLINE_SIZE = 1;
+
+        const float BUBBLE_FRAME_DELAY = 0.05f; // ݵ/ջ 0.05һ֡
+        const int BUBBLE_FRAMES = 5;
+        const float HOLD_TIME = 5.0f;           // ͣĶʱ
+        const int POOL_SIZE = 4;                // ԤȴĶԻ
+
+        // ıзʱݴԤͼ
+        static const char* THOUGHT_ENEMY = "...Duty... ...King...";
+        static const char* THOUGHT_ZOMBIE = "...Brains...Hungry...";
+        static const char* THOUGHT_BUZZER = "...Kill...Crush...";
+        static const char* THOUGHT_JAR_1 = "Save me...I hold the flame...";
+        static const char* THOUGHT_JAR_2 = "...The first one... holds the flame....";
+        static const char* THOUGHT_JAR_3 = "...The middle one... is empty...";
+        static const char* HINT_LEVEL_2 = "Listen to the dream...Three voices... Only one speaks the truth...Save that one to hold the flame...";
+
+        static const char* const ALL_TEXTS[] = {
+            THOUGHT_ENEMY, THOUGHT_ZOMBIE, THOUGHT_BUZZER,
+            THOUGHT_JAR_1, THOUGHT_JAR_2, THOUGHT_JAR_3,
+            HINT_LEVEL_2
+        };
+    }
+
     // Ƶ· 
     namespace Audio {
         // 
@@ -136,6 +140,117 @@ namespace Config {
         static const char* FOCUS_HEAL = "audio/focus_health_heal.mp3";
     }
 
+    //  (MusicPlayer)
+    namespace Music {
+        const float VOLUME = 0.5f;
+        const float CROSSFADE_TIME = 1.3f;      // йصĺ (0.5 + 0.3 + 0.5 ) һ
+    }
+
+    // Чʱת WAV (SfxTranscoder)
+    namespace Sfx {
+        const float MAX_SECONDS = 2.5f;         // ȵЧ PCM (ܲѭ 2.1 Ҳ)
+        const int BUDGET_KB = 8192;             // ת PCM  ()ļ MP3
+        static const char* CACHE_DIR = "sfx_pcm/"; // дĿ¼
+    }
+
+    // Ч (AudioManagerЧ/ȼ AudioManager.cpp Ǽ)
+    namespace AudioMix {
+        const int MAX_VOICES = 16;                  // ͬʱЧ ()
+    }
+
+    // ֡ʲ (˵/ͣʱ֡ʡ)
+    namespace Power {
+        const int ACTIVE_FPS = 60;          // Ϸ
+        const int DEFAULT_IDLE_FPS = 15;    // ˵/ͣʱĬ֡
+        const int MIN_IDLE_FPS = 1;
+        const float INPUT_BOOST_TIME = 0.6f; // ˵аʱָ֡ʱ ()
+        static const char* IDLE_FPS_KEY = "IdleFPS"; // UserDefault 洢
+    }
+
+    // ع (ScenarioRunner)
+    namespace Scenario {
+        const float FIXED_DT = 1.0f / 60;      // ̶ʵ֡Ӱ
+        const float P99_BUDGET_MS = 4.0f;      // ֡ģʱ p99  (Ⱦ)
+        const int WARMUP_FRAMES = 30;          // ؿл/Դ״μغԤ֡ͳ
+        const int TRANSITION_TIMEOUT = 600;    // ȴؿл뵭֡
+        const int LEVEL1_MAX_FRAMES = 60 * 120;
+        const int LEVEL2_MAX_FRAMES = 60 * 90;
+        const int LEVEL3_MAX_FRAMES = 60 * 180;
+        static const char* ENV_VAR = "HK_SCENARIO";            // úʱֻܳ
+        static const char* REPORT_FILE = "scenario_results.json";
+    }
+    namespace Replay {
+        const bool RECORD_SESSIONS = true;         // ÿԶ¼ (ÿ֡ 2~8 ֽ)
+        const int FLUSH_INTERVAL_FRAMES = 300;     // ÿ֡׷дһ
+        const unsigned long long SCENARIO_SEED = 20240601; // عԹ̶
+        static const char* FILE_NAME = "session.hkr";      // ддĿ¼һֱΪ session.hkr_prev
+        static const char* ENV_VAR = "HK_REPLAY";          // Ϊ¼·ʱֻطһ
+        static const char* REPORT_FILE = "replay_results.json";
+    }
+
+    // ֡ڷֶμʱ (Profiler)
+    namespace Profiler {
+        const size_t MAX_EVENTS = 1 << 18;     // һβɼ¼ (Ԥ䣬˾Ͷ)
+        const auto CAPTURE_KEY = cocos2d::EventKeyboard::KeyCode::KEY_F9; // ʼ/ɼ
+        static const char* TRACE_PREFIX = "trace_"; // ļǰ׺ (ддĿ¼)
+    }
+
+    //  (PerfOverlayLayer)
+    namespace PerfOverlay {
+        const auto TOGGLE_KEY = cocos2d::EventKeyboard::KeyCode::KEY_F3;
+        static const char* FONT = "fonts/arial.ttf";
+        const float FONT_SIZE = 24.0f;
+        const int GRAPH_SAMPLES = 120;          // ֡ʱ߱֡
+        const float GRAPH_WIDTH = 480.0f;
+        const float GRAPH_HEIGHT = 120.0f;
+        const float GRAPH_MAX_MS = 50.0f;       // 
+        const float REFRESH_INTERVAL = 0.25f;   // /ֶκʱˢ¼ ()
+        const float TEXTURE_INFO_INTERVAL = 1.0f; // ڴͳƽϹ󣬵Ƶ
+        const float MARGIN = 20.0f;
+    }
+
+    // Ԥ (PreloadScene / AssetPreloader)
+    namespace Preload {
+        static const char* MANIFEST = "preload_manifest.txt"; // tools/gen_preload_manifest.py 
+        const float FRAME_BUDGET_MS = 6.0f;     // ÿ֡߳ϴ/Чʱ
+        const int MAX_DECODED_AHEAD = 48;       // ѽδϴͼƬ (ڴֵ)
+        const int IMAGES_PER_JOB = 4;           // ÿͼ
+        const float MIN_SHOW_TIME = 0.3f;       // ʾ (ȫʱ)
+        static const char* FONT = "fonts/arial.ttf";
+    }
+
+    // ǶƬεķּ (PlayerAnimator)
+    namespace Anim {
+        const float LOAD_BUDGET_MS = 1.0f;      // ÿ֡ں̨ض֡ʱ
+    }
+
+    // פ (TextureResidency)
+    namespace Residency {
+        const int BUDGET_MB = 128;              // ԴԤ㣺ʱͰδʹ̭ؿ
+    }
+
+    // Դ (PackFileUtils tools/build_pack.py ɣʱɢļ)
+    namespace Pack {
+        static const char* FILE_NAME = "assets.pak";
+    }
+
+    // ֱʵλ (AppDelegate ڸ߶ѡԴ tools/gen_resolution_tiers.py )
+    // ԭͼƷֱ 2048x1536  (UHD)content scale factor ڵλ
+    namespace Resolution {
+        static const char* HD_DIR = "tier-hd";  // еȴ ( <= 768)
+        const float HD_SCALE = 0.5f;
+        static const char* SD_DIR = "tier-sd";  // С ( <= 320)
+        const float SD_SCALE = 0.25f;
+        static const char* MARKER = "tier_info.txt"; // λĿ¼ʱУȱ˾˻ԭͼ
+    }
+
+    // ־ (Log)
+    namespace Log {
+        const size_t RING_SIZE = 4096;          // λ ( 2 )
+        const int DRAIN_INTERVAL_MS = 20;       // ̨߳̿ʱѯ
+        static const char* FILE_NAME = "game.log"; // ддĿ¼
+    }
+
     namespace Render {
         const int Z_ORDER_PLAYER = 10;
         const int Z_ORDER_ENEMY = 5;
@@ -0,0 +1,145 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+把 Resources 下的资源打成一个资源包 Resources/assets.pak (PackArchive / PackFileUtils 读取)。
+
+- 路径是相对 Resources 的写法 (例如 "knight/idle/idle_1.png"、"tier-sd/maps/level1.tmx")，
+  索引按路径字节序排好，运行时二分查找
+- 内容完全相同的文件只存一份 (按内容哈希去重，哈希相同时再逐字节比较)
+- 数据块按预加载清单的顺序排：先原图档位，再各分辨率档位，其余的按路径排在后面，
+  启动加载基本是顺序读
+- 音频不进包：SimpleAudioEngine 按路径自己打开文件，读不到包里的内容
+
+文件布局见 Classes/PackArchive.h (小端)。
+
+用法：python3 tools/build_pack.py   (在 HollowKnight 目录下执行；发布前在 gen_resolution_tiers.py 之后跑)
+改了资源要重跑，否则游戏读到的是包里的旧内容
+"""
+import hashlib
+import os
+import struct
+import sys
+
+ROOT = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "Resources")
+OUT = "assets.pak"
+MANIFEST = "preload_manifest.txt"
+TIER_DIRS = ["tier-hd", "tier-sd"]      # 和 gen_resolution_tiers.py 一致
+
+SKIP_DIRS = {"audio"}
+SKIP_FILES = {OUT, ".gitkeep"}
+
+MAGIC = 0x4B504B48  # "HKPK"
+VERSION = 1
+HEADER = struct.Struct("<IIIIQQQQ")
+ENTRY = struct.Struct("<IIII")
+BLOB = struct.Struct("<QQQ")
+ALIGN = 16
+
+
+def collect():
+    files = []
+    for dirpath, dirnames, names in os.walk(ROOT):
+        if os.path.samefile(dirpath, ROOT):
+            dirnames[:] = [d for d in dirnames if d not in SKIP_DIRS]
+        for n in names:
+            if n in SKIP_FILES:
+                continue
+            rel = os.path.relpath(os.path.join(dirpath, n), ROOT).replace(os.sep, "/")
+            files.append(rel)
+    return sorted(files)
+
+
+def manifest_order():
+    """预加载清单里的路径 (按加载顺序)，atlas 的 plist 和纹理都算"""
+    paths = []
+    path = os.path.join(ROOT, MANIFEST)
+    if not os.path.exists(path):
+        return paths
+    with open(path, encoding="utf-8") as f:
+        for line in f:
+            line = line.strip()
+            if not line or line.startswith("#"):
+                continue
+            kind, _, rest = line.partition(" ")
+            paths += rest.split("|")
+    return paths
+
+
+def align(n):
+    return (n + ALIGN - 1) // ALIGN * ALIGN
+
+
+def main():
+    files = collect()
+    present = set(files)
+
+    # 数据块顺序：每个档位按清单顺序，之后是剩下的文件
+    order = []
+    seen = set()
+    startup = manifest_order()
+    for prefix in [""] + [d + "/" for d in TIER_DIRS]:
+        for p in startup:
+            rel = prefix + p
+            if rel in present and rel not in seen:
+                order.append(rel)
+                seen.add(rel)
+    order += [f for f in files if f not in seen]
+
+    blobs = []          # [hash, data]
+    by_hash = {}        # hash -> [blob index]
+    blob_of = {}
+    for rel in order:
+        with open(os.path.join(ROOT, rel), "rb") as f:
+            data = f.read()
+        h = int.from_bytes(hashlib.blake2b(data, digest_size=8).digest(), "little")
+        index = next((i for i in by_hash.get(h, []) if blobs[i][1] == data), None)
+        if index is None:
+            index = len(blobs)
+            blobs.append((h, data))
+            by_hash.setdefault(h, []).append(index)
+        blob_of[rel] = index
+
+    # 索引按 UTF-8 字节序排 (和运行时的 memcmp 一致)
+    names = sorted(files, key=lambda s: s.encode("utf-8"))
+    name_bytes = bytearray()
+    entries = []
+    for rel in names:
+        b = rel.encode("utf-8")
+        entries.append((len(name_bytes), len(b), blob_of[rel], 0))
+        name_bytes += b
+
+    entries_offset = align(HEADER.size)
+    blobs_offset = align(entries_offset + ENTRY.size * len(entries))
+    names_offset = blobs_offset + BLOB.size * len(blobs)
+    data_offset = align(names_offset + len(name_bytes))
+
+    blob_records = []
+    offset = data_offset
+    for h, data in blobs:
+        blob_records.append((offset, len(data), h))
+        offset = align(offset + len(data))
+
+    out_path = os.path.join(ROOT, OUT)
+    with open(out_path, "wb") as f:
+        f.write(HEADER.pack(MAGIC, VERSION, len(entries), len(blobs),
+                            entries_offset, blobs_offset, names_offset, len(name_bytes)))
+        f.write(b"\0" * (entries_offset - f.tell()))
+        for e in entries:
+            f.write(ENTRY.pack(*e))
+        f.write(b"\0" * (blobs_offset - f.tell()))
+        for r in blob_records:
+            f.write(BLOB.pack(*r))
+        f.write(name_bytes)
+        for (_, data), (start, _, _) in zip(blobs, blob_records):
+            f.write(b"\0" * (start - f.tell()))
+            f.write(data)
+
+    raw = sum(os.path.getsize(os.path.join(ROOT, rel)) for rel in files)
+    stored = sum(len(d) for _, d in blobs)
+    print("packed %d files into %s: %d blobs, %.1f MB -> %.1f MB (%d duplicates)"
+          % (len(files), OUT, len(blobs), raw / 1048576.0, stored / 1048576.0, len(files) - len(blobs)))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,122 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+生成启动预加载清单 Resources/preload_manifest.txt (PreloadScene 读取)。
+
+每行一条：<类型> <路径> [附加参数]
+  image  单张图片 (工作线程解码，主线程分帧上传到 TextureCache)
+  atlas  图集 plist + 纹理 (纹理同 image，上传后登记到 SpriteFrameCache)
+  map    TMX 地图 (工作线程读进内存，loadMap 直接从内存解析)
+  music  背景音乐 / sound 音效 (主线程逐个 preload)
+
+路径和代码里用的写法保持一致 (区分大小写)，否则 TextureCache 按完整路径查不到，
+进游戏时还会再读一次盘。排在前面的先加载：主角和第一关放最前。
+
+用法：python3 tools/gen_preload_manifest.py   (在 HollowKnight 目录下执行，加了新资源后重跑)
+"""
+import os
+import re
+import sys
+
+ROOT = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "Resources")
+OUT = "preload_manifest.txt"
+
+# 按目录整体预加载的图片 (顺序即加载顺序)
+IMAGE_DIRS = [
+    "knight",
+    "fireball",
+    "hit_crack",
+    "enemies",
+    "zombie",
+    "buzzer",
+    "traps",
+    "dialogue",
+    "warm",
+    "boss",
+]
+
+# 不在上面目录里、代码直接引用的单张图
+EXTRA_IMAGES = [
+    "maps/GameAsset/fight.png",
+]
+
+ATLASES = [
+    ("HUDanim/hud_atlas.plist", "HUDanim/hud_atlas.png"),
+]
+
+MAPS = ["maps/level1.tmx", "maps/level2.tmx", "maps/level3.tmx"]
+
+MUSIC = [
+    "audio/Royal_HollowKnight_Theme.mp3",
+    "audio/BossBattle.mp3",
+]
+
+
+def natural_key(path):
+    # idle_2.png 排在 idle_10.png 前面，和代码里 1..N 的加载顺序一致
+    return [int(t) if t.isdigit() else t for t in re.split(r"(\d+)", path)]
+
+
+def collect_dir(rel):
+    files = []
+    for dirpath, _, names in os.walk(os.path.join(ROOT, rel)):
+        for n in names:
+            if n.endswith(".png"):
+                files.append(os.path.relpath(os.path.join(dirpath, n), ROOT).replace(os.sep, "/"))
+    return sorted(files, key=natural_key)
+
+
+def tilesets(tmx):
+    # TMX 里的图块集路径相对于 tmx 所在目录
+    base = os.path.dirname(tmx)
+    with open(os.path.join(ROOT, tmx), encoding="utf-8") as f:
+        sources = re.findall(r'<image[^>]*source="([^"]+)"', f.read())
+    return [base + "/" + s for s in sources]
+
+
+def main():
+    lines = [
+        "# 启动预加载清单 (tools/gen_preload_manifest.py 生成，不要手改)",
+        "# <类型> <路径> [参数]，路径里可以有空格：类型之后到行尾 (atlas 用 | 分隔纹理)",
+    ]
+    seen = set()
+
+    def add(kind, path, extra=None):
+        if path in seen:
+            return
+        seen.add(path)
+        lines.append("%s %s" % (kind, path) + ("|" + extra if extra else ""))
+
+    for plist, png in ATLASES:
+        add("atlas", plist, png)
+    for d in IMAGE_DIRS:
+        for f in collect_dir(d):
+            add("image", f)
+    for f in EXTRA_IMAGES:
+        add("image", f)
+    for tmx in MAPS:
+        for f in tilesets(tmx):
+            add("image", f)
+        add("map", tmx)
+
+    audio_dir = os.path.join(ROOT, "audio")
+    for f in MUSIC:
+        add("music", f)
+    for n in sorted(os.listdir(audio_dir)):
+        rel = "audio/" + n
+        if n.endswith(".mp3") and rel not in MUSIC and not n.startswith("Dirtmouth"):
+            add("sound", rel)
+
+    missing = [l for l in lines if not l.startswith("#") and not os.path.exists(os.path.join(ROOT, l.split(" ", 1)[1].split("|")[0]))]
+    if missing:
+        print("missing files:\n  " + "\n  ".join(missing))
+        return 1
+
+    with open(os.path.join(ROOT, OUT), "w", encoding="utf-8", newline="\n") as f:
+        f.write("\n".join(lines) + "\n")
+    print("wrote %d entries to %s" % (len(lines) - 2, OUT))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,148 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+生成低分辨率档位的资源副本 (AppDelegate 按窗口大小选档位，FileUtils 先在档位目录里找)。
+
+原图是按 2048x1536 设计分辨率画的，算 UHD 档 (缩放 1.0，就是 Resources 根目录本身)；
+这里生成：
+  tier-hd/  缩放 0.5   (中等窗口，content scale factor = 0.5)
+  tier-sd/  缩放 0.25  (小窗口，content scale factor = 0.25)
+
+每个档位目录和 Resources 根目录结构相同：
+  - 所有 png 按比例缩小 (LANCZOS)
+  - HUD 图集用缩小后的小图重新打包 (pack_hud_atlas.build)，帧名不变
+  - TMX 地图里的像素量 (格子大小、图片尺寸、对象坐标) 按比例改写，格子数不变
+  - 写一个 tier_info.txt 标记文件；AppDelegate 找不到它就退回原图档位
+音频、字体、清单这些和分辨率无关的文件不复制，按搜索路径回落到根目录。
+
+内容缩放因子和档位缩放一致，所以代码里的坐标/尺寸 (点) 在各档位下完全相同。
+
+用法：python3 tools/gen_resolution_tiers.py [--force]   (在 HollowKnight 目录下执行，改了美术资源后重跑)
+默认只处理比输出新的源文件；--force 全部重新生成
+依赖：Pillow
+"""
+import os
+import re
+import sys
+
+from PIL import Image
+
+import pack_hud_atlas
+
+ROOT = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "Resources")
+
+# (目录, 缩放)；要和 config.h 里 Config::Resolution 保持一致
+TIERS = [
+    ("tier-hd", 0.5),
+    ("tier-sd", 0.25),
+]
+
+MARKER = "tier_info.txt"
+
+# 不参与缩放的目录 (和分辨率无关，或者是生成的输出)
+SKIP_DIRS = {"audio", "fonts", "res"} | {d for d, _ in TIERS}
+
+# TMX 里各标签中表示像素的属性 (map/layer 的 width/height 是格子数，不能缩)
+TMX_PIXEL_ATTRS = {
+    "map": ("tilewidth", "tileheight"),
+    "tileset": ("tilewidth", "tileheight", "spacing", "margin"),
+    "image": ("width", "height"),
+    "object": ("x", "y", "width", "height"),
+    "layer": ("offsetx", "offsety"),
+    "objectgroup": ("offsetx", "offsety"),
+    "imagelayer": ("offsetx", "offsety"),
+    "tileoffset": ("x", "y"),
+}
+# 这些标签的属性要和缩小后的图片尺寸严格一致，取整方式与图片相同
+TMX_ROUNDED_TAGS = {"map", "tileset", "image"}
+
+
+def scaled_size(w, h, scale):
+    return max(1, round(w * scale)), max(1, round(h * scale))
+
+
+def collect(ext):
+    files = []
+    for dirpath, dirnames, names in os.walk(ROOT):
+        rel_dir = os.path.relpath(dirpath, ROOT).replace(os.sep, "/")
+        if rel_dir == ".":
+            dirnames[:] = [d for d in dirnames if d not in SKIP_DIRS]
+            rel_dir = ""
+        for n in names:
+            if n.lower().endswith(ext):
+                files.append((rel_dir + "/" + n) if rel_dir else n)
+    return sorted(files)
+
+
+def is_stale(src, dst, force):
+    return force or not os.path.exists(dst) or os.path.getmtime(dst) < os.path.getmtime(src)
+
+
+def scale_image(rel, out_root, scale, force):
+    src = os.path.join(ROOT, rel)
+    dst = os.path.join(out_root, rel)
+    if not is_stale(src, dst, force):
+        return False
+    img = Image.open(src)
+    if img.mode not in ("RGB", "RGBA", "L", "LA"):
+        img = img.convert("RGBA")
+    img = img.resize(scaled_size(img.size[0], img.size[1], scale), Image.LANCZOS)
+    os.makedirs(os.path.dirname(dst), exist_ok=True)
+    img.save(dst, optimize=True)
+    return True
+
+
+def scale_tmx_text(text, scale):
+    def fix_tag(m):
+        tag, body = m.group(1), m.group(2)
+        attrs = TMX_PIXEL_ATTRS.get(tag)
+        if not attrs:
+            return m.group(0)
+
+        def fix_attr(a):
+            name, value = a.group(1), a.group(2)
+            if name not in attrs:
+                return a.group(0)
+            v = float(value) * scale
+            if tag in TMX_ROUNDED_TAGS:
+                return '%s="%d"' % (name, max(1, round(v)) if float(value) > 0 else 0)
+            return '%s="%g"' % (name, v)
+
+        return "<" + tag + re.sub(r'\b([a-z]+)="([-0-9.]+)"', fix_attr, body) + ">"
+
+    return re.sub(r"<([a-z]+)(\s[^>]*)>", fix_tag, text)
+
+
+def scale_tmx(rel, out_root, scale, force):
+    src = os.path.join(ROOT, rel)
+    dst = os.path.join(out_root, rel)
+    if not is_stale(src, dst, force):
+        return False
+    with open(src, encoding="utf-8") as f:
+        text = f.read()
+    os.makedirs(os.path.dirname(dst), exist_ok=True)
+    with open(dst, "w", encoding="utf-8", newline="\n") as f:
+        f.write(scale_tmx_text(text, scale))
+    return True
+
+
+def main():
+    force = "--force" in sys.argv[1:]
+    atlas_png = pack_hud_atlas.OUT_PNG
+    images = [f for f in collect(".png") if f != atlas_png]
+    maps = collect(".tmx")
+
+    for dirname, scale in TIERS:
+        out_root = os.path.join(ROOT, dirname)
+        written = sum(scale_image(f, out_root, scale, force) for f in images)
+        written += sum(scale_tmx(f, out_root, scale, force) for f in maps)
+        pack_hud_atlas.build(out_root, scale)
+
+        with open(os.path.join(out_root, MARKER), "w", newline="\n") as f:
+            f.write("scale %g\n" % scale)
+        print("%s (x%g): %d images, %d maps, %d files updated" % (dirname, scale, len(images), len(maps), written))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
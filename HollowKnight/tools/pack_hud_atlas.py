@@ -0,0 +1,144 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+把 Resources/HUDanim 下所有 HUD 小图打成一张图集 (cocos2d-x plist format 2)。
+
+帧名就是原来的相对路径 (例如 "HUDanim/health/full/full.png")，
+所以 config.h 里的 Config::Soul / Config::Health 路径可以直接当帧名用。
+
+用法：python3 tools/pack_hud_atlas.py   (在 HollowKnight 目录下执行)
+依赖：Pillow
+gen_resolution_tiers.py 也调用这里的 build()，给低分辨率档位重新打缩小后的图集
+"""
+import os
+import sys
+
+from PIL import Image
+
+ROOT = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "Resources")
+SRC_DIR = "HUDanim"
+OUT_PNG = "HUDanim/hud_atlas.png"
+OUT_PLIST = "HUDanim/hud_atlas.plist"
+PADDING = 2
+MAX_WIDTH = 1024
+
+
+def collect():
+    files = []
+    for dirpath, _, names in os.walk(os.path.join(ROOT, SRC_DIR)):
+        for n in names:
+            if not n.endswith(".png"):
+                continue
+            full = os.path.join(dirpath, n)
+            rel = os.path.relpath(full, ROOT).replace(os.sep, "/")
+            if rel == OUT_PNG:
+                continue
+            files.append(rel)
+    return sorted(files)
+
+
+def pack(images):
+    # 简单的货架算法：按高度从大到小排，一行放不下就换行
+    order = sorted(images.keys(), key=lambda k: (-images[k].size[1], k))
+    x = y = shelf_h = 0
+    width = 0
+    placed = {}
+    for key in order:
+        w, h = images[key].size
+        if x + w + PADDING > MAX_WIDTH:
+            x = 0
+            y += shelf_h + PADDING
+            shelf_h = 0
+        placed[key] = (x, y)
+        x += w + PADDING
+        width = max(width, x)
+        shelf_h = max(shelf_h, h)
+    height = y + shelf_h
+
+    def pot(v):
+        p = 1
+        while p < v:
+            p <<= 1
+        return p
+
+    return placed, pot(width), pot(height)
+
+
+def write_plist(placed, images, size, out_root=ROOT):
+    lines = [
+        '<?xml version="1.0" encoding="UTF-8"?>',
+        '<!DOCTYPE plist PUBLIC "-//Apple//DTD PLIST 1.0//EN" "http://www.apple.com/DTDs/PropertyList-1.0.dtd">',
+        '<plist version="1.0">',
+        '<dict>',
+        '    <key>frames</key>',
+        '    <dict>',
+    ]
+    for key in sorted(placed.keys()):
+        x, y = placed[key]
+        w, h = images[key].size
+        lines += [
+            '        <key>%s</key>' % key,
+            '        <dict>',
+            '            <key>frame</key>',
+            '            <string>{{%d,%d},{%d,%d}}</string>' % (x, y, w, h),
+            '            <key>offset</key>',
+            '            <string>{0,0}</string>',
+            '            <key>rotated</key>',
+            '            <false/>',
+            '            <key>sourceColorRect</key>',
+            '            <string>{{0,0},{%d,%d}}</string>' % (w, h),
+            '            <key>sourceSize</key>',
+            '            <string>{%d,%d}</string>' % (w, h),
+            '        </dict>',
+        ]
+    lines += [
+        '    </dict>',
+        '    <key>metadata</key>',
+        '    <dict>',
+        '        <key>format</key>',
+        '        <integer>2</integer>',
+        '        <key>size</key>',
+        '        <string>{%d,%d}</string>' % size,
+        '        <key>textureFileName</key>',
+        '        <string>%s</string>' % os.path.basename(OUT_PNG),
+        '    </dict>',
+        '</dict>',
+        '</plist>',
+        '',
+    ]
+    with open(os.path.join(out_root, OUT_PLIST), "w", newline="\n") as f:
+        f.write("\n".join(lines))
+
+
+def build(out_root=ROOT, scale=1.0):
+    """把 HUD 小图按 scale 缩放后打包，写到 out_root 下 (帧名不变)。返回帧数"""
+    files = collect()
+    if not files:
+        print("no HUD images found under", os.path.join(ROOT, SRC_DIR))
+        return 0
+    images = {}
+    for f in files:
+        img = Image.open(os.path.join(ROOT, f)).convert("RGBA")
+        if scale != 1.0:
+            w, h = img.size
+            img = img.resize((max(1, round(w * scale)), max(1, round(h * scale))), Image.LANCZOS)
+        images[f] = img
+    placed, w, h = pack(images)
+
+    atlas = Image.new("RGBA", (w, h), (0, 0, 0, 0))
+    for key, (x, y) in placed.items():
+        atlas.paste(images[key], (x, y))
+    os.makedirs(os.path.dirname(os.path.join(out_root, OUT_PNG)), exist_ok=True)
+    atlas.save(os.path.join(out_root, OUT_PNG), optimize=True)
+    write_plist(placed, images, (w, h), out_root)
+
+    print("packed %d frames into %s (%dx%d)" % (len(files), os.path.relpath(os.path.join(out_root, OUT_PNG), ROOT), w, h))
+    return len(files)
+
+
+def main():
+    return 0 if build() > 0 else 1
+
+
+if __name__ == "__main__":
+    sys.exit(main())